@@ -0,0 +1,399 @@
+/**
+ * AccessTrace.cpp
+ *
+ * Implementations for recording the operations made on an IList into a
+ * compact binary trace file and for replaying such a trace into any IList.
+ * Every record is one varint holding (zigzag(key - previousKey) << 2) | op.
+ *
+ * Joshua Scheck
+ * 2020-10-18
+ */
+
+#include "AccessTrace.h"
+#include <cstdint>
+#include <cstring>
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+namespace {
+
+/** Identifies a trace file */
+const char MAGIC[8] = {'M', 'T', 'F', 'T', 'R', 'A', 'C', 'E'};
+/** Version of the record format written by TraceWriter */
+const unsigned VERSION = 1;
+/** Size of the magic plus the version */
+const std::size_t HEADER_BYTES = sizeof(MAGIC) + 4;
+/** Longest varint of a record: 36 significant bits take 6 bytes */
+const int MAX_RECORD_BYTES = 6;
+
+/**
+ * Maps a signed difference to an unsigned value that is small when the
+ * difference is close to 0
+ */
+unsigned long long zigzag(long long delta) {
+  return (unsigned long long)delta << 1 ^ (unsigned long long)(delta >> 63);
+}
+
+/**
+ * Inverts zigzag()
+ */
+long long unzigzag(unsigned long long value) {
+  return (long long)(value >> 1) ^ -(long long)(value & 1);
+}
+
+} // namespace
+
+/**
+ * Creates a writer that is not attached to any file
+ */
+TraceWriter::TraceWriter() {
+  file = nullptr;
+  previousKey = 0;
+  recordCount = 0;
+  failed = false;
+}
+
+/**
+ * Flushes and closes the file, if any
+ */
+TraceWriter::~TraceWriter() { close(); }
+
+/**
+ * Creates or truncates a trace file and writes its header
+ *
+ * @param   path  name of the trace file
+ *
+ * @post    any file opened before is closed first
+ *
+ * @return  true if the file is ready for records, false otherwise
+ */
+bool TraceWriter::open(const std::string &path) {
+  close();
+  file = std::fopen(path.c_str(), "wb");
+  if (file == nullptr) {
+    return false;
+  }
+
+  unsigned char header[HEADER_BYTES];
+  std::memcpy(header, MAGIC, sizeof(MAGIC));
+  for (int i = 0; i < 4; i++) {
+    header[sizeof(MAGIC) + i] = (unsigned char)(VERSION >> (8 * i));
+  }
+
+  previousKey = 0;
+  recordCount = 0;
+  failed = std::fwrite(header, 1, HEADER_BYTES, file) != HEADER_BYTES;
+  buffer.clear();
+  buffer.reserve(BUFFER_BYTES + MAX_RECORD_BYTES);
+  return !failed;
+}
+
+/**
+ * Appends one operation to the trace
+ *
+ * @param   op   the operation
+ * @param   key  the value the operation was made with, ignored for Clear
+ *
+ * @return  true if the record was buffered, false if the file is not open or
+ *          an earlier write failed
+ */
+bool TraceWriter::record(TraceOp op, int key) {
+  if (file == nullptr || failed) {
+    return false;
+  }
+
+  if (op == TraceOp::Clear) {
+    key = previousKey;
+  }
+  unsigned long long value =
+      zigzag((long long)key - previousKey) << 2 | (unsigned long long)op;
+  previousKey = key;
+
+  while (value >= 0x80) {
+    buffer.push_back((unsigned char)(value | 0x80));
+    value >>= 7;
+  }
+  buffer.push_back((unsigned char)value);
+  recordCount++;
+
+  return buffer.size() < BUFFER_BYTES || flush();
+}
+
+/**
+ * Flushes buffered records and closes the file
+ *
+ * @return  true if every record reached the file, false otherwise
+ */
+bool TraceWriter::close() {
+  if (file == nullptr) {
+    return !failed;
+  }
+
+  flush();
+  if (std::fclose(file) != 0) {
+    failed = true;
+  }
+  file = nullptr;
+  return !failed;
+}
+
+/**
+ * Retrieves the number of operations recorded since the file was opened
+ *
+ * @return  the number of records
+ */
+long long TraceWriter::getRecordCount() const { return recordCount; }
+
+/**
+ * Writes the buffered records to the file
+ *
+ * @return  true if the write succeeded, false otherwise
+ */
+bool TraceWriter::flush() {
+  if (!failed && !buffer.empty() &&
+      std::fwrite(buffer.data(), 1, buffer.size(), file) != buffer.size()) {
+    failed = true;
+  }
+  buffer.clear();
+  return !failed;
+}
+
+/**
+ * Creates a list recording the operations made on another list
+ *
+ * @param   target  the list answering every operation
+ * @param   writer  the trace receiving every operation
+ *
+ * @pre     target and writer must outlive this RecordingList
+ */
+RecordingList::RecordingList(IList &target, TraceWriter &writer)
+    : target(target), writer(writer) {}
+
+int RecordingList::getCurrentSize() const { return target.getCurrentSize(); }
+
+bool RecordingList::isEmpty() const { return target.isEmpty(); }
+
+bool RecordingList::add(int newEntry) {
+  writer.record(TraceOp::Add, newEntry);
+  return target.add(newEntry);
+}
+
+bool RecordingList::remove(int anEntry) {
+  writer.record(TraceOp::Remove, anEntry);
+  return target.remove(anEntry);
+}
+
+void RecordingList::clear() {
+  writer.record(TraceOp::Clear, 0);
+  target.clear();
+}
+
+bool RecordingList::contains(int anEntry) {
+  writer.record(TraceOp::Contains, anEntry);
+  return target.contains(anEntry);
+}
+
+long long RecordingList::getTraverseCount() const {
+  return target.getTraverseCount();
+}
+
+ListStatistics RecordingList::getStatistics() const {
+  return target.getStatistics();
+}
+
+void RecordingList::resetTraverseCount() { target.resetTraverseCount(); }
+
+/**
+ * Creates a reader that is not attached to any file
+ */
+TraceReader::TraceReader() {
+  data = nullptr;
+  size = 0;
+  offset = 0;
+  released = 0;
+  previousKey = 0;
+  corrupt = false;
+}
+
+/**
+ * Unmaps the file, if any
+ */
+TraceReader::~TraceReader() { close(); }
+
+/**
+ * Maps a trace file and checks its header
+ *
+ * @param   path  name of the trace file
+ *
+ * @post    any file opened before is closed first; the next record read is
+ *          the first record of the trace
+ *
+ * @return  true if the file is a trace of a known version, false otherwise
+ */
+bool TraceReader::open(const std::string &path) {
+  close();
+
+  int descriptor = ::open(path.c_str(), O_RDONLY);
+  if (descriptor < 0) {
+    return false;
+  }
+
+  struct stat status;
+  void *mapping = MAP_FAILED;
+  if (fstat(descriptor, &status) == 0 &&
+      std::size_t(status.st_size) >= HEADER_BYTES) {
+    mapping = mmap(nullptr, std::size_t(status.st_size), PROT_READ,
+                   MAP_PRIVATE, descriptor, 0);
+  }
+  // the mapping stays valid once the descriptor is closed
+  ::close(descriptor);
+  if (mapping == MAP_FAILED) {
+    return false;
+  }
+
+  data = static_cast<const unsigned char *>(mapping);
+  size = std::size_t(status.st_size);
+  unsigned version = 0;
+  for (int i = 0; i < 4; i++) {
+    version |= unsigned(data[sizeof(MAGIC) + i]) << (8 * i);
+  }
+  if (std::memcmp(data, MAGIC, sizeof(MAGIC)) != 0 || version != VERSION) {
+    close();
+    return false;
+  }
+
+  madvise(const_cast<unsigned char *>(data), size, MADV_SEQUENTIAL);
+  rewind();
+  return true;
+}
+
+/**
+ * Unmaps the file
+ */
+void TraceReader::close() {
+  if (data != nullptr) {
+    munmap(const_cast<unsigned char *>(data), size);
+  }
+  data = nullptr;
+  size = 0;
+  offset = 0;
+  released = 0;
+  previousKey = 0;
+  corrupt = false;
+}
+
+/**
+ * Restarts reading at the first record of the trace
+ */
+void TraceReader::rewind() {
+  offset = data == nullptr ? 0 : HEADER_BYTES;
+  released = 0;
+  previousKey = 0;
+  corrupt = false;
+}
+
+/**
+ * Reads the next operation of the trace
+ *
+ * @param   op   set to the operation
+ * @param   key  set to the value the operation was made with
+ *
+ * @post    pages of the trace already read are dropped from memory every
+ *          RELEASE_BYTES, so that a trace of any length streams through a
+ *          bounded amount of memory
+ *
+ * @return  true if an operation was read, false at the end of the trace or at
+ *          a truncated record
+ */
+bool TraceReader::next(TraceOp &op, int &key) {
+  if (offset >= size) {
+    return false;
+  }
+
+  unsigned long long value = 0;
+  std::size_t end = offset;
+  for (int shift = 0;; shift += 7) {
+    if (end >= size || shift >= 7 * MAX_RECORD_BYTES) {
+      corrupt = true;
+      return false;
+    }
+    unsigned char byte = data[end++];
+    value |= (unsigned long long)(byte & 0x7f) << shift;
+    if (byte < 0x80) {
+      break;
+    }
+  }
+
+  long long nextKey = previousKey + unzigzag(value >> 2);
+  if (nextKey < INT32_MIN || nextKey > INT32_MAX) {
+    corrupt = true;
+    return false;
+  }
+
+  op = TraceOp(value & 3);
+  key = int(nextKey);
+  previousKey = key;
+  offset = end;
+
+  if (offset - released >= RELEASE_BYTES) {
+    // pages are released whole; data starts on a page boundary
+    std::size_t pageBytes = std::size_t(sysconf(_SC_PAGESIZE));
+    std::size_t upTo = offset / pageBytes * pageBytes;
+    madvise(const_cast<unsigned char *>(data) + released, upTo - released,
+            MADV_DONTNEED);
+    released = upTo;
+  }
+  return true;
+}
+
+/**
+ * Determines whether reading stopped at a truncated or malformed record
+ *
+ * @return  true if the trace is corrupt, false otherwise
+ */
+bool TraceReader::isCorrupt() const { return corrupt; }
+
+/**
+ * Retrieves the size of the mapped trace file
+ *
+ * @return  the size in bytes, 0 if no file is open
+ */
+std::size_t TraceReader::getByteCount() const { return size; }
+
+/**
+ * Replays every remaining operation of a trace into a list
+ *
+ * @param   reader   the open trace
+ * @param   theList  the list receiving the operations
+ *
+ * @return  counts of the operations replayed
+ */
+ReplayResult replayTrace(TraceReader &reader, IList &theList) {
+  ReplayResult result = {0, 0, 0, false};
+  TraceOp op = TraceOp::Contains;
+  int key = 0;
+
+  while (reader.next(op, key)) {
+    result.records++;
+    switch (op) {
+    case TraceOp::Add:
+      theList.add(key);
+      break;
+    case TraceOp::Remove:
+      theList.remove(key);
+      break;
+    case TraceOp::Contains:
+      result.lookups++;
+      result.hits += theList.contains(key) ? 1 : 0;
+      break;
+    case TraceOp::Clear:
+      theList.clear();
+      break;
+    }
+  }
+
+  result.complete = !reader.isCorrupt();
+  return result;
+} // end AccessTrace.cpp
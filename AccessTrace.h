@@ -0,0 +1,247 @@
+/**
+ * AccessTrace.h
+ *
+ * Declarations for recording the operations made on an IList into a compact
+ * binary trace file and for replaying such a trace into any IList. A trace is
+ * the 8-byte magic "MTFTRACE", a 4-byte little-endian version and one varint
+ * per operation holding the operation and the zigzag-encoded difference to
+ * the previous key, so keys that stay close to each other take one or two
+ * bytes. Traces are replayed from a read-only memory mapping, which lets
+ * traces far larger than memory stream through a list.
+ *
+ * Joshua Scheck
+ * 2020-10-18
+ */
+
+#pragma once
+#include "IList.h"
+#include <cstddef>
+#include <cstdio>
+#include <string>
+#include <vector>
+
+/**
+ * An operation recorded in a trace
+ */
+enum class TraceOp : unsigned char { Add, Remove, Contains, Clear };
+
+/**
+ * Appends operations to a trace file through a buffer
+ */
+class TraceWriter {
+public:
+  /**
+   * Creates a writer that is not attached to any file
+   */
+  TraceWriter();
+
+  /**
+   * Flushes and closes the file, if any
+   */
+  ~TraceWriter();
+
+  TraceWriter(const TraceWriter &) = delete;
+  TraceWriter &operator=(const TraceWriter &) = delete;
+
+  /**
+   * Creates or truncates a trace file and writes its header
+   *
+   * @param   path  name of the trace file
+   *
+   * @post    any file opened before is closed first
+   *
+   * @return  true if the file is ready for records, false otherwise
+   */
+  bool open(const std::string &path);
+
+  /**
+   * Appends one operation to the trace
+   *
+   * @param   op   the operation
+   * @param   key  the value the operation was made with, ignored for Clear
+   *
+   * @return  true if the record was buffered, false if the file is not open
+   *          or an earlier write failed
+   */
+  bool record(TraceOp op, int key);
+
+  /**
+   * Flushes buffered records and closes the file
+   *
+   * @return  true if every record reached the file, false otherwise
+   */
+  bool close();
+
+  /**
+   * Retrieves the number of operations recorded since the file was opened
+   *
+   * @return  the number of records
+   */
+  long long getRecordCount() const;
+
+private:
+  /**
+   * Writes the buffered records to the file
+   *
+   * @return  true if the write succeeded, false otherwise
+   */
+  bool flush();
+
+  /** Number of buffered bytes that triggers a write to the file */
+  static const std::size_t BUFFER_BYTES = 1 << 16;
+
+  /** The trace file, otherwise nullptr */
+  std::FILE *file;
+  /** Encoded records not yet written */
+  std::vector<unsigned char> buffer;
+  /** Key of the last record, the base of the next difference */
+  int previousKey;
+  /** Number of operations recorded since the file was opened */
+  long long recordCount;
+  /** True once a write to the file has failed */
+  bool failed;
+};
+
+/**
+ * Forwards every operation to another IList and records it in a trace. The
+ * wrapped list still answers, so the recording list can replace it in place.
+ */
+class RecordingList : public IList {
+public:
+  /**
+   * Creates a list recording the operations made on another list
+   *
+   * @param   target  the list answering every operation
+   * @param   writer  the trace receiving every operation
+   *
+   * @pre     target and writer must outlive this RecordingList
+   */
+  RecordingList(IList &target, TraceWriter &writer);
+
+  int getCurrentSize() const override;
+  bool isEmpty() const override;
+  bool add(int newEntry) override;
+  bool remove(int anEntry) override;
+  void clear() override;
+  bool contains(int anEntry) override;
+  long long getTraverseCount() const override;
+  ListStatistics getStatistics() const override;
+  void resetTraverseCount() override;
+
+private:
+  /** The list answering every operation */
+  IList &target;
+  /** The trace receiving every operation */
+  TraceWriter &writer;
+};
+
+/**
+ * Reads the operations of a trace file through a read-only memory mapping
+ */
+class TraceReader {
+public:
+  /**
+   * Creates a reader that is not attached to any file
+   */
+  TraceReader();
+
+  /**
+   * Unmaps the file, if any
+   */
+  ~TraceReader();
+
+  TraceReader(const TraceReader &) = delete;
+  TraceReader &operator=(const TraceReader &) = delete;
+
+  /**
+   * Maps a trace file and checks its header
+   *
+   * @param   path  name of the trace file
+   *
+   * @post    any file opened before is closed first; the next record read is
+   *          the first record of the trace
+   *
+   * @return  true if the file is a trace of a known version, false otherwise
+   */
+  bool open(const std::string &path);
+
+  /**
+   * Unmaps the file
+   */
+  void close();
+
+  /**
+   * Restarts reading at the first record of the trace
+   */
+  void rewind();
+
+  /**
+   * Reads the next operation of the trace
+   *
+   * @param   op   set to the operation
+   * @param   key  set to the value the operation was made with
+   *
+   * @post    pages of the trace already read are dropped from memory every
+   *          RELEASE_BYTES, so that a trace of any length streams through a
+   *          bounded amount of memory
+   *
+   * @return  true if an operation was read, false at the end of the trace or
+   *          at a truncated record
+   */
+  bool next(TraceOp &op, int &key);
+
+  /**
+   * Determines whether reading stopped at a truncated or malformed record
+   *
+   * @return  true if the trace is corrupt, false otherwise
+   */
+  bool isCorrupt() const;
+
+  /**
+   * Retrieves the size of the mapped trace file
+   *
+   * @return  the size in bytes, 0 if no file is open
+   */
+  std::size_t getByteCount() const;
+
+private:
+  /** Number of bytes read between releases of the pages already read */
+  static const std::size_t RELEASE_BYTES = std::size_t(64) << 20;
+
+  /** First byte of the mapping, otherwise nullptr */
+  const unsigned char *data;
+  /** Size of the mapping in bytes */
+  std::size_t size;
+  /** Offset of the next record */
+  std::size_t offset;
+  /** Offset up to which pages have been released */
+  std::size_t released;
+  /** Key of the last record read, the base of the next difference */
+  int previousKey;
+  /** True if a truncated or malformed record was met */
+  bool corrupt;
+};
+
+/**
+ * Outcome of replaying a trace into a list
+ */
+struct ReplayResult {
+  /** Number of operations replayed */
+  long long records;
+  /** Number of Contains operations that found their value */
+  long long hits;
+  /** Number of Contains operations */
+  long long lookups;
+  /** True if the whole trace was read, false if it is corrupt */
+  bool complete;
+};
+
+/**
+ * Replays every remaining operation of a trace into a list
+ *
+ * @param   reader   the open trace
+ * @param   theList  the list receiving the operations
+ *
+ * @return  counts of the operations replayed
+ */
+ReplayResult replayTrace(TraceReader &reader, IList &theList);
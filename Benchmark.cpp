@@ -0,0 +1,280 @@
+/**
+ * Benchmark.cpp
+ *
+ * Implementations for running one benchmark of an IList implementation and
+ * reporting the results of many runs as text, CSV or JSON. A run fills a fresh
+ * list with the values 0..numValues-1, seeks a precomputed sequence of values
+ * and measures both the average number of nodes traversed and the wall-clock
+ * time per access. Timed runs wrap the list in a TimedList, so every list is
+ * timed the same way without knowing it is.
+ *
+ * Joshua Scheck
+ * 2020-10-18
+ */
+
+#include "Benchmark.h"
+#include "TimedList.h"
+#include <chrono>
+#include <cstdio>
+#include <memory>
+
+namespace {
+
+/**
+ * Determines if any result is timed
+ */
+bool anyTimed(const std::vector<BenchmarkResult> &results) {
+  for (const BenchmarkResult &result : results) {
+    if (result.timed) {
+      return true;
+    }
+  }
+  return false;
+}
+
+/**
+ * Copies the latencies recorded by a timed list into a result
+ */
+void keepLatency(const TimedList &timer, BenchmarkResult &result) {
+  result.timed = true;
+  result.lookupLatency = timer.getContainsLatency();
+  result.updateLatency = timer.getAddLatency();
+  result.updateLatency.merge(timer.getRemoveLatency());
+}
+
+/**
+ * Writes the CSV fields of the p50, p99, p99.9 and max of a histogram
+ */
+void writePercentiles(std::ostream &out, const LatencyHistogram &latency) {
+  out << "," << latency.percentile(0.50) << "," << latency.percentile(0.99)
+      << "," << latency.percentile(0.999) << "," << latency.getMax();
+}
+
+/**
+ * Writes the JSON members of the p50, p99, p99.9 and max of a histogram,
+ * each name starting with a prefix
+ */
+void writePercentiles(std::ostream &out, const std::string &prefix,
+                      const LatencyHistogram &latency) {
+  out << ", \"" << prefix << "_p50_ns\": " << latency.percentile(0.50)
+      << ", \"" << prefix << "_p99_ns\": " << latency.percentile(0.99)
+      << ", \"" << prefix << "_p999_ns\": " << latency.percentile(0.999)
+      << ", \"" << prefix << "_max_ns\": " << latency.getMax();
+}
+
+/**
+ * Writes a string as a quoted JSON string, escaping quotes, backslashes and
+ * control characters, since a replayed trace names the distribution by its
+ * path
+ */
+void writeJsonString(std::ostream &out, const std::string &text) {
+  out << '"';
+  for (char c : text) {
+    if (c == '"' || c == '\\') {
+      out << '\\' << c;
+    } else if (static_cast<unsigned char>(c) < 0x20) {
+      char escaped[7];
+      std::snprintf(escaped, sizeof(escaped), "\\u%04x", c);
+      out << escaped;
+    } else {
+      out << c;
+    }
+  }
+  out << '"';
+}
+
+} // namespace
+
+/**
+ * Fills a fresh list with the values 0..numValues-1 (0 at the front) and seeks
+ * every value of a sequence in it
+ *
+ * @param   entry         the IList implementation
+ * @param   numValues     number of values added to the list
+ * @param   distribution  specification the accesses were generated from
+ * @param   seed          seed the accesses were generated from
+ * @param   accesses      the values to seek, in order
+ * @param   timeLatency   true to record the latency of every add and every
+ *                        value sought, which adds the cost of reading the
+ *                        clock to nsPerOp
+ *
+ * @return  the measured result
+ */
+BenchmarkResult runBenchmark(const ListEntry &entry, int numValues,
+                             const std::string &distribution,
+                             std::uint64_t seed,
+                             const std::vector<int> &accesses,
+                             bool timeLatency) {
+  std::unique_ptr<IList> created = entry.create();
+  std::unique_ptr<TimedList> timer;
+  IList *theList = created.get();
+  if (timeLatency) {
+    timer.reset(new TimedList(*created));
+    theList = timer.get();
+  }
+
+  for (int i = numValues - 1; i >= 0; i--) {
+    theList->add(i);
+  }
+  theList->resetTraverseCount();
+
+  long long hits = 0;
+  auto start = std::chrono::steady_clock::now();
+  for (int value : accesses) {
+    hits += theList->contains(value) ? 1 : 0;
+  }
+  auto elapsed = std::chrono::steady_clock::now() - start;
+
+  BenchmarkResult result;
+  result.list = entry.name;
+  result.numValues = numValues;
+  result.distribution = distribution;
+  result.seed = seed;
+  result.numAccesses = (long long)accesses.size();
+  result.hits = hits;
+  double count = accesses.empty() ? 1.0 : double(accesses.size());
+  result.averageTraversals = theList->getTraverseCount() / count;
+  result.promotions = theList->getStatistics().promotions;
+  result.nsPerOp =
+      std::chrono::duration<double, std::nano>(elapsed).count() / count;
+  result.timed = false;
+  if (timer != nullptr) {
+    keepLatency(*timer, result);
+  }
+  return result;
+}
+
+/**
+ * Replays a recorded trace into a fresh, empty list. The trace adds the
+ * values itself, and its lookups count as the accesses: traversals and the
+ * time of the whole replay are averaged over them.
+ *
+ * @param   entry        the IList implementation
+ * @param   name         name of the trace, reported as the distribution
+ * @param   reader       the open trace, rewound before the replay
+ * @param   timeLatency  true to record the latency of every operation of the
+ *                       trace, which adds the cost of reading the clock to
+ *                       nsPerOp
+ *
+ * @return  the measured result, with the size of the list at the end of the
+ *          trace as its size, or hits of -1 if the trace is corrupt
+ */
+BenchmarkResult runTraceBenchmark(const ListEntry &entry,
+                                  const std::string &name,
+                                  TraceReader &reader, bool timeLatency) {
+  std::unique_ptr<IList> created = entry.create();
+  std::unique_ptr<TimedList> timer;
+  IList *theList = created.get();
+  if (timeLatency) {
+    timer.reset(new TimedList(*created));
+    theList = timer.get();
+  }
+  reader.rewind();
+
+  auto start = std::chrono::steady_clock::now();
+  ReplayResult replay = replayTrace(reader, *theList);
+  auto elapsed = std::chrono::steady_clock::now() - start;
+
+  BenchmarkResult result;
+  result.list = entry.name;
+  result.numValues = theList->getCurrentSize();
+  result.distribution = name;
+  result.seed = 0;
+  result.numAccesses = replay.lookups;
+  result.hits = replay.complete ? replay.hits : -1;
+  // only lookups traverse, so averages are per lookup as for generated
+  // workloads
+  double count = replay.lookups == 0 ? 1.0 : double(replay.lookups);
+  result.averageTraversals = theList->getTraverseCount() / count;
+  result.promotions = theList->getStatistics().promotions;
+  result.nsPerOp =
+      std::chrono::duration<double, std::nano>(elapsed).count() / count;
+  result.timed = false;
+  if (timer != nullptr) {
+    keepLatency(*timer, result);
+  }
+  return result;
+}
+
+/**
+ * Writes results as "<list> - Average number of nodes traversed per access
+ * (<distribution>)" lines, followed by the p50/p99/p99.9/max latency of the
+ * values sought for timed results
+ *
+ * @param   out      stream written to
+ * @param   results  the results
+ */
+void writeText(std::ostream &out, const std::vector<BenchmarkResult> &results) {
+  for (const BenchmarkResult &result : results) {
+    out << result.list << " - Average number of nodes traversed per access ("
+        << result.distribution << ", " << result.numValues
+        << " values): " << result.averageTraversals << " (" << result.nsPerOp
+        << " ns/op)";
+    if (result.timed) {
+      const LatencyHistogram &latency = result.lookupLatency;
+      out << " [p50/p99/p99.9/max: " << latency.percentile(0.50) << "/"
+          << latency.percentile(0.99) << "/" << latency.percentile(0.999)
+          << "/" << latency.getMax() << " ns]";
+    }
+    out << std::endl;
+  }
+}
+
+/**
+ * Writes results as CSV with a header row. The percentiles of the latencies
+ * are added as columns if any result is timed.
+ *
+ * @param   out      stream written to
+ * @param   results  the results
+ */
+void writeCsv(std::ostream &out, const std::vector<BenchmarkResult> &results) {
+  bool timed = anyTimed(results);
+  out << "list,size,distribution,seed,accesses,hits,avg_traversals,"
+      << "promotions,ns_per_op";
+  if (timed) {
+    out << ",lookup_p50_ns,lookup_p99_ns,lookup_p999_ns,lookup_max_ns,"
+        << "update_p50_ns,update_p99_ns,update_p999_ns,update_max_ns";
+  }
+  out << std::endl;
+  for (const BenchmarkResult &result : results) {
+    out << result.list << "," << result.numValues << "," << result.distribution
+        << "," << result.seed << "," << result.numAccesses << ","
+        << result.hits << "," << result.averageTraversals << ","
+        << result.promotions << "," << result.nsPerOp;
+    if (timed) {
+      writePercentiles(out, result.lookupLatency);
+      writePercentiles(out, result.updateLatency);
+    }
+    out << std::endl;
+  }
+}
+
+/**
+ * Writes results as a JSON array of objects, with the percentiles of the
+ * latencies of timed results
+ *
+ * @param   out      stream written to
+ * @param   results  the results
+ */
+void writeJson(std::ostream &out, const std::vector<BenchmarkResult> &results) {
+  out << "[" << std::endl;
+  for (std::size_t i = 0; i < results.size(); i++) {
+    const BenchmarkResult &result = results[i];
+    out << "  {\"list\": ";
+    writeJsonString(out, result.list);
+    out << ", \"size\": " << result.numValues << ", \"distribution\": ";
+    writeJsonString(out, result.distribution);
+    out << ", \"seed\": " << result.seed
+        << ", \"accesses\": " << result.numAccesses
+        << ", \"hits\": " << result.hits
+        << ", \"avg_traversals\": " << result.averageTraversals
+        << ", \"promotions\": " << result.promotions
+        << ", \"ns_per_op\": " << result.nsPerOp;
+    if (result.timed) {
+      writePercentiles(out, "lookup", result.lookupLatency);
+      writePercentiles(out, "update", result.updateLatency);
+    }
+    out << "}" << (i + 1 < results.size() ? "," : "") << std::endl;
+  }
+  out << "]" << std::endl;
+} // end Benchmark.cpp
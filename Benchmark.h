@@ -0,0 +1,121 @@
+/**
+ * Benchmark.h
+ *
+ * Declarations for running one benchmark of an IList implementation and
+ * reporting the results of many runs as text, CSV or JSON. A run fills a fresh
+ * list with the values 0..numValues-1, seeks a precomputed sequence of values
+ * and measures both the average number of nodes traversed and the wall-clock
+ * time per access. Timed runs also record the latency of every operation, so
+ * percentiles of the latency can be reported next to the means.
+ *
+ * Joshua Scheck
+ * 2020-10-18
+ */
+
+#pragma once
+#include "AccessTrace.h"
+#include "LatencyHistogram.h"
+#include "ListCatalog.h"
+#include <cstdint>
+#include <ostream>
+#include <string>
+#include <vector>
+
+/**
+ * Outcome of seeking one sequence of values in one list
+ */
+struct BenchmarkResult {
+  /** Name of the IList implementation */
+  std::string list;
+  /** Number of values held by the list */
+  int numValues;
+  /** Specification of the access distribution */
+  std::string distribution;
+  /** Seed of the random stream the accesses were drawn from */
+  std::uint64_t seed;
+  /** Number of values sought */
+  long long numAccesses;
+  /** Number of values sought that were found */
+  long long hits;
+  /** Nodes traversed per access, as reported by the list */
+  double averageTraversals;
+  /** Reorganizations of the list, as reported by the list */
+  long long promotions;
+  /** Wall-clock nanoseconds per access */
+  double nsPerOp;
+  /** True if the latency of every operation was recorded */
+  bool timed;
+  /** Latencies of the values sought, empty unless timed */
+  LatencyHistogram lookupLatency;
+  /** Latencies of the values added and removed, empty unless timed */
+  LatencyHistogram updateLatency;
+};
+
+/**
+ * Fills a fresh list with the values 0..numValues-1 (0 at the front) and
+ * seeks every value of a sequence in it
+ *
+ * @param   entry         the IList implementation
+ * @param   numValues     number of values added to the list
+ * @param   distribution  specification the accesses were generated from
+ * @param   seed          seed the accesses were generated from
+ * @param   accesses      the values to seek, in order
+ * @param   timeLatency   true to record the latency of every add and every
+ *                        value sought, which adds the cost of reading the
+ *                        clock to nsPerOp
+ *
+ * @return  the measured result
+ */
+BenchmarkResult runBenchmark(const ListEntry &entry, int numValues,
+                             const std::string &distribution,
+                             std::uint64_t seed,
+                             const std::vector<int> &accesses,
+                             bool timeLatency = false);
+
+/**
+ * Replays a recorded trace into a fresh, empty list. The trace adds the
+ * values itself, and its lookups count as the accesses: traversals and the
+ * time of the whole replay are averaged over them.
+ *
+ * @param   entry        the IList implementation
+ * @param   name         name of the trace, reported as the distribution
+ * @param   reader       the open trace, rewound before the replay
+ * @param   timeLatency  true to record the latency of every operation of the
+ *                       trace, which adds the cost of reading the clock to
+ *                       nsPerOp
+ *
+ * @return  the measured result, with the size of the list at the end of the
+ *          trace as its size, or hits of -1 if the trace is corrupt
+ */
+BenchmarkResult runTraceBenchmark(const ListEntry &entry,
+                                  const std::string &name,
+                                  TraceReader &reader,
+                                  bool timeLatency = false);
+
+/**
+ * Writes results as "<list> - Average number of nodes traversed per access
+ * (<distribution>)" lines, followed by the p50/p99/p99.9/max latency of the
+ * values sought for timed results
+ *
+ * @param   out      stream written to
+ * @param   results  the results
+ */
+void writeText(std::ostream &out, const std::vector<BenchmarkResult> &results);
+
+/**
+ * Writes results as CSV with a header row. The percentiles of the latencies
+ * are added as columns if any result is timed.
+ *
+ * @param   out      stream written to
+ * @param   results  the results
+ */
+void writeCsv(std::ostream &out, const std::vector<BenchmarkResult> &results);
+
+/**
+ * Writes results as a JSON array of objects, with the percentiles of the
+ * latencies of timed results
+ *
+ * @param   out      stream written to
+ * @param   results  the results
+ */
+void writeJson(std::ostream &out, const std::vector<BenchmarkResult> &results);
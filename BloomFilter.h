@@ -0,0 +1,206 @@
+/**
+ * BloomFilter.h
+ *
+ * Declaration and implementation of the BloomFilter class, a blocked Bloom
+ * filter answering "definitely absent" or "possibly present" for 64-bit key
+ * hashes. Every key sets and tests bits of a single 64-byte block, so a query
+ * touches one cache line. Bits can not be cleared one key at a time; the
+ * owner of a filter rebuilds it from its keys once too many of the keys added
+ * have been removed or the filter is fuller than it was sized for.
+ *
+ * Joshua Scheck
+ * 2020-10-18
+ */
+
+#pragma once
+#include <cstddef>
+#include <cstdint>
+#include <new>
+#include <vector>
+
+/**
+ * Represents a blocked Bloom filter over 64-bit key hashes
+ */
+class BloomFilter {
+public:
+  /** Bits per key when no other density is requested, for a false positive
+   * rate of about 1% */
+  static const int DEFAULT_BITS_PER_KEY = 10;
+
+  /**
+   * Constructor for this BloomFilter class. No memory is allocated until the
+   * filter is sized.
+   *
+   * @param   bitsPerKey  bits reserved for every key of the capacity
+   *
+   * @pre     bitsPerKey must be greater than 0
+   *
+   * @post    the filter has a capacity of 0 and reports every key absent
+   */
+  explicit BloomFilter(int bitsPerKey = DEFAULT_BITS_PER_KEY)
+      : bitsPerKey(bitsPerKey), probes(probesFor(bitsPerKey)), capacity(0),
+        insertions(0) {}
+
+  /**
+   * Mixes the bits of a key so that similar keys give unrelated hashes
+   *
+   * @param   key  any 64-bit value, such as the result of std::hash
+   *
+   * @return  the hash to add or query
+   */
+  static std::uint64_t mix(std::uint64_t key) {
+    // the finalizer of splitmix64
+    key ^= key >> 30;
+    key *= 0xbf58476d1ce4e5b9ULL;
+    key ^= key >> 27;
+    key *= 0x94d049bb133111ebULL;
+    return key ^ (key >> 31);
+  }
+
+  /**
+   * Empties the filter and sizes it for a number of keys
+   *
+   * @param   keys  number of keys the filter is sized for
+   *
+   * @post    if successful, the filter reports every key absent. No change
+   *          in state if unsuccessful.
+   *
+   * @return  true if successful, false if memory could not be allocated
+   */
+  bool reset(long long keys) {
+    long long bits = (keys < 1 ? 1 : keys) * bitsPerKey;
+    std::size_t blockCount = std::size_t((bits + BLOCK_BITS - 1) / BLOCK_BITS);
+    try {
+      std::vector<Block>(blockCount).swap(blocks);
+    }
+    // inability to allocate memory will throw a std::bad_alloc error
+    // which will be caught and signals a lack of success
+    catch (std::bad_alloc &exc) {
+      return false;
+    }
+    capacity = keys;
+    insertions = 0;
+    return true;
+  }
+
+  /**
+   * Forgets every key, keeping the size of the filter
+   *
+   * @post    the filter reports every key absent
+   */
+  void clear() {
+    for (Block &block : blocks) {
+      block = Block();
+    }
+    insertions = 0;
+  }
+
+  /**
+   * Adds the hash of a key
+   *
+   * @param   hash  hash of the key, as returned by mix
+   *
+   * @pre     the filter must have been sized by reset
+   *
+   * @post    mayContain(hash) is true until the filter is reset or cleared
+   */
+  void add(std::uint64_t hash) {
+    Block &block = blockOf(hash);
+    std::uint64_t step = stepOf(hash);
+    for (int i = 0; i < probes; i++, hash += step) {
+      block.words[(hash >> 6) & 7] |= std::uint64_t(1) << (hash & 63);
+    }
+    insertions++;
+  }
+
+  /**
+   * Determines whether a key may have been added
+   *
+   * @param   hash  hash of the key, as returned by mix
+   *
+   * @return  false if the key was definitely not added since the last reset
+   *          or clear, true if it possibly was
+   */
+  bool mayContain(std::uint64_t hash) const {
+    if (blocks.empty()) {
+      return false;
+    }
+    const Block &block = blocks[blockIndexOf(hash)];
+    std::uint64_t step = stepOf(hash);
+    for (int i = 0; i < probes; i++, hash += step) {
+      if ((block.words[(hash >> 6) & 7] & (std::uint64_t(1) << (hash & 63))) ==
+          0) {
+        return false;
+      }
+    }
+    return true;
+  }
+
+  /**
+   * Retrieves the number of keys the filter was sized for
+   *
+   * @return  the capacity given to the last reset
+   */
+  long long getCapacity() const { return capacity; }
+
+  /**
+   * Retrieves the number of keys added since the last reset or clear,
+   * including keys added more than once
+   *
+   * @return  the number of additions
+   */
+  long long getInsertions() const { return insertions; }
+
+  /**
+   * Retrieves the memory held by the bits of the filter
+   *
+   * @return  the size of the bits in bytes
+   */
+  std::size_t getByteCount() const { return blocks.size() * sizeof(Block); }
+
+private:
+  /** Bits in a block */
+  static const int BLOCK_BITS = 512;
+
+  /** One cache line of bits */
+  struct alignas(64) Block {
+    std::uint64_t words[8] = {};
+  };
+
+  /**
+   * Chooses the number of bits set per key, ln 2 times the bits per key
+   */
+  static int probesFor(int bitsPerKey) {
+    int count = (bitsPerKey * 69 + 50) / 100;
+    return count < 1 ? 1 : (count > 16 ? 16 : count);
+  }
+
+  /**
+   * Maps a hash to a block by its upper bits, without a division
+   */
+  std::size_t blockIndexOf(std::uint64_t hash) const {
+    return std::size_t(((hash >> 32) * blocks.size()) >> 32);
+  }
+
+  /** @return  the block of a hash */
+  Block &blockOf(std::uint64_t hash) { return blocks[blockIndexOf(hash)]; }
+
+  /**
+   * Derives the distance between the bits of a key within its block; odd,
+   * so that the probes do not repeat
+   */
+  static std::uint64_t stepOf(std::uint64_t hash) {
+    return (hash >> 23) | 1;
+  }
+
+  /** Bits reserved for every key of the capacity. */
+  int bitsPerKey;
+  /** Bits set and tested per key. */
+  int probes;
+  /** Number of keys the filter was sized for. */
+  long long capacity;
+  /** Keys added since the last reset or clear. */
+  long long insertions;
+  /** The bits. */
+  std::vector<Block> blocks;
+}; // end BloomFilter.h
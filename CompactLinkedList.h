@@ -0,0 +1,179 @@
+/**
+ * CompactLinkedList.h
+ *
+ * Declarations for the CompactLinkedList class and its "move-to-front"
+ * variant, CompactMTFList. They behave exactly like LinkedList and MTFList,
+ * producing the same orderings and traverse counts, but keep their nodes in
+ * one vector linked by 32-bit index, which takes 8 bytes per value instead of
+ * a 16-byte Node plus the bookkeeping of the freestore. An empty list costs
+ * its vtable pointer, the vector and three 32-bit fields, 44 bytes, plus its
+ * one ListCounter (320 bytes after 4 bytes of padding, or 4 bytes in all
+ * under NO_LIST_INSTRUMENTATION).
+ *
+ * Joshua Scheck
+ * 2020-10-18
+ */
+
+#pragma once
+#include "CompactSelfOrganizingList.h"
+#include "IList.h"
+#include <cstddef>
+
+/**
+ * Represents a singly linked list of integers stored in one vector that is the
+ * subclass of IList
+ */
+class CompactLinkedList : public IList {
+public:
+  /**
+   * Constructor for this CompactLinkedList class. Initializes an empty
+   * CompactLinkedList that owns no storage yet.
+   */
+  CompactLinkedList();
+
+  /**
+   * Retrieves the current number of values in this CompactLinkedList
+   *
+   * @post    state of this CompactLinkedList does not change
+   *
+   * @return  the number of values in this CompactLinkedList
+   */
+  int getCurrentSize() const override;
+
+  /**
+   * Determines if the number of values in this CompactLinkedList is zero
+   *
+   * @post    state of this CompactLinkedList does not change
+   *
+   * @return  true if this CompactLinkedList holds no values, false otherwise
+   */
+  bool isEmpty() const override;
+
+  /**
+   * Adds the specified value to the beginning of this CompactLinkedList,
+   * reusing the storage of a removed value if there is one. Duplicate integer
+   * values are allowed.
+   *
+   * @param   newEntry integer value to be added to the beginning of this
+   *                   CompactLinkedList
+   *
+   * @post             if successful, the size of this CompactLinkedList
+   * increases by 1 and newEntry is the first value. No change in class state
+   * if unsuccessful.
+   *
+   * @return           true if the value is successfully added, false if
+   *                   memory could not be allocated
+   */
+  bool add(int newEntry) override;
+
+  /**
+   * Removes the first occurrence of the specified integer from this
+   * CompactLinkedList
+   *
+   * @param   anEntry  the sought integer value to be removed
+   *
+   * @post             if successful, the size of this CompactLinkedList
+   * decreases by 1 and its storage is kept for the next value added. No change
+   * in class state if unsuccessful.
+   *
+   * @return           true if the value is found and removed, false otherwise
+   */
+  bool remove(int anEntry) override;
+
+  /**
+   * Removes all entries from this CompactLinkedList and frees its storage
+   *
+   * @post    this CompactLinkedList is empty and its size is 0
+   */
+  void clear() override;
+
+  /**
+   * Determines if the specified integer value is held in this
+   * CompactLinkedList
+   *
+   * @param   anEntry  the sought integer value
+   *
+   * @post             the traversal count is incremented by 1 with each node
+   * traversed in the search for the first occurrence of the specified integer
+   * value (even if not found)
+   *
+   * @return           true if the specified integer value is contained in
+   *                   this CompactLinkedList, false otherwise
+   */
+  bool contains(int anEntry) override;
+
+  /**
+   * Makes room for a number of values so that adding that many allocates
+   * nothing
+   *
+   * @param   count  number of values the storage must hold
+   *
+   * @return  true if successful, false if memory could not be allocated
+   */
+  bool reserve(int count);
+
+  /**
+   * Retrieves the number of bytes of node storage held by this
+   * CompactLinkedList, including room for removed values and for growth
+   *
+   * @post    state of this CompactLinkedList does not change
+   *
+   * @return  the size of the storage in bytes
+   */
+  std::size_t getStorageBytes() const;
+
+  /**
+   * Retrieves the number of nodes traversed since the last time the count
+   * was reset in this CompactLinkedList
+   *
+   * @post    state of this CompactLinkedList does not change
+   *
+   * @return  the number of nodes traversed
+   */
+  long long getTraverseCount() const override;
+
+  /**
+   * Retrieves everything recorded about this CompactLinkedList since the last
+   * reset
+   *
+   * @post    state of this CompactLinkedList does not change
+   *
+   * @return  traversals, hits, misses, the histogram of hit positions,
+   *          promotions and splices, all 0 if instrumentation is compiled out
+   */
+  ListStatistics getStatistics() const override;
+
+  /**
+   * Resets the count of nodes traversed in this CompactLinkedList
+   *
+   * @post sets the traversal count and all other statistics to 0
+   */
+  void resetTraverseCount() override;
+
+protected:
+  /** The nodes of this CompactLinkedList and their instrumentation. */
+  CompactSelfOrganizingList<NoPromotion, ListCounter> nodes;
+};
+
+/**
+ * Represents a "move-to-front" list of integers stored in one vector that is
+ * the subclass of CompactLinkedList
+ */
+class CompactMTFList : public CompactLinkedList {
+public:
+  /**
+   * Overrides CompactLinkedList::contains(int anEntry). Similarly determines
+   * if the specified integer value is held in this CompactMTFList, but then
+   * moves it to the front by rewriting two indices
+   *
+   * @param   anEntry  the sought integer value
+   *
+   * @post             the traversal count is incremented by 1 with each node
+   * traversed in the search (even if not found). If found, the value is the
+   * first value of this CompactMTFList.
+   *
+   * @return           true if the specified integer value is contained in
+   *                   this CompactMTFList, false otherwise
+   */
+  bool contains(int anEntry) override;
+}; // end CompactLinkedList.h
@@ -0,0 +1,371 @@
+/**
+ * CompactSelfOrganizingList.h
+ *
+ * Declaration and implementation of the CompactSelfOrganizingList class
+ * template, a singly linked list of integers whose nodes live side by side in
+ * one vector and link to each other by 32-bit index. A node is 8 bytes, half
+ * of a Node after padding, and there is no heap object per node, so many more
+ * lists fit in cache and memory. Removed nodes are kept on a free chain of
+ * indices for reuse. Promotions rewrite indices through the same splicing
+ * helpers as SelfOrganizingList, so the policies that restructure a list only
+ * through those helpers (NoPromotion, MoveToFront, Transpose) work unchanged.
+ *
+ * Joshua Scheck
+ * 2020-10-18
+ */
+
+#pragma once
+#include <cstddef>
+#include <cstdint>
+#include <new>
+#include <vector>
+
+#include "PromotionPolicies.h"
+#include "TraverseCounters.h"
+
+/**
+ * A node of a CompactSelfOrganizingList
+ */
+struct CompactNode {
+  /** Value held by this node */
+  int item;
+  /** Index of the next node in the list, or of the next free node while this
+   * node is free; CompactNode::NONE if there is none */
+  std::uint32_t next;
+
+  /** Index standing for no node */
+  static constexpr std::uint32_t NONE = UINT32_MAX;
+};
+
+static_assert(sizeof(CompactNode) == 8, "a CompactNode must stay 8 bytes");
+
+/**
+ * Represents a singly linked list of integers stored in one vector that may
+ * reorganize itself each time a search finds a value
+ *
+ * @tparam  Policy   promotion strategy applied by contains; it must change
+ *                   the list only through unlinkAfter, pushFront and
+ *                   insertAfter
+ * @tparam  Counter  instrumentation, such as TraverseCounter or
+ *                   NullTraverseCounter; ListCounter follows the
+ *                   NO_LIST_INSTRUMENTATION build flag
+ */
+template <typename Policy = NoPromotion, typename Counter = ListCounter>
+class CompactSelfOrganizingList {
+public:
+  /** Type of the nodes composing this CompactSelfOrganizingList */
+  typedef CompactNode NodeType;
+
+  /**
+   * Constructor for this CompactSelfOrganizingList class. Initializes an
+   * empty list that owns no storage yet.
+   */
+  CompactSelfOrganizingList()
+      : currentSize(0), head(CompactNode::NONE), freeHead(CompactNode::NONE) {}
+
+  /**
+   * Retrieves the current number of nodes in this list
+   *
+   * @return  the number of nodes in this list
+   */
+  int getCurrentSize() const { return currentSize; }
+
+  /**
+   * Determines if the number of nodes in this list is zero
+   *
+   * @return  true if this list has no nodes, false otherwise
+   */
+  bool isEmpty() const { return head == CompactNode::NONE; }
+
+  /**
+   * Retrieves the number of bytes of node storage held by this list,
+   * including free nodes and room reserved for growth
+   *
+   * @return  the size of the storage in bytes
+   */
+  std::size_t getStorageBytes() const {
+    return slots.capacity() * sizeof(NodeType);
+  }
+
+  /**
+   * Makes room for a number of nodes so that adding that many allocates
+   * nothing
+   *
+   * @param   count  number of nodes the storage must hold
+   *
+   * @return  true if successful, false if memory could not be allocated or
+   *          count exceeds the nodes an index can reach
+   */
+  bool reserve(int count) {
+    if (count < 0 || std::uint32_t(count) >= CompactNode::NONE) {
+      return false;
+    }
+    try {
+      slots.reserve(std::size_t(count));
+    }
+    // inability to allocate memory will throw a std::bad_alloc error
+    // which will be caught and signals a lack of success
+    catch (std::bad_alloc &exc) {
+      return false;
+    }
+    return true;
+  }
+
+  /**
+   * Adds a new node with the specified value to the beginning of this list.
+   * Duplicate values are allowed.
+   *
+   * @param   newEntry  value to be added to the beginning of this list
+   *
+   * @post    if successful, the size of this list increases by 1 and the new
+   *          node is the front of this list. No change in state if
+   *          unsuccessful.
+   *
+   * @return  true if a new node is successfully added, false if memory could
+   *          not be allocated
+   */
+  bool add(int newEntry) {
+    std::uint32_t index = freeHead;
+    if (index != CompactNode::NONE) {
+      freeHead = slots[index].next;
+    } else {
+      if (slots.size() >= CompactNode::NONE) {
+        return false;
+      }
+      try {
+        slots.push_back(NodeType());
+      }
+      // inability to allocate memory will throw a std::bad_alloc error
+      // which will be caught and signals a lack of success
+      catch (std::bad_alloc &exc) {
+        return false;
+      }
+      index = std::uint32_t(slots.size() - 1);
+    }
+
+    slots[index].item = newEntry;
+    slots[index].next = head;
+    head = index;
+    currentSize++;
+    return true;
+  }
+
+  /**
+   * Removes the first occurrence of a node holding the specified value
+   *
+   * @param   anEntry  the sought value held by a node to be removed
+   *
+   * @post    if successful, the size of this list decreases by 1 and the node
+   *          is kept for reuse. No change in state if unsuccessful.
+   *
+   * @return  true if a node is found with the specified value and removed,
+   *          false otherwise
+   */
+  bool remove(int anEntry) {
+    std::uint32_t prevIndex = CompactNode::NONE;
+
+    for (std::uint32_t currIndex = head; currIndex != CompactNode::NONE;
+         prevIndex = currIndex, currIndex = slots[currIndex].next) {
+      if (slots[currIndex].item == anEntry) {
+        if (prevIndex == CompactNode::NONE) {
+          head = slots[currIndex].next;
+        } else {
+          slots[prevIndex].next = slots[currIndex].next;
+        }
+        slots[currIndex].next = freeHead;
+        freeHead = currIndex;
+        currentSize--;
+        return true;
+      }
+    }
+
+    return false;
+  }
+
+  /**
+   * Removes all nodes from this list and frees the storage in one step
+   *
+   * @post    this list is empty and its size is 0
+   */
+  void clear() {
+    std::vector<NodeType>().swap(slots);
+    head = CompactNode::NONE;
+    freeHead = CompactNode::NONE;
+    currentSize = 0;
+  }
+
+  /**
+   * Determines if the specified value is held by a node in this list and
+   * applies the promotion strategy to the node found
+   *
+   * @tparam  P        promotion strategy to apply, Policy unless overridden
+   * @param   anEntry  the sought value
+   *
+   * @post    the counter is told about every node traversed in the search for
+   *          the first occurrence of the value (even if not found). If found,
+   *          a default constructed P has been applied to its node.
+   *
+   * @return  true if the specified value is contained in this list, false
+   *          otherwise
+   */
+  template <typename P = Policy> bool contains(int anEntry) {
+    return contains(anEntry, P());
+  }
+
+  /**
+   * Determines if the specified value is held by a node in this list and
+   * applies the given promotion strategy to the node found
+   *
+   * @param   anEntry    the sought value
+   * @param   promotion  strategy whose onHit member is applied to the node
+   *                     found; the node pointers it receives stay valid only
+   *                     during the call
+   *
+   * @post    the counter is told about every node traversed in the search for
+   *          the first occurrence of the value (even if not found) and about
+   *          the hit or miss. If found, promotion.onHit has been applied to
+   *          its node, which counts as a promotion if it rewrote any link.
+   *
+   * @return  true if the specified value is contained in this list, false
+   *          otherwise
+   */
+  template <typename P> bool contains(int anEntry, const P &promotion) {
+    NodeType *nodes = slots.data();
+    NodeType *prevPrevNode = nullptr;
+    NodeType *prevNode = nullptr;
+    int position = 0;
+
+    for (std::uint32_t currIndex = head; currIndex != CompactNode::NONE;
+         currIndex = nodes[currIndex].next, position++) {
+      NodeType *currNode = nodes + currIndex;
+      if (currNode->item == anEntry) {
+        // every node looked into is recorded at once, so that the loop does
+        // not store to the counter on every iteration
+        counter.traversed(position + 1);
+        counter.hit(position + 1);
+        long long splicesBefore = counter.getSplices();
+        promotion.onHit(*this, prevPrevNode, prevNode, currNode, position);
+        if (counter.getSplices() != splicesBefore) {
+          counter.promoted();
+        }
+        return true;
+      }
+      prevPrevNode = prevNode;
+      prevNode = currNode;
+    }
+
+    counter.traversed(position);
+    counter.miss();
+    return false;
+  }
+
+  /**
+   * Retrieves the number of nodes traversed since the last reset
+   *
+   * @return  the count kept by the counter, always 0 for NullTraverseCounter
+   */
+  long long getTraverseCount() const { return counter.get(); }
+
+  /**
+   * Retrieves everything recorded by the counter since the last reset
+   *
+   * @return  the statistics, all 0 for NullTraverseCounter
+   */
+  const ListStatistics &getStatistics() const { return counter.statistics(); }
+
+  /**
+   * Resets the count of nodes traversed, and all other statistics, to 0
+   */
+  void resetTraverseCount() { counter.reset(); }
+
+  /**
+   * Retrieves the first node of this list for policies that restructure it
+   *
+   * @return  the first node, or nullptr if this list is empty
+   */
+  NodeType *front() { return nodeAt(head); }
+
+  /**
+   * Splices out the node following the specified node without releasing it.
+   * Used by promotion policies.
+   *
+   * @param   prevNode  the node before the node to splice out, or nullptr to
+   *                    splice out the first node
+   *
+   * @pre     the node to splice out must exist
+   */
+  void unlinkAfter(NodeType *prevNode) {
+    counter.spliced();
+    std::uint32_t index = prevNode == nullptr ? head : prevNode->next;
+    if (prevNode == nullptr) {
+      head = slots[index].next;
+    } else {
+      prevNode->next = slots[index].next;
+    }
+  }
+
+  /**
+   * Links a node that is not part of the list in as the first node of this
+   * list. Used by promotion policies.
+   *
+   * @param   node  the node to become the front of this list
+   */
+  void pushFront(NodeType *node) {
+    counter.spliced();
+    node->next = head;
+    head = indexOf(node);
+  }
+
+  /**
+   * Links a node that is not part of the list in right after the specified
+   * node. Used by promotion policies.
+   *
+   * @param   prevNode  the node to precede the linked node, or nullptr to
+   *                    link the node in as the front of this list
+   * @param   node      the node to link in
+   */
+  void insertAfter(NodeType *prevNode, NodeType *node) {
+    if (prevNode == nullptr) {
+      pushFront(node);
+    } else {
+      counter.spliced();
+      node->next = prevNode->next;
+      prevNode->next = indexOf(node);
+    }
+  }
+
+private:
+  /**
+   * Converts an index into the address of its node
+   *
+   * @param   index  index of a node, or CompactNode::NONE
+   *
+   * @return  the node, or nullptr for CompactNode::NONE
+   */
+  NodeType *nodeAt(std::uint32_t index) {
+    return index == CompactNode::NONE ? nullptr : slots.data() + index;
+  }
+
+  /**
+   * Converts the address of a node into its index
+   *
+   * @param   node  a node of this list, or nullptr
+   *
+   * @return  the index, or CompactNode::NONE for nullptr
+   */
+  std::uint32_t indexOf(const NodeType *node) const {
+    return node == nullptr ? CompactNode::NONE
+                           : std::uint32_t(node - slots.data());
+  }
+
+  /** Every node, in use or free; indices into it never change. */
+  std::vector<NodeType> slots;
+  /** The current number of nodes in this list. */
+  int currentSize;
+  /** Index of the first node, otherwise CompactNode::NONE. */
+  std::uint32_t head;
+  /** Index of the first free node, otherwise CompactNode::NONE. */
+  std::uint32_t freeHead;
+  /** Instrumentation told about every node traversed by contains. */
+  Counter counter;
+}; // end CompactSelfOrganizingList.h
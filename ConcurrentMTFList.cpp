@@ -0,0 +1,528 @@
+/**
+ * ConcurrentMTFList.cpp
+ *
+ * Implementations for the ConcurrentMTFList class, a "move-to-front" list that
+ * can be shared by many threads. Searches walk the list without taking a lock
+ * and validate a miss against a sequence counter, retrying (and finally
+ * locking) when a concurrent change may have hidden the sought value.
+ * Structural changes are serialized by a mutex; a promotion is skipped rather
+ * than waited for when another thread holds it. Removed Nodes are reclaimed
+ * by epoch: every search counts itself in its slot under the parity of the
+ * epoch it started in, and a new epoch starts only once no search of the
+ * previous one is left, so the Nodes removed two epochs ago are unreachable.
+ * Counters are kept per thread slot with relaxed atomics, and are not updated
+ * at all when built with NO_LIST_INSTRUMENTATION.
+ *
+ * Joshua Scheck
+ * 2020-10-18
+ */
+
+#include "ConcurrentMTFList.h"
+#include <new>
+
+/** Number of lock-free attempts at a search before falling back to locking */
+static const int OPTIMISTIC_ATTEMPTS = 4;
+
+/**
+ * Constructor for this ConcurrentMTFList class. Initializes an empty
+ * ConcurrentMTFList.
+ */
+ConcurrentMTFList::ConcurrentMTFList()
+    : head(nullptr), currentSize(0), sequence(0), epoch(0),
+      retired{nullptr, nullptr}, retiredCount(0) {
+  for (Slot &slot : slots) {
+    slot.readers[0].store(0, std::memory_order_relaxed);
+    slot.readers[1].store(0, std::memory_order_relaxed);
+  }
+  resetTraverseCount();
+}
+
+/**
+ * Destructor for this ConcurrentMTFList class that frees every Node, including
+ * removed Nodes not reclaimed yet.
+ *
+ * @pre     no other thread is using this ConcurrentMTFList
+ */
+ConcurrentMTFList::~ConcurrentMTFList() {
+  SharedNode *currNode = head.load(std::memory_order_relaxed);
+  while (currNode != nullptr) {
+    SharedNode *nextNode = currNode->next.load(std::memory_order_relaxed);
+    delete currNode;
+    currNode = nextNode;
+  }
+
+  for (SharedNode *batch : retired) {
+    while (batch != nullptr) {
+      SharedNode *nextNode = batch->retiredNext;
+      delete batch;
+      batch = nextNode;
+    }
+  }
+}
+
+/**
+ * Retrieves the current number of Nodes in this ConcurrentMTFList
+ *
+ * @return  the number of Nodes, which may change as soon as it is returned
+ */
+int ConcurrentMTFList::getCurrentSize() const {
+  return currentSize.load(std::memory_order_relaxed);
+}
+
+/**
+ * Determines if this ConcurrentMTFList has no Nodes
+ *
+ * @return  true if the list was empty when checked, false otherwise
+ */
+bool ConcurrentMTFList::isEmpty() const {
+  return head.load(std::memory_order_acquire) == nullptr;
+}
+
+/**
+ * Adds a new Node with the specified value to the beginning of this
+ * ConcurrentMTFList. Duplicate integer values are allowed.
+ *
+ * @param   newEntry integer value to be added
+ *
+ * @post             if successful, the size of this ConcurrentMTFList
+ * increases by 1 and the new Node is its front.
+ *
+ * @return           true if a new Node is successfully added, false if memory
+ *                   could not be allocated
+ */
+bool ConcurrentMTFList::add(int newEntry) {
+  SharedNode *newNode = nullptr;
+  try {
+    newNode = new SharedNode;
+  }
+  // inability to allocate memory will throw a std::bad_alloc error
+  // which will be caught and signals a lack of success
+  catch (std::bad_alloc &exc) {
+    return false;
+  }
+  newNode->item = newEntry;
+
+  std::lock_guard<std::mutex> guard(changeLock);
+  // linking in a new front cannot hide any Node from a search, so the
+  // sequence counter is left alone
+  newNode->next.store(head.load(std::memory_order_relaxed),
+                      std::memory_order_relaxed);
+  head.store(newNode, std::memory_order_release);
+  currentSize.fetch_add(1, std::memory_order_relaxed);
+  return true;
+}
+
+/**
+ * Removes the first occurrence of a Node containing the specified integer. The
+ * Node is deallocated once no concurrent search can reach it.
+ *
+ * @param   anEntry  the sought integer value to be removed
+ *
+ * @return           true if a Node is found and removed, false otherwise
+ */
+bool ConcurrentMTFList::remove(int anEntry) {
+  std::lock_guard<std::mutex> guard(changeLock);
+
+  SharedNode *prevNode = nullptr;
+  SharedNode *currNode = head.load(std::memory_order_relaxed);
+  while (currNode != nullptr) {
+    SharedNode *nextNode = currNode->next.load(std::memory_order_relaxed);
+    if (currNode->item == anEntry) {
+      beginChange();
+      if (prevNode == nullptr) {
+        head.store(nextNode, std::memory_order_release);
+      } else {
+        prevNode->next.store(nextNode, std::memory_order_release);
+      }
+      endChange();
+
+      currentSize.fetch_sub(1, std::memory_order_relaxed);
+      retire(currNode);
+      return true;
+    }
+
+    prevNode = currNode;
+    currNode = nextNode;
+  }
+
+  return false;
+}
+
+/**
+ * Removes all entries from this ConcurrentMTFList
+ *
+ * @post    the list is empty; its Nodes are deallocated once no concurrent
+ *          search can reach them
+ */
+void ConcurrentMTFList::clear() {
+  std::lock_guard<std::mutex> guard(changeLock);
+
+  beginChange();
+  SharedNode *currNode = head.exchange(nullptr, std::memory_order_acq_rel);
+  endChange();
+  currentSize.store(0, std::memory_order_relaxed);
+
+  // Nodes are unlinked all at once above, then queued one at a time
+  while (currNode != nullptr) {
+    SharedNode *nextNode = currNode->next.load(std::memory_order_relaxed);
+    retire(currNode);
+    currNode = nextNode;
+  }
+}
+
+/**
+ * Determines if the specified integer value is held by a Node in this
+ * ConcurrentMTFList without taking a lock, then moves the found Node to the
+ * front if no other thread is changing the list at that moment
+ *
+ * @param   anEntry  the sought integer value
+ *
+ * @post             the statistics of the calling thread's slot record the
+ * Nodes visited and the hit or miss. A found Node that is not the
+ * front is moved to the front, unless another thread holds the lock, in which
+ * case the skipped promotion is counted instead.
+ *
+ * @return           true if the value was held by this ConcurrentMTFList at
+ *                   some point during the call, false if it was not held at
+ *                   any point
+ */
+bool ConcurrentMTFList::contains(int anEntry) {
+  Slot &slot = threadSlot();
+  long long traversed = 0;
+
+  for (int attempt = 0; attempt < OPTIMISTIC_ATTEMPTS; attempt++) {
+    // announcing the search keeps removed Nodes from being reclaimed while
+    // they may still be read
+    unsigned long long entered = enterEpoch(slot);
+    unsigned observed = sequence.load(std::memory_order_acquire);
+
+    // a Node moved to the front mid-walk sends the walk back to the front,
+    // so the walk is cut short once it is longer than the list could be
+    long long limit = currentSize.load(std::memory_order_relaxed) + 1;
+    long long steps = 0;
+    SharedNode *prevNode = nullptr;
+    SharedNode *currNode = head.load(std::memory_order_acquire);
+    while (currNode != nullptr && steps <= limit) {
+      steps++;
+      if (currNode->item == anEntry) {
+        break;
+      }
+      prevNode = currNode;
+      currNode = currNode->next.load(std::memory_order_acquire);
+    }
+    traversed += steps;
+
+    if (currNode != nullptr && steps <= limit) {
+      // a hit is valid however the list changed, since the Node was reached
+      if (prevNode != nullptr) {
+        if (changeLock.try_lock()) {
+          if (promoteLocked(prevNode, currNode, observed)) {
+            recordPromotion(slot, false);
+          }
+          changeLock.unlock();
+        } else {
+          recordPromotion(slot, true);
+        }
+      }
+      leaveEpoch(slot, entered);
+      recordSearch(slot, traversed, steps);
+      return true;
+    }
+
+    // a miss is valid only if no change that can hide Nodes overlapped it
+    std::atomic_thread_fence(std::memory_order_acquire);
+    bool unchanged = (observed & 1u) == 0 &&
+                     sequence.load(std::memory_order_relaxed) == observed &&
+                     steps <= limit;
+    leaveEpoch(slot, entered);
+    if (unchanged) {
+      recordSearch(slot, traversed, 0);
+      return false;
+    }
+  }
+
+  // too many concurrent changes; search while holding the lock instead
+  std::lock_guard<std::mutex> guard(changeLock);
+  long long position = 0;
+  SharedNode *prevNode = nullptr;
+  SharedNode *currNode = head.load(std::memory_order_relaxed);
+  while (currNode != nullptr) {
+    position++;
+    if (currNode->item == anEntry) {
+      if (prevNode != nullptr &&
+          promoteLocked(prevNode, currNode,
+                        sequence.load(std::memory_order_relaxed))) {
+        recordPromotion(slot, false);
+      }
+      recordSearch(slot, traversed + position, position);
+      return true;
+    }
+    prevNode = currNode;
+    currNode = currNode->next.load(std::memory_order_relaxed);
+  }
+
+  recordSearch(slot, traversed + position, 0);
+  return false;
+}
+
+/**
+ * Retrieves the number of Nodes traversed by all threads since the last reset
+ *
+ * @return  the sum of the per-slot traversal counts
+ */
+long long ConcurrentMTFList::getTraverseCount() const {
+  long long total = 0;
+  for (const Slot &slot : slots) {
+    total += slot.traversals.load(std::memory_order_relaxed);
+  }
+  return total;
+}
+
+/**
+ * Retrieves the statistics of this ConcurrentMTFList since the last reset.
+ * They are kept per slot, so that lookups on different threads never write to
+ * a shared cache line, and summed here.
+ *
+ * @return  traversals, hits, misses, the histogram of hit positions,
+ *          promotions and splices; skipped promotions are not counted as
+ *          promotions. All 0 if instrumentation is compiled out.
+ */
+ListStatistics ConcurrentMTFList::getStatistics() const {
+  ListStatistics stats;
+  for (const Slot &slot : slots) {
+    stats.traversals += slot.traversals.load(std::memory_order_relaxed);
+    stats.hits += slot.hits.load(std::memory_order_relaxed);
+    stats.misses += slot.misses.load(std::memory_order_relaxed);
+    stats.promotions += slot.promotions.load(std::memory_order_relaxed);
+    for (int b = 0; b < ListStatistics::HISTOGRAM_BUCKETS; b++) {
+      stats.hitPositions[b] +=
+          slot.hitPositions[b].load(std::memory_order_relaxed);
+    }
+  }
+  // a promotion unlinks the Node and links it in at the front, as in MTFList
+  stats.splices = 2 * stats.promotions;
+  return stats;
+}
+
+/**
+ * Resets the statistics and skipped promotion counts of every slot to 0
+ */
+void ConcurrentMTFList::resetTraverseCount() {
+  for (Slot &slot : slots) {
+    slot.traversals.store(0, std::memory_order_relaxed);
+    slot.hits.store(0, std::memory_order_relaxed);
+    slot.misses.store(0, std::memory_order_relaxed);
+    slot.promotions.store(0, std::memory_order_relaxed);
+    for (std::atomic<long long> &bucket : slot.hitPositions) {
+      bucket.store(0, std::memory_order_relaxed);
+    }
+    slot.skippedPromotions.store(0, std::memory_order_relaxed);
+  }
+}
+
+/**
+ * Retrieves the number of promotions skipped because another thread was
+ * changing the list, since the last reset
+ *
+ * @return  the sum of the per-slot skipped promotion counts, 0 if
+ *          instrumentation is compiled out
+ */
+int ConcurrentMTFList::getSkippedPromotionCount() const {
+  int total = 0;
+  for (const Slot &slot : slots) {
+    total += slot.skippedPromotions.load(std::memory_order_relaxed);
+  }
+  return total;
+}
+
+/**
+ * Retrieves the number of removed Nodes not deallocated yet because a search
+ * that was running when they were removed may still read them
+ *
+ * @return  the number of Nodes waiting to be reclaimed
+ */
+int ConcurrentMTFList::getRetiredCount() const {
+  return retiredCount.load(std::memory_order_relaxed);
+}
+
+/**
+ * Retrieves the slot of the calling thread
+ *
+ * @return  a slot shared by roughly 1 / SLOT_COUNT of the threads
+ */
+ConcurrentMTFList::Slot &ConcurrentMTFList::threadSlot() {
+  static std::atomic<int> nextThread(0);
+  thread_local const int threadIndex =
+      nextThread.fetch_add(1, std::memory_order_relaxed) % SLOT_COUNT;
+  return slots[threadIndex];
+}
+
+/**
+ * Announces a search that may read Nodes in the current epoch
+ *
+ * @param   slot  the slot of the calling thread
+ *
+ * @return  the epoch the search is counted in, passed to leaveEpoch()
+ */
+unsigned long long ConcurrentMTFList::enterEpoch(Slot &slot) {
+  while (true) {
+    unsigned long long current = epoch.load(std::memory_order_seq_cst);
+    slot.readers[current & 1].fetch_add(1, std::memory_order_seq_cst);
+    // a search counted under an epoch that has since ended could be missed by
+    // retire(), so it backs out and counts itself in the new epoch instead
+    if (epoch.load(std::memory_order_seq_cst) == current) {
+      return current;
+    }
+    slot.readers[current & 1].fetch_sub(1, std::memory_order_release);
+  }
+}
+
+/**
+ * Ends a search announced by enterEpoch()
+ *
+ * @param   slot     the slot of the calling thread
+ * @param   entered  the epoch returned by enterEpoch()
+ */
+void ConcurrentMTFList::leaveEpoch(Slot &slot, unsigned long long entered) {
+  slot.readers[entered & 1].fetch_sub(1, std::memory_order_release);
+}
+
+/**
+ * Records the outcome of a search in a slot
+ *
+ * @param   slot       the slot of the calling thread
+ * @param   traversed  Nodes visited, over every attempt
+ * @param   position   one-based position the value was found at, or 0 for a
+ *                     miss
+ */
+void ConcurrentMTFList::recordSearch(Slot &slot, long long traversed,
+                                     long long position) {
+#ifndef NO_LIST_INSTRUMENTATION
+  slot.traversals.fetch_add(traversed, std::memory_order_relaxed);
+  if (position == 0) {
+    slot.misses.fetch_add(1, std::memory_order_relaxed);
+  } else {
+    slot.hits.fetch_add(1, std::memory_order_relaxed);
+    slot.hitPositions[ListStatistics::bucketOf(position)].fetch_add(
+        1, std::memory_order_relaxed);
+  }
+#else
+  (void)slot;
+  (void)traversed;
+  (void)position;
+#endif
+}
+
+/**
+ * Records a promotion in a slot
+ *
+ * @param   slot     the slot of the calling thread
+ * @param   skipped  true if the promotion was skipped because another thread
+ *                   held the lock, false if the Node was moved
+ */
+void ConcurrentMTFList::recordPromotion(Slot &slot, bool skipped) {
+#ifndef NO_LIST_INSTRUMENTATION
+  if (skipped) {
+    slot.skippedPromotions.fetch_add(1, std::memory_order_relaxed);
+  } else {
+    slot.promotions.fetch_add(1, std::memory_order_relaxed);
+  }
+#else
+  (void)slot;
+  (void)skipped;
+#endif
+}
+
+/**
+ * Moves a found Node to the front. The caller holds the lock.
+ *
+ * @param   prevNode  the Node observed before found, valid if the sequence
+ *                    counter still equals observed
+ * @param   found     the found Node, which may have been moved or removed
+ * @param   observed  the sequence counter when found was reached
+ *
+ * @return  true if the Node was moved, false if it had been removed or was
+ *          already the front
+ */
+bool ConcurrentMTFList::promoteLocked(SharedNode *prevNode, SharedNode *found,
+                                      unsigned observed) {
+  SharedNode *first = head.load(std::memory_order_relaxed);
+
+  // the observed predecessor may be stale if the list changed since; find the
+  // current one, giving up if found has been removed in the meantime
+  if ((observed & 1u) != 0 ||
+      sequence.load(std::memory_order_relaxed) != observed ||
+      prevNode->next.load(std::memory_order_relaxed) != found) {
+    prevNode = nullptr;
+    SharedNode *currNode = first;
+    while (currNode != nullptr && currNode != found) {
+      prevNode = currNode;
+      currNode = currNode->next.load(std::memory_order_relaxed);
+    }
+    if (currNode == nullptr || prevNode == nullptr) {
+      return false;
+    }
+  }
+
+  beginChange();
+  prevNode->next.store(found->next.load(std::memory_order_relaxed),
+                       std::memory_order_release);
+  found->next.store(first, std::memory_order_release);
+  head.store(found, std::memory_order_release);
+  endChange();
+  return true;
+}
+
+/**
+ * Marks the start of a change that can hide Nodes from a concurrent search.
+ * The caller holds the lock.
+ */
+void ConcurrentMTFList::beginChange() {
+  sequence.store(sequence.load(std::memory_order_relaxed) + 1,
+                 std::memory_order_relaxed);
+  std::atomic_thread_fence(std::memory_order_release);
+}
+
+/**
+ * Marks the end of a change started by beginChange(). The caller holds the
+ * lock.
+ */
+void ConcurrentMTFList::endChange() {
+  sequence.store(sequence.load(std::memory_order_relaxed) + 1,
+                 std::memory_order_release);
+}
+
+/**
+ * Queues an unlinked Node for reclamation in the current epoch, then starts a
+ * new epoch if no search of the previous one is still running, freeing the
+ * Nodes removed in the previous one. The caller holds the lock.
+ *
+ * @param   node  a Node no longer reachable from the front
+ */
+void ConcurrentMTFList::retire(SharedNode *node) {
+  unsigned long long current = epoch.load(std::memory_order_relaxed);
+  node->retiredNext = retired[current & 1];
+  retired[current & 1] = node;
+  retiredCount.fetch_add(1, std::memory_order_relaxed);
+
+  // Searches still running started in this epoch or the previous one. Once
+  // none of the previous one is left, the Nodes removed in it can only have
+  // been reached by searches that are over, since a search of this epoch
+  // started after they were unlinked.
+  std::atomic_thread_fence(std::memory_order_seq_cst);
+  for (const Slot &slot : slots) {
+    if (slot.readers[(current - 1) & 1].load(std::memory_order_seq_cst) != 0) {
+      return;
+    }
+  }
+  epoch.store(current + 1, std::memory_order_seq_cst);
+
+  SharedNode *batch = retired[(current + 1) & 1];
+  retired[(current + 1) & 1] = nullptr;
+  while (batch != nullptr) {
+    SharedNode *nextNode = batch->retiredNext;
+    delete batch;
+    retiredCount.fetch_sub(1, std::memory_order_relaxed);
+    batch = nextNode;
+  }
+} // end ConcurrentMTFList.cpp
@@ -0,0 +1,283 @@
+/**
+ * ConcurrentMTFList.h
+ *
+ * Declarations for the ConcurrentMTFList class, a "move-to-front" list that can
+ * be shared by many threads. Searches walk the list without taking a lock and
+ * validate a miss against a sequence counter, retrying (and finally locking)
+ * when a concurrent change may have hidden the sought value. Structural
+ * changes are serialized by a mutex; a promotion is skipped rather than waited
+ * for when another thread holds it. Removed Nodes are reclaimed by epoch: a
+ * batch is freed once every search that was running when it was removed has
+ * finished, however many searches started since. Counters are kept per
+ * thread slot with relaxed atomics, and are not updated at all when built
+ * with NO_LIST_INSTRUMENTATION.
+ *
+ * Joshua Scheck
+ * 2020-10-18
+ */
+
+#pragma once
+#include "IList.h"
+#include <atomic>
+#include <mutex>
+
+/**
+ * Represents a thread-safe move-to-front singly Linked List that is the
+ * subclass of IList
+ */
+class ConcurrentMTFList : public IList {
+public:
+  /**
+   * Constructor for this ConcurrentMTFList class. Initializes an empty
+   * ConcurrentMTFList.
+   */
+  ConcurrentMTFList();
+
+  /**
+   * Destructor for this ConcurrentMTFList class that frees every Node,
+   * including removed Nodes not reclaimed yet.
+   *
+   * @pre     no other thread is using this ConcurrentMTFList
+   */
+  ~ConcurrentMTFList() override;
+
+  ConcurrentMTFList(const ConcurrentMTFList &) = delete;
+  ConcurrentMTFList &operator=(const ConcurrentMTFList &) = delete;
+
+  /**
+   * Retrieves the current number of Nodes in this ConcurrentMTFList
+   *
+   * @return  the number of Nodes, which may change as soon as it is returned
+   */
+  int getCurrentSize() const override;
+
+  /**
+   * Determines if this ConcurrentMTFList has no Nodes
+   *
+   * @return  true if the list was empty when checked, false otherwise
+   */
+  bool isEmpty() const override;
+
+  /**
+   * Adds a new Node with the specified value to the beginning of this
+   * ConcurrentMTFList. Duplicate integer values are allowed.
+   *
+   * @param   newEntry integer value to be added
+   *
+   * @post             if successful, the size of this ConcurrentMTFList
+   * increases by 1 and the new Node is its front.
+   *
+   * @return           true if a new Node is successfully added, false if
+   *                   memory could not be allocated
+   */
+  bool add(int newEntry) override;
+
+  /**
+   * Removes the first occurrence of a Node containing the specified integer.
+   * The Node is deallocated once no concurrent search can reach it.
+   *
+   * @param   anEntry  the sought integer value to be removed
+   *
+   * @return           true if a Node is found and removed, false otherwise
+   */
+  bool remove(int anEntry) override;
+
+  /**
+   * Removes all entries from this ConcurrentMTFList
+   *
+   * @post    the list is empty; its Nodes are deallocated once no concurrent
+   *          search can reach them
+   */
+  void clear() override;
+
+  /**
+   * Determines if the specified integer value is held by a Node in this
+   * ConcurrentMTFList without taking a lock, then moves the found Node to the
+   * front if no other thread is changing the list at that moment
+   *
+   * @param   anEntry  the sought integer value
+   *
+   * @post             the statistics of the calling thread's slot record the
+   * Nodes visited and the hit or miss. A found Node that is not the
+   * front is moved to the front, unless another thread holds the lock, in
+   * which case the skipped promotion is counted instead.
+   *
+   * @return           true if the value was held by this ConcurrentMTFList
+   *                   at some point during the call, false if it was not held
+   *                   at any point
+   */
+  bool contains(int anEntry) override;
+
+  /**
+   * Retrieves the number of Nodes traversed by all threads since the last
+   * reset
+   *
+   * @return  the sum of the per-slot traversal counts
+   */
+  long long getTraverseCount() const override;
+
+  /**
+   * Retrieves the statistics of this ConcurrentMTFList since the last reset.
+   * They are kept per slot, so that lookups on different threads never write
+   * to a shared cache line, and summed here.
+   *
+   * @return  traversals, hits, misses, the histogram of hit positions,
+   *          promotions and splices; skipped promotions are not counted as
+   *          promotions. All 0 if instrumentation is compiled out.
+   */
+  ListStatistics getStatistics() const override;
+
+  /**
+   * Resets the statistics and skipped promotion counts of every slot to 0
+   */
+  void resetTraverseCount() override;
+
+  /**
+   * Retrieves the number of promotions skipped because another thread was
+   * changing the list, since the last reset
+   *
+   * @return  the sum of the per-slot skipped promotion counts, 0 if
+   *          instrumentation is compiled out
+   */
+  int getSkippedPromotionCount() const;
+
+  /**
+   * Retrieves the number of removed Nodes not deallocated yet because a
+   * search that was running when they were removed may still read them
+   *
+   * @return  the number of Nodes waiting to be reclaimed
+   */
+  int getRetiredCount() const;
+
+private:
+  /** A Node whose link can be read while another thread splices it */
+  struct SharedNode {
+    /** Integer value held by this Node */
+    int item;
+    /** Reference to the next Node in the list, otherwise nullptr */
+    std::atomic<SharedNode *> next;
+    /** Reference to the next Node waiting to be reclaimed */
+    SharedNode *retiredNext;
+  };
+
+  /** Number of slots that threads are spread over */
+  static const int SLOT_COUNT = 64;
+
+  /** Counters updated by the threads mapped to one slot, kept on their own
+   * cache lines so that threads do not contend for them */
+  struct alignas(64) Slot {
+    /** Number of searches currently reading Nodes, by the parity of the
+     * epoch they started in */
+    std::atomic<int> readers[2];
+    /** Nodes traversed by searches since the last reset */
+    std::atomic<long long> traversals;
+    /** Searches that found the sought value since the last reset */
+    std::atomic<long long> hits;
+    /** Searches that did not find the sought value since the last reset */
+    std::atomic<long long> misses;
+    /** Found Nodes moved to the front since the last reset */
+    std::atomic<long long> promotions;
+    /** Hits by bucket of their position, as in ListStatistics */
+    std::atomic<long long> hitPositions[ListStatistics::HISTOGRAM_BUCKETS];
+    /** Promotions skipped since the last reset */
+    std::atomic<int> skippedPromotions;
+  };
+
+  /**
+   * Retrieves the slot of the calling thread
+   *
+   * @return  a slot shared by roughly 1 / SLOT_COUNT of the threads
+   */
+  Slot &threadSlot();
+
+  /**
+   * Announces a search that may read Nodes in the current epoch
+   *
+   * @param   slot  the slot of the calling thread
+   *
+   * @return  the epoch the search is counted in, passed to leaveEpoch()
+   */
+  unsigned long long enterEpoch(Slot &slot);
+
+  /**
+   * Ends a search announced by enterEpoch()
+   *
+   * @param   slot     the slot of the calling thread
+   * @param   entered  the epoch returned by enterEpoch()
+   */
+  void leaveEpoch(Slot &slot, unsigned long long entered);
+
+  /**
+   * Records the outcome of a search in a slot
+   *
+   * @param   slot       the slot of the calling thread
+   * @param   traversed  Nodes visited, over every attempt
+   * @param   position   one-based position the value was found at, or 0 for
+   *                     a miss
+   */
+  static void recordSearch(Slot &slot, long long traversed,
+                           long long position);
+
+  /**
+   * Records a promotion in a slot
+   *
+   * @param   slot     the slot of the calling thread
+   * @param   skipped  true if the promotion was skipped because another
+   *                   thread held the lock, false if the Node was moved
+   */
+  static void recordPromotion(Slot &slot, bool skipped);
+
+  /**
+   * Moves a found Node to the front. The caller holds the lock.
+   *
+   * @param   prevNode  the Node observed before found, valid if the sequence
+   *                    counter still equals observed
+   * @param   found     the found Node, which may have been moved or removed
+   * @param   observed  the sequence counter when found was reached
+   *
+   * @return  true if the Node was moved, false if it had been removed or was
+   *          already the front
+   */
+  bool promoteLocked(SharedNode *prevNode, SharedNode *found,
+                     unsigned observed);
+
+  /**
+   * Marks the start of a change that can hide Nodes from a concurrent
+   * search. The caller holds the lock.
+   */
+  void beginChange();
+
+  /**
+   * Marks the end of a change started by beginChange(). The caller holds the
+   * lock.
+   */
+  void endChange();
+
+  /**
+   * Queues an unlinked Node for reclamation in the current epoch, then
+   * starts a new epoch if no search of the previous one is still running,
+   * freeing the Nodes removed in the previous one. The caller holds the lock.
+   *
+   * @param   node  a Node no longer reachable from the front
+   */
+  void retire(SharedNode *node);
+
+  /** Reference to the first Node, otherwise nullptr. */
+  std::atomic<SharedNode *> head;
+  /** The current number of Nodes. */
+  std::atomic<int> currentSize;
+  /** Odd while a change that can hide Nodes is being made. */
+  std::atomic<unsigned> sequence;
+  /** Serializes structural changes. */
+  std::mutex changeLock;
+  /** Advanced by retire() once the searches of the previous epoch are over;
+   * a Node removed in epoch e is freed when epoch e + 2 starts. */
+  std::atomic<unsigned long long> epoch;
+  /** Unlinked Nodes waiting until no search can read them, by the parity of
+   * the epoch they were removed in. */
+  SharedNode *retired[2];
+  /** Number of Nodes in retired. */
+  std::atomic<int> retiredCount;
+  /** Per-thread-slot counters. */
+  Slot slots[SLOT_COUNT];
+}; // end ConcurrentMTFList.h
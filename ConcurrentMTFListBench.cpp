@@ -0,0 +1,132 @@
+// Multi-threaded stress and throughput benchmark for ConcurrentMTFList
+//
+// Usage: ConcurrentMTFListBench [numValues] [millisecondsPerRun] [maxThreads]
+//
+// For 1, 2, 4, ... up to maxThreads (the hardware concurrency by default)
+// worker threads, every worker looks up normally distributed values for a
+// fixed time while one extra thread keeps adding and removing values outside
+// the looked-up range. Any lookup of a permanently held value that misses is a
+// correctness failure. Results are printed as CSV.
+//
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstdlib>
+#include <iostream>
+#include <random>
+#include <thread>
+#include <vector>
+
+#include "ConcurrentMTFList.h"
+
+using namespace std;
+
+/**
+ * Runs one timed round of lookups with the given number of worker threads
+ *
+ * @param   theList       list holding the values 0..numValues-1
+ * @param   numValues     number of permanently held values
+ * @param   numThreads    number of worker threads looking up values
+ * @param   milliseconds  duration of the round
+ * @param   failures      incremented for each lookup of a held value that
+ *                        missed
+ *
+ * @return  the total number of lookups performed by all workers
+ */
+long long runRound(ConcurrentMTFList &theList, int numValues, int numThreads,
+                   int milliseconds, atomic<long long> &failures)
+{
+   atomic<bool> stop(false);
+   atomic<long long> lookups(0);
+   vector<thread> workers;
+
+   for (int t = 0; t < numThreads; t++)
+   {
+      workers.emplace_back([&, t]() {
+         // every worker draws from its own independently seeded stream
+         mt19937_64 generator(0x9E3779B97F4A7C15ULL * (t + 1));
+         normal_distribution<double> normal(numValues / 2.0, numValues / 5.0);
+         long long done = 0;
+         while (!stop.load(memory_order_relaxed))
+         {
+            int theNumber = int(normal(generator));
+            if (theNumber < 0 || theNumber >= numValues)
+            {
+               continue;
+            }
+            if (!theList.contains(theNumber))
+            {
+               failures.fetch_add(1, memory_order_relaxed);
+            }
+            done++;
+         }
+         lookups.fetch_add(done, memory_order_relaxed);
+      });
+   }
+
+   // a mutator keeps removing Nodes so that reclamation is exercised
+   thread mutator([&]() {
+      int volatileValue = numValues;
+      while (!stop.load(memory_order_relaxed))
+      {
+         theList.add(volatileValue);
+         theList.remove(volatileValue);
+         volatileValue = numValues + (volatileValue - numValues + 1) % 64;
+      }
+   });
+
+   this_thread::sleep_for(chrono::milliseconds(milliseconds));
+   stop.store(true);
+   for (thread &worker : workers)
+   {
+      worker.join();
+   }
+   mutator.join();
+   return lookups.load();
+}
+
+int main(int argc, char *argv[])
+{
+   int numValues = argc > 1 ? atoi(argv[1]) : 1000;
+   int milliseconds = argc > 2 ? atoi(argv[2]) : 1000;
+   int maxThreads = argc > 3 ? atoi(argv[3])
+                             : int(max(1u, thread::hardware_concurrency()));
+
+   ConcurrentMTFList theList;
+   for (int i = numValues - 1; i >= 0; i--)
+   {
+      theList.add(i);
+   }
+
+   atomic<long long> failures(0);
+   double baseline = 0.0;
+
+   cout << "threads,lookups,lookups_per_sec,speedup,avg_traversals,"
+        << "skipped_promotions" << endl;
+   for (int numThreads = 1; numThreads <= maxThreads; numThreads *= 2)
+   {
+      theList.resetTraverseCount();
+      long long lookups =
+         runRound(theList, numValues, numThreads, milliseconds, failures);
+      double perSecond = lookups / (milliseconds / 1000.0);
+      if (baseline == 0.0)
+      {
+         baseline = perSecond;
+      }
+
+      // traversal counts are reset before every round, so this is the average
+      // of the last round only
+      cout << numThreads << "," << lookups << "," << perSecond << ","
+           << perSecond / baseline << ","
+           << theList.getTraverseCount() / double(max(1LL, lookups)) << ","
+           << theList.getSkippedPromotionCount() << endl;
+   }
+
+   if (failures.load() != 0)
+   {
+      cerr << failures.load() << " lookups of held values missed" << endl;
+      return 1;
+   }
+   return 0;
+} // end ConcurrentMTFListBench
@@ -0,0 +1,87 @@
+/**
+ * FenwickTree.cpp
+ *
+ * Implementations for the FenwickTree class, a binary indexed tree of integer
+ * counts supporting point updates and prefix sums in O(log n). IndexedMTFList
+ * uses it to count how many values were accessed after a given value.
+ *
+ * Joshua Scheck
+ * 2020-10-18
+ */
+
+#include "FenwickTree.h"
+
+/**
+ * Constructor for this FenwickTree class. Initializes every count to 0.
+ *
+ * @param   size  number of counts held
+ */
+FenwickTree::FenwickTree(int size) : tree(size + 1, 0) {}
+
+/**
+ * Retrieves the number of counts held by this FenwickTree
+ *
+ * @return  the number of counts
+ */
+int FenwickTree::size() const { return int(tree.size()) - 1; }
+
+/**
+ * Sets every count to 0 and changes the number of counts held
+ *
+ * @param   size  number of counts held afterwards
+ */
+void FenwickTree::reset(int size) { tree.assign(size + 1, 0); }
+
+/**
+ * Adds a (possibly negative) amount to one count
+ *
+ * @param   index  zero-based position of the count, less than size()
+ * @param   delta  amount to add
+ */
+void FenwickTree::add(int index, int delta) {
+  for (int i = index + 1; i < int(tree.size()); i += i & -i) {
+    tree[i] += delta;
+  }
+}
+
+/**
+ * Sums the counts at positions 0 through index
+ *
+ * @param   index  zero-based position of the last count summed, or -1 for an
+ *                 empty sum
+ *
+ * @return  the sum of the counts
+ */
+int FenwickTree::prefixSum(int index) const {
+  int sum = 0;
+  for (int i = index + 1; i > 0; i -= i & -i) {
+    sum += tree[i];
+  }
+  return sum;
+}
+
+/**
+ * Rebuilds this FenwickTree in linear time from a sequence of counts
+ *
+ * @param   counts  the count for every position
+ */
+void FenwickTree::build(const std::vector<int> &counts) {
+  tree.assign(counts.size() + 1, 0);
+  for (int i = 1; i < int(tree.size()); i++) {
+    tree[i] += counts[i - 1];
+    // each partial sum also contributes to the partial sum covering it
+    int parent = i + (i & -i);
+    if (parent < int(tree.size())) {
+      tree[parent] += tree[i];
+    }
+  }
+}
+
+/**
+ * Exchanges the counts of this FenwickTree with another one without allocating
+ *
+ * @param   other  the FenwickTree exchanged with
+ */
+void FenwickTree::swap(FenwickTree &other) {
+  tree.swap(other.tree);
+} // end FenwickTree.cpp
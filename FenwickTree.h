@@ -0,0 +1,78 @@
+/**
+ * FenwickTree.h
+ *
+ * Declarations for the FenwickTree class, a binary indexed tree of integer
+ * counts supporting point updates and prefix sums in O(log n). IndexedMTFList
+ * uses it to count how many values were accessed after a given value.
+ *
+ * Joshua Scheck
+ * 2020-10-18
+ */
+
+#pragma once
+#include <vector>
+
+/**
+ * Represents a fixed number of integer counts with logarithmic time updates and
+ * prefix sums
+ */
+class FenwickTree {
+public:
+  /**
+   * Constructor for this FenwickTree class. Initializes every count to 0.
+   *
+   * @param   size  number of counts held
+   */
+  explicit FenwickTree(int size = 0);
+
+  /**
+   * Retrieves the number of counts held by this FenwickTree
+   *
+   * @return  the number of counts
+   */
+  int size() const;
+
+  /**
+   * Sets every count to 0 and changes the number of counts held
+   *
+   * @param   size  number of counts held afterwards
+   */
+  void reset(int size);
+
+  /**
+   * Adds a (possibly negative) amount to one count
+   *
+   * @param   index  zero-based position of the count, less than size()
+   * @param   delta  amount to add
+   */
+  void add(int index, int delta);
+
+  /**
+   * Sums the counts at positions 0 through index
+   *
+   * @param   index  zero-based position of the last count summed, or -1 for
+   *                 an empty sum
+   *
+   * @return  the sum of the counts
+   */
+  int prefixSum(int index) const;
+
+  /**
+   * Rebuilds this FenwickTree in linear time from a sequence of counts
+   *
+   * @param   counts  the count for every position
+   */
+  void build(const std::vector<int> &counts);
+
+  /**
+   * Exchanges the counts of this FenwickTree with another one without
+   * allocating
+   *
+   * @param   other  the FenwickTree exchanged with
+   */
+  void swap(FenwickTree &other);
+
+private:
+  /** One-based partial sums; tree[i] covers the lowest set bit of i. */
+  std::vector<int> tree;
+}; // end FenwickTree.h
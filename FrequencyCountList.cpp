@@ -0,0 +1,69 @@
+/**
+ * FrequencyCountList.cpp
+ *
+ * Implementations for the "frequency count" linked list variant,
+ * FrequencyCountList, which is a subclass of LinkedList. Every Node keeps the
+ * number of times it was found, and FrequencyCountList overrides the
+ * LinkedList:contains(int anEntry) method so that Nodes stay ordered from the
+ * most to the least often found. New Nodes, found 0 times, are added at the
+ * end.
+ *
+ * Joshua Scheck
+ * 2020-10-18
+ */
+
+#include "FrequencyCountList.h"
+
+/**
+ * Overrides LinkedList::add(int newEntry) method. A new Node has no hits, so it
+ * is added to the end of this FrequencyCountList, behind every Node found at
+ * least once, which keeps the Nodes ordered by decreasing hit count. Duplicate
+ * integer values are allowed.
+ *
+ * @param   newEntry integer value to be added to the end of this
+ *                   FrequencyCountList
+ *
+ * @post             if successful, the size of this FrequencyCountList
+ * increases by 1 and the new Node is the last Node.
+ *
+ * @return           true if a new Node is successfully added, false if memory
+ *                   could not be allocated
+ */
+bool FrequencyCountList::add(int newEntry) { return nodes.addLast(newEntry); }
+
+/**
+ * Overrides LinkedList::contains(int anEntry) method. Similarly determines if
+ * the specified integer value is held by a Node in this FrequencyCountList, but
+ * then increments the hit count of the found Node and moves it ahead of every
+ * Node found fewer times
+ *
+ * @param   anEntry  the sought integer value held by a Node to be searched for
+ *                   in this FrequencyCountList
+ *
+ * @post             the traversal count is incremented by 1 with each Node
+ * traversed in the search for the first occurance of the specified integer
+ * value (even if not found). If the value is found, the hit count of its Node
+ * increases by 1 and the Node is placed right after the last Node with at least
+ * as many hits.
+ *
+ * @return           true if the specified integer value is contained in at
+ *                   least one Node in this FrequencyCountList, false otherwise
+ */
+bool FrequencyCountList::contains(int anEntry) {
+  return nodes.contains<FrequencyCount>(anEntry);
+}
+
+/**
+ * Overrides LinkedList::containsBatch method. Since every search changes the
+ * order that the next search sees, the values are sought one at a time.
+ *
+ * @param   keys  the sought integer values, in the order they are sought
+ * @param   n     number of sought values
+ * @param   out   set so that out[i] is the result of contains(keys[i])
+ *
+ * @return  always true
+ */
+bool FrequencyCountList::containsBatch(const int *keys, std::size_t n,
+                                       bool *out) {
+  return containsEach(keys, n, out);
+} // end FrequencyCountList.cpp
@@ -2,12 +2,13 @@
 //  Copyright (c) 2017 Pearson Education, Hoboken, New Jersey.
 
 #pragma once
+#include "TraverseCounters.h"
 
 class IList
 {
 public:
    /** Constructor */
-   IList () : traverseCount(0) { }
+   IList () { }
     
    /** Destroys object and frees memory allocated by object.
     (See C++ Interlude 2) */
@@ -46,13 +47,17 @@ public:
    virtual bool contains(int anEntry) = 0;
     
    /** Get the count of number of nodes traversed.
-    @return  The integer number of nodes traversed since last time the count was reset. */
-    virtual int getTraverseCount() const { return traverseCount; }
+    @return  The 64-bit number of nodes traversed since last time the
+       count was reset, or 0 if instrumentation is compiled out. */
+    virtual long long getTraverseCount() const = 0;
+
+   /** Get everything recorded about searches since the last reset:
+       traversals, hits, misses, a histogram of hit positions,
+       promotions and splices.
+    @return  The statistics, all 0 if instrumentation is compiled out. */
+    virtual ListStatistics getStatistics() const = 0;
      
-   /** Reset the count of nodes traversed to zero. */
-    virtual void resetTraverseCount() { traverseCount = 0; }
-    
-protected:
-    int traverseCount;
+   /** Reset the count of nodes traversed, and all other statistics, to zero. */
+    virtual void resetTraverseCount() = 0;
 }; // end IList
 
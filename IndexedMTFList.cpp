@@ -0,0 +1,311 @@
+/**
+ * IndexedMTFList.cpp
+ *
+ * Implementations for the IndexedMTFList class, a "move-to-front" list that
+ * finds values through a hash index instead of walking Nodes. Every value is
+ * stamped with the time it was last added or found, so the move-to-front order
+ * is the order of decreasing stamps, and a FenwickTree over the stamps gives
+ * the current position of any value in O(log n). The traverse count still
+ * reports the positions a linear MTFList would have walked.
+ *
+ * Joshua Scheck
+ * 2020-10-18
+ */
+
+#include "IndexedMTFList.h"
+#include <new>
+
+/** Number of stamps available to a new IndexedMTFList */
+static const int INITIAL_STAMPS = 16;
+
+/**
+ * Constructor for this IndexedMTFList class. Initializes an empty
+ * IndexedMTFList.
+ */
+IndexedMTFList::IndexedMTFList() : clock(0), currentSize(0) {}
+
+/**
+ * Retrieves the current number of values in this IndexedMTFList
+ *
+ * @post    state of this IndexedMTFList does not change
+ *
+ * @return  the number of values in this IndexedMTFList
+ */
+int IndexedMTFList::getCurrentSize() const { return currentSize; }
+
+/**
+ * Determines if the number of values in this IndexedMTFList is zero
+ *
+ * @post    state of this IndexedMTFList does not change
+ *
+ * @return  true if this IndexedMTFList holds no values, false otherwise
+ */
+bool IndexedMTFList::isEmpty() const { return currentSize == 0; }
+
+/**
+ * Adds the specified value to the beginning of this IndexedMTFList. Duplicate
+ * integer values are allowed; the newest copy is the one found first, as in
+ * LinkedList.
+ *
+ * @param   newEntry integer value to be added to the beginning of this
+ *                   IndexedMTFList
+ *
+ * @post             if successful, the size of this IndexedMTFList increases
+ * by 1 and newEntry is the first value. No change in class state if
+ * unsuccessful.
+ *
+ * @return           true if the value is successfully added, false if memory
+ *                   could not be allocated
+ */
+bool IndexedMTFList::add(int newEntry) {
+  auto found = stampsByValue.find(newEntry);
+  bool created = false;
+  try {
+    if (found == stampsByValue.end()) {
+      found = stampsByValue.emplace(newEntry, std::vector<int>()).first;
+      created = true;
+    }
+    // room for the stamp is made before it is handed out, so that nothing
+    // can fail once the stamps may have been compacted
+    std::vector<int> &stamps = found->second;
+    if (stamps.size() == stamps.capacity()) {
+      stamps.reserve(stamps.empty() ? 1 : 2 * stamps.size());
+    }
+    int stamp = nextStamp();
+    stamps.push_back(stamp);
+    stampValues[stamp] = newEntry;
+    stampInUse[stamp] = 1;
+    stampCounts.add(stamp, 1);
+    currentSize++;
+    return true;
+  }
+  // inability to allocate memory will throw a std::bad_alloc error
+  // which will be caught and signals a lack of success
+  catch (std::bad_alloc &exc) {
+    // an empty entry would be taken for a value held by contains and remove
+    if (created) {
+      stampsByValue.erase(found);
+    }
+    return false;
+  }
+}
+
+/**
+ * Removes the first occurrence of the specified integer from this
+ * IndexedMTFList
+ *
+ * @param   anEntry  the sought integer value to be removed
+ *
+ * @post             if successful, the size of this IndexedMTFList decreases
+ * by 1 and the remaining values keep their order. No change in class state if
+ * unsuccessful.
+ *
+ * @return           true if the value is found and removed, false otherwise
+ */
+bool IndexedMTFList::remove(int anEntry) {
+  auto found = stampsByValue.find(anEntry);
+  if (found == stampsByValue.end()) {
+    return false;
+  }
+
+  // the first occurrence is the copy with the most recent stamp
+  int stamp = found->second.back();
+  found->second.pop_back();
+  if (found->second.empty()) {
+    stampsByValue.erase(found);
+  }
+
+  stampInUse[stamp] = 0;
+  stampCounts.add(stamp, -1);
+  currentSize--;
+  return true;
+}
+
+/**
+ * Removes all entries from this IndexedMTFList
+ *
+ * @post    this IndexedMTFList is empty and its size is 0
+ */
+void IndexedMTFList::clear() {
+  stampsByValue.clear();
+  stampValues.clear();
+  stampInUse.clear();
+  stampCounts.reset(0);
+  clock = 0;
+  currentSize = 0;
+}
+
+/**
+ * Determines if the specified integer value is held in this IndexedMTFList
+ * using the hash index, then moves it to the front
+ *
+ * @param   anEntry  the sought integer value
+ *
+ * @post             the traversal count is incremented by the position
+ * the value held before the search (every value if not found), which is the
+ * number of Nodes an MTFList would have traversed. If found, the value is the
+ * first value of this IndexedMTFList.
+ *
+ * @return           true if the specified integer value is contained in this
+ *                   IndexedMTFList, false otherwise
+ */
+bool IndexedMTFList::contains(int anEntry) {
+  auto found = stampsByValue.find(anEntry);
+  if (found == stampsByValue.end()) {
+    counter.traversed(currentSize);
+    counter.miss();
+    return false;
+  }
+
+  int stamp = found->second.back();
+  int position = positionOf(stamp);
+  counter.traversed(position);
+  counter.hit(position);
+
+  // only restamp the value if it is not at the front already
+  if (position > 1) {
+    int newStamp = -1;
+    try {
+      newStamp = nextStamp();
+    }
+    // the value stays where it is if the stamps could not be compacted
+    catch (std::bad_alloc &exc) {
+      newStamp = -1;
+    }
+
+    if (newStamp >= 0) {
+      // compaction may have renumbered the stamp of the found value
+      stamp = found->second.back();
+      stampInUse[stamp] = 0;
+      stampCounts.add(stamp, -1);
+      found->second.back() = newStamp;
+      stampValues[newStamp] = anEntry;
+      stampInUse[newStamp] = 1;
+      stampCounts.add(newStamp, 1);
+      counter.promoted();
+    }
+  }
+
+  return true;
+}
+
+/**
+ * Retrieves the number of nodes traversed since the last time the count was
+ * reset in this IndexedMTFList.
+ *
+ * @post    state of this IndexedMTFList does not change
+ *
+ * @return  the number of values traversed
+ */
+long long IndexedMTFList::getTraverseCount() const { return counter.get(); }
+
+/**
+ * Retrieves everything recorded about this IndexedMTFList since the last reset
+ *
+ * @post    state of this IndexedMTFList does not change
+ *
+ * @return  traversals, hits, misses, the histogram of hit positions,
+ *          promotions and splices, all 0 if instrumentation is compiled out
+ */
+ListStatistics IndexedMTFList::getStatistics() const {
+  return counter.statistics();
+}
+
+/**
+ * Resets the count of values traversed in this IndexedMTFList
+ *
+ * @post sets the traversal count and all other statistics to 0
+ */
+void IndexedMTFList::resetTraverseCount() { counter.reset(); }
+
+/**
+ * Determines the current position of the first occurrence of the specified
+ * integer value without moving it
+ *
+ * @param   anEntry  the sought integer value
+ *
+ * @post    state of this IndexedMTFList does not change
+ *
+ * @return  the one-based position of the value counted from the front, or -1
+ *          if the value is not held by this IndexedMTFList
+ */
+int IndexedMTFList::rankOf(int anEntry) const {
+  auto found = stampsByValue.find(anEntry);
+  if (found == stampsByValue.end()) {
+    return -1;
+  }
+
+  return positionOf(found->second.back());
+}
+
+/**
+ * Hands out the next stamp, compacting the stamps in use (and growing the room
+ * for them if needed) once every stamp has been handed out
+ *
+ * @post    throws std::bad_alloc, leaving this IndexedMTFList unchanged, if
+ *          the stamps could not be compacted
+ *
+ * @return  the stamp handed out
+ */
+int IndexedMTFList::nextStamp() {
+  if (clock == int(stampValues.size())) {
+    // leaving at least as many free stamps as values in use means the
+    // linear time compaction happens at most once every currentSize accesses
+    int newCapacity = 2 * (currentSize + 1);
+    if (newCapacity < INITIAL_STAMPS) {
+      newCapacity = INITIAL_STAMPS;
+    }
+    restamp(newCapacity);
+  }
+
+  return clock++;
+}
+
+/**
+ * Renumbers the stamps in use as 0, 1, 2, ... keeping their order
+ *
+ * @param   newCapacity  number of stamps available afterwards, at least the
+ *                       size of this IndexedMTFList
+ */
+void IndexedMTFList::restamp(int newCapacity) {
+  std::vector<int> renumbered(stampValues.size(), -1);
+  std::vector<int> newValues(newCapacity, 0);
+  std::vector<int> newInUse(newCapacity, 0);
+
+  int next = 0;
+  for (int stamp = 0; stamp < clock; stamp++) {
+    if (stampInUse[stamp] != 0) {
+      renumbered[stamp] = next;
+      newValues[next] = stampValues[stamp];
+      newInUse[next] = 1;
+      next++;
+    }
+  }
+
+  FenwickTree newCounts;
+  newCounts.build(newInUse);
+
+  // nothing is modified until every allocation above has succeeded.
+  // Renumbering keeps the order, so every value's stamps stay sorted.
+  for (auto &entry : stampsByValue) {
+    for (int &stamp : entry.second) {
+      stamp = renumbered[stamp];
+    }
+  }
+
+  stampValues.swap(newValues);
+  stampInUse.swap(newInUse);
+  stampCounts.swap(newCounts);
+  clock = next;
+}
+
+/**
+ * Computes the one-based position of the value holding a stamp
+ *
+ * @param   stamp  a stamp in use
+ *
+ * @return  one more than the number of values stamped more recently
+ */
+int IndexedMTFList::positionOf(int stamp) const {
+  return currentSize - stampCounts.prefixSum(stamp) + 1;
+} // end IndexedMTFList.cpp
@@ -0,0 +1,190 @@
+/**
+ * IndexedMTFList.h
+ *
+ * Declarations for the IndexedMTFList class, a "move-to-front" list that finds
+ * values through a hash index instead of walking Nodes. Every value is stamped
+ * with the time it was last added or found, so the move-to-front order is the
+ * order of decreasing stamps, and a FenwickTree over the stamps gives the
+ * current position of any value in O(log n). The traverse count still reports
+ * the positions a linear MTFList would have walked.
+ *
+ * Joshua Scheck
+ * 2020-10-18
+ */
+
+#pragma once
+#include "FenwickTree.h"
+#include "IList.h"
+#include <unordered_map>
+#include <vector>
+
+/**
+ * Represents a hash-indexed move-to-front list with O(1) expected membership
+ * tests and O(log n) position queries that is the subclass of IList
+ */
+class IndexedMTFList : public IList {
+public:
+  /**
+   * Constructor for this IndexedMTFList class. Initializes an empty
+   * IndexedMTFList.
+   */
+  IndexedMTFList();
+
+  /**
+   * Retrieves the current number of values in this IndexedMTFList
+   *
+   * @post    state of this IndexedMTFList does not change
+   *
+   * @return  the number of values in this IndexedMTFList
+   */
+  int getCurrentSize() const override;
+
+  /**
+   * Determines if the number of values in this IndexedMTFList is zero
+   *
+   * @post    state of this IndexedMTFList does not change
+   *
+   * @return  true if this IndexedMTFList holds no values, false otherwise
+   */
+  bool isEmpty() const override;
+
+  /**
+   * Adds the specified value to the beginning of this IndexedMTFList.
+   * Duplicate integer values are allowed; the newest copy is the one found
+   * first, as in LinkedList.
+   *
+   * @param   newEntry integer value to be added to the beginning of this
+   *                   IndexedMTFList
+   *
+   * @post             if successful, the size of this IndexedMTFList
+   * increases by 1 and newEntry is the first value. No change in class state
+   * if unsuccessful.
+   *
+   * @return           true if the value is successfully added, false if
+   *                   memory could not be allocated
+   */
+  bool add(int newEntry) override;
+
+  /**
+   * Removes the first occurrence of the specified integer from this
+   * IndexedMTFList
+   *
+   * @param   anEntry  the sought integer value to be removed
+   *
+   * @post             if successful, the size of this IndexedMTFList
+   * decreases by 1 and the remaining values keep their order. No change in
+   * class state if unsuccessful.
+   *
+   * @return           true if the value is found and removed, false otherwise
+   */
+  bool remove(int anEntry) override;
+
+  /**
+   * Removes all entries from this IndexedMTFList
+   *
+   * @post    this IndexedMTFList is empty and its size is 0
+   */
+  void clear() override;
+
+  /**
+   * Determines if the specified integer value is held in this IndexedMTFList
+   * using the hash index, then moves it to the front
+   *
+   * @param   anEntry  the sought integer value
+   *
+   * @post             the traversal count is incremented by the
+   * position the value held before the search (every value if not found),
+   * which is the number of Nodes an MTFList would have traversed. If found,
+   * the value is the first value of this IndexedMTFList.
+   *
+   * @return           true if the specified integer value is contained in
+   *                   this IndexedMTFList, false otherwise
+   */
+  bool contains(int anEntry) override;
+
+  /**
+   * Retrieves the number of nodes traversed since the last time the count was
+   * reset in this IndexedMTFList.
+   *
+   * @post    state of this IndexedMTFList does not change
+   *
+   * @return  the number of values traversed
+   */
+  long long getTraverseCount() const override;
+
+  /**
+   * Retrieves everything recorded about this IndexedMTFList since the last
+   * reset
+   *
+   * @post    state of this IndexedMTFList does not change
+   *
+   * @return  traversals, hits, misses, the histogram of hit positions,
+   *          promotions and splices, all 0 if instrumentation is compiled out
+   */
+  ListStatistics getStatistics() const override;
+
+  /**
+   * Resets the count of values traversed in this IndexedMTFList
+   *
+   * @post sets the traversal count and all other statistics to 0
+   */
+  void resetTraverseCount() override;
+
+  /**
+   * Determines the current position of the first occurrence of the specified
+   * integer value without moving it
+   *
+   * @param   anEntry  the sought integer value
+   *
+   * @post    state of this IndexedMTFList does not change
+   *
+   * @return  the one-based position of the value counted from the front, or
+   *          -1 if the value is not held by this IndexedMTFList
+   */
+  int rankOf(int anEntry) const;
+
+private:
+  /**
+   * Hands out the next stamp, compacting the stamps in use (and growing the
+   * room for them if needed) once every stamp has been handed out
+   *
+   * @post    throws std::bad_alloc, leaving this IndexedMTFList unchanged, if
+   *          the stamps could not be compacted
+   *
+   * @return  the stamp handed out
+   */
+  int nextStamp();
+
+  /**
+   * Renumbers the stamps in use as 0, 1, 2, ... keeping their order
+   *
+   * @param   newCapacity  number of stamps available afterwards, at least the
+   *                       size of this IndexedMTFList
+   */
+  void restamp(int newCapacity);
+
+  /**
+   * Computes the one-based position of the value holding a stamp
+   *
+   * @param   stamp  a stamp in use
+   *
+   * @return  one more than the number of values stamped more recently
+   */
+  int positionOf(int stamp) const;
+
+  /** Stamps of the copies of every value held, oldest first. */
+  std::unordered_map<int, std::vector<int>> stampsByValue;
+  /** The value holding each stamp, when the stamp is in use. */
+  std::vector<int> stampValues;
+  /** 1 for every stamp in use, 0 otherwise. */
+  std::vector<int> stampInUse;
+  /** Running sums over stampInUse. */
+  FenwickTree stampCounts;
+  /** The stamp handed out next; larger stamps are closer to the front. */
+  int clock;
+  /** The current number of values in this IndexedMTFList. */
+  int currentSize;
+  /** Instrumentation of this IndexedMTFList; a no-op when built with
+   * NO_LIST_INSTRUMENTATION. */
+  ListCounter counter;
+}; // end IndexedMTFList.h
@@ -0,0 +1,210 @@
+/**
+ * LatencyHistogram.h
+ *
+ * Declaration and implementation of the LatencyHistogram class, a
+ * log-bucketed histogram of latencies in the style of HdrHistogram. Every
+ * power of two is split into 32 equal buckets, so a percentile is reported
+ * within about 3% of the latency recorded while recording is one increment,
+ * whatever the range of the latencies. Histograms of several runs merge by
+ * adding their buckets, so percentiles over many runs are exact to the same
+ * precision rather than averages of percentiles.
+ *
+ * Joshua Scheck
+ * 2020-10-18
+ */
+
+#pragma once
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <new>
+#include <vector>
+
+/**
+ * Represents a histogram of latencies in nanoseconds
+ */
+class LatencyHistogram {
+public:
+  /** Bits of a latency kept below its highest set bit */
+  static const int SUB_BUCKET_BITS = 5;
+  /** Buckets each power of two is split into */
+  static const int SUB_BUCKETS = 1 << SUB_BUCKET_BITS;
+  /** Latencies are recorded up to 2^MAX_EXPONENT - 1 ns, about 18 minutes;
+   * longer ones are counted as that */
+  static const int MAX_EXPONENT = 40;
+  /** Number of buckets */
+  static const int BUCKET_COUNT = (MAX_EXPONENT - SUB_BUCKET_BITS + 1) *
+                                  SUB_BUCKETS;
+
+  /**
+   * Constructor for this LatencyHistogram class. No memory is allocated until
+   * the first latency is recorded.
+   */
+  LatencyHistogram() : count(0), total(0), maximum(0) {}
+
+  /**
+   * Records one latency
+   *
+   * @param   nanoseconds  the latency
+   *
+   * @post    if memory for the buckets could be allocated, the latency is
+   *          counted. Otherwise nothing is recorded.
+   */
+  void record(std::uint64_t nanoseconds) {
+    if (counts.empty() && !allocate()) {
+      return;
+    }
+    if (nanoseconds >= (std::uint64_t(1) << MAX_EXPONENT)) {
+      nanoseconds = (std::uint64_t(1) << MAX_EXPONENT) - 1;
+    }
+    counts[bucketOf(nanoseconds)]++;
+    count++;
+    total += nanoseconds;
+    if (nanoseconds > maximum) {
+      maximum = nanoseconds;
+    }
+  }
+
+  /**
+   * Adds every latency recorded by another histogram
+   *
+   * @param   other  the histogram added
+   *
+   * @return  true if successful, false if memory could not be allocated
+   */
+  bool merge(const LatencyHistogram &other) {
+    if (other.count == 0) {
+      return true;
+    }
+    if (counts.empty() && !allocate()) {
+      return false;
+    }
+    for (int b = 0; b < BUCKET_COUNT; b++) {
+      counts[b] += other.counts[b];
+    }
+    count += other.count;
+    total += other.total;
+    if (other.maximum > maximum) {
+      maximum = other.maximum;
+    }
+    return true;
+  }
+
+  /**
+   * Forgets every latency recorded, keeping the buckets
+   */
+  void reset() {
+    for (std::uint64_t &bucket : counts) {
+      bucket = 0;
+    }
+    count = 0;
+    total = 0;
+    maximum = 0;
+  }
+
+  /**
+   * Retrieves the number of latencies recorded
+   *
+   * @return  the number of latencies
+   */
+  long long getCount() const { return (long long)count; }
+
+  /**
+   * Retrieves the longest latency recorded, exactly
+   *
+   * @return  the longest latency in nanoseconds, 0 if none was recorded
+   */
+  std::uint64_t getMax() const { return maximum; }
+
+  /**
+   * Computes the mean of the latencies recorded
+   *
+   * @return  the mean in nanoseconds, 0 if none was recorded
+   */
+  double getMean() const {
+    return count == 0 ? 0.0 : double(total) / double(count);
+  }
+
+  /**
+   * Finds the latency that a share of the recorded latencies do not exceed,
+   * such as 0.99 for the 99th percentile
+   *
+   * @param   fraction  the share, 0 to 1
+   *
+   * @return  the highest latency of the bucket holding that share of the
+   *          latencies, at most getMax(); 0 if none was recorded
+   */
+  std::uint64_t percentile(double fraction) const {
+    if (count == 0) {
+      return 0;
+    }
+    // the rank of the latency sought, counting from 1
+    std::uint64_t rank = std::uint64_t(std::ceil(fraction * double(count)));
+    rank = rank < 1 ? 1 : (rank > count ? count : rank);
+
+    std::uint64_t seen = 0;
+    for (int b = 0; b < BUCKET_COUNT; b++) {
+      seen += counts[b];
+      if (seen >= rank) {
+        std::uint64_t highest = highestOf(b);
+        return highest < maximum ? highest : maximum;
+      }
+    }
+    return maximum;
+  }
+
+private:
+  /**
+   * Obtains the buckets
+   *
+   * @return  true if successful, false if memory could not be allocated
+   */
+  bool allocate() {
+    try {
+      counts.assign(std::size_t(BUCKET_COUNT), 0);
+    }
+    // inability to allocate memory will throw a std::bad_alloc error
+    // which will be caught and signals a lack of success
+    catch (std::bad_alloc &exc) {
+      return false;
+    }
+    return true;
+  }
+
+  /**
+   * Finds the bucket of a latency: latencies below SUB_BUCKETS have a bucket
+   * each, and every longer latency shares its bucket with the latencies that
+   * have the same highest SUB_BUCKET_BITS + 1 bits
+   */
+  static int bucketOf(std::uint64_t nanoseconds) {
+    if (nanoseconds < std::uint64_t(SUB_BUCKETS)) {
+      return int(nanoseconds);
+    }
+    int exponent = 63 - __builtin_clzll(nanoseconds);
+    int shift = exponent - SUB_BUCKET_BITS;
+    return (shift + 1) * SUB_BUCKETS +
+           int(nanoseconds >> shift) - SUB_BUCKETS;
+  }
+
+  /**
+   * Finds the highest latency counted in a bucket
+   */
+  static std::uint64_t highestOf(int bucket) {
+    if (bucket < SUB_BUCKETS) {
+      return std::uint64_t(bucket);
+    }
+    int shift = bucket / SUB_BUCKETS - 1;
+    std::uint64_t lowest =
+        std::uint64_t(SUB_BUCKETS + bucket % SUB_BUCKETS) << shift;
+    return lowest + (std::uint64_t(1) << shift) - 1;
+  }
+
+  /** Latencies counted per bucket, empty until the first is recorded. */
+  std::vector<std::uint64_t> counts;
+  /** Number of latencies recorded. */
+  std::uint64_t count;
+  /** Sum of the latencies recorded. */
+  std::uint64_t total;
+  /** Longest latency recorded. */
+  std::uint64_t maximum;
+}; // end LatencyHistogram.h
@@ -4,37 +4,224 @@
  * Implementations for the "vanilla" LinkedList class, which initializes as an
  * empty list but can be populated with Nodes through the the addition of
  * integer values. Furthermore, the LinkedList class keeps track of traversals
- * of each Node during contains method calls.
+ * of each Node during contains method calls. LinkedList is a thin IList
+ * wrapper around a SelfOrganizingList of integers that never promotes Nodes.
  *
  * Joshua Scheck
  * 2020-10-18
  */
 
 #include "LinkedList.h"
-#include <iostream>
+#include <algorithm>
+#include <chrono>
+#include <climits>
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+#include <fcntl.h>
+#include <iterator>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#include <utility>
+#include <vector>
+
+namespace {
+
+/** Number of leading Nodes holding the values sought to time a relayout */
+const int RELAYOUT_PREFIX_NODES = 4096;
+/** Number of values sought to time a relayout */
+const int RELAYOUT_SAMPLE_VALUES = 64;
+/** Nodes walked at least by the timed lookups, so that short lists are timed
+ * over many rounds */
+const long long RELAYOUT_TIMED_NODES = 1 << 18;
+
+/**
+ * Picks values held by evenly spaced Nodes among the first Nodes of a list
+ *
+ * @param   head  the first Node, or nullptr
+ *
+ * @return  up to RELAYOUT_SAMPLE_VALUES values, front first
+ */
+std::vector<int> samplePrefix(const Node *head) {
+  int prefix = 0;
+  for (const Node *currNode = head;
+       currNode != nullptr && prefix < RELAYOUT_PREFIX_NODES;
+       currNode = currNode->next) {
+    prefix++;
+  }
+
+  std::vector<int> values;
+  int step = std::max(1, prefix / RELAYOUT_SAMPLE_VALUES);
+  int position = 0;
+  for (const Node *currNode = head; currNode != nullptr && position < prefix;
+       currNode = currNode->next, position++) {
+    if (position % step == step - 1) {
+      values.push_back(currNode->item);
+    }
+  }
+  return values;
+}
+
+/**
+ * Times lookups of values without counting traversals or moving Nodes
+ *
+ * @param   head    the first Node
+ * @param   values  the sought values, all held by the list
+ *
+ * @return  the wall-clock time per lookup in nanoseconds
+ */
+double timeLookups(const Node *head, const std::vector<int> &values) {
+  auto lookUp = [head, &values](std::size_t rotation) {
+    long long walked = 0;
+    for (std::size_t i = 0; i < values.size(); i++) {
+      // every round seeks the values in another order, so that rounds can
+      // not be merged by the compiler
+      int value = values[(i + rotation) % values.size()];
+      for (const Node *currNode = head; currNode != nullptr;
+           currNode = currNode->next) {
+        walked++;
+        if (currNode->item == value) {
+          break;
+        }
+      }
+    }
+    return walked;
+  };
+
+  // an untimed round brings the Nodes into the caches and sizes the rounds
+  long long perRound = std::max(1LL, lookUp(0));
+  long long rounds = std::max(1LL, RELAYOUT_TIMED_NODES / perRound);
+
+  static volatile long long sink = 0;
+  auto start = std::chrono::steady_clock::now();
+  for (long long round = 0; round < rounds; round++) {
+    sink = sink + lookUp(std::size_t(round));
+  }
+  auto elapsed = std::chrono::steady_clock::now() - start;
+  return std::chrono::duration<double, std::nano>(elapsed).count() /
+         double(rounds * (long long)values.size());
+}
+
+/** Identifies a snapshot file */
+const char SNAPSHOT_MAGIC[8] = {'M', 'T', 'F', 'S', 'N', 'A', 'P', 'S'};
+/** Version of the snapshot format written by save */
+const std::uint32_t SNAPSHOT_VERSION = 1;
+/** Size of the magic, the version, 4 reserved bytes and the Node count */
+const std::size_t SNAPSHOT_HEADER_BYTES = sizeof(SNAPSHOT_MAGIC) + 4 + 4 + 8;
+/** Bytes buffered by save before they are written */
+const std::size_t SNAPSHOT_BUFFER_BYTES = 1 << 16;
+
+/**
+ * Appends the little-endian bytes of an unsigned value
+ */
+void appendBytes(std::vector<unsigned char> &buffer, std::uint64_t value,
+                 int bytes) {
+  for (int i = 0; i < bytes; i++) {
+    buffer.push_back((unsigned char)(value >> (8 * i)));
+  }
+}
+
+/**
+ * Reads the little-endian bytes of an unsigned value
+ */
+std::uint64_t readBytes(const unsigned char *data, int bytes) {
+  std::uint64_t value = 0;
+  for (int i = 0; i < bytes; i++) {
+    value |= std::uint64_t(data[i]) << (8 * i);
+  }
+  return value;
+}
+
+/**
+ * Iterates over an array of little-endian 32-bit words, such as the values or
+ * hit counts of a snapshot, whatever the byte order of the machine
+ *
+ * @tparam  T  type each word is converted to
+ */
+template <typename T> struct LittleEndianWords {
+  typedef std::forward_iterator_tag iterator_category;
+  typedef T value_type;
+  typedef std::ptrdiff_t difference_type;
+  typedef const T *pointer;
+  typedef T reference;
+
+  /** The first byte of the current word */
+  const unsigned char *bytes;
+
+  T operator*() const { return T(std::uint32_t(readBytes(bytes, 4))); }
+  LittleEndianWords &operator++() {
+    bytes += 4;
+    return *this;
+  }
+  bool operator==(const LittleEndianWords &other) const {
+    return bytes == other.bytes;
+  }
+  bool operator!=(const LittleEndianWords &other) const {
+    return bytes != other.bytes;
+  }
+};
+
+} // namespace
 
 /**
  * Constructor for this LinkedList class. Initializes an empty LinkedList.
  */
-LinkedList::LinkedList() {
-  currentSize = 0;
-  head = nullptr;
+LinkedList::LinkedList() : LinkedList(NodeAllocation::Heap) {}
+
+/**
+ * Constructor for this LinkedList class. Initializes an empty LinkedList whose
+ * Nodes are obtained using the specified allocation mode.
+ *
+ * @param   allocation  NodeAllocation::Pooled to carve Nodes from per-list
+ *                      slabs, NodeAllocation::Heap to allocate each Node
+ *                      individually
+ */
+LinkedList::LinkedList(NodeAllocation allocation) : nodes(allocation) {}
+
+/**
+ * Move constructor for this LinkedList class. Takes over the Nodes of another
+ * LinkedList in constant time.
+ *
+ * @param   other  the LinkedList whose Nodes are taken over
+ *
+ * @post    other is empty
+ */
+LinkedList::LinkedList(LinkedList &&other) noexcept
+    : nodes(std::move(other.nodes)), lastRelayout(other.lastRelayout),
+      relayoutCount(other.relayoutCount) {}
+
+/**
+ * Move assignment for this LinkedList class. Frees the Nodes of this
+ * LinkedList, then takes over the Nodes of another LinkedList in constant
+ * time.
+ *
+ * @param   other  the LinkedList whose Nodes are taken over
+ *
+ * @post    other is empty
+ *
+ * @return  this LinkedList
+ */
+LinkedList &LinkedList::operator=(LinkedList &&other) noexcept {
+  nodes = std::move(other.nodes);
+  lastRelayout = other.lastRelayout;
+  relayoutCount = other.relayoutCount;
+  return *this;
 }
 
 /**
  * Destructor for this LinkedList class that destroys this LinkedList
  * and frees memory allocated by the object.
  *
- * Calls LinkedList::clear method.
+ * Nodes are freed by the destructor of the underlying SelfOrganizingList,
+ * which calls its clear method.
  *
  * @pre     LinkedList must be initialized
  *
  * @post    this LinkedList is empty with all prior Nodes being deallocated
  *          from memory
  */
-LinkedList::~LinkedList() {
-   clear(); 
-}
+LinkedList::~LinkedList() {}
 
 /**
  * Retrieves the current number of Nodes in this LinkedList
@@ -46,9 +233,7 @@ LinkedList::~LinkedList() {
  *
  * @return  the number of Nodes in this LinkedList
  */
-int LinkedList::getCurrentSize() const { 
-   return currentSize; 
-}
+int LinkedList::getCurrentSize() const { return nodes.getCurrentSize(); }
 
 /**
  * Determines if the number of Nodes in this list is zero
@@ -61,15 +246,7 @@ int LinkedList::getCurrentSize() const {
  * @return  true if the number of Nodes in this LinkedList
  *          is zero, false otherwise
  */
-bool LinkedList::isEmpty() const {
-  // check if there is no reference to a starting Node
-  if (head == nullptr) {
-    // assume that this LinkedList is empty if no starting Node
-    return true;
-  }
-  
-  return false;
-}
+bool LinkedList::isEmpty() const { return nodes.isEmpty(); }
 
 /**
  * Adds a new Node with the specified value to the beginning of this LinkedList.
@@ -90,23 +267,7 @@ bool LinkedList::isEmpty() const {
  * @return           true if a new Node is successfully added to the beginning
  * of this LinkedList, false otherwise
  */
-bool LinkedList::add(int newEntry) {
-  try {
-    Node *newNode = new Node;
-    newNode->item = newEntry;
-    // place list of Nodes currently in this LinkedList after newly created Node
-    newNode->next = head;
-    // newly created Node is the new front of this LinkedList
-    head = newNode;
-    currentSize++;
-    return true;
-  }
-  // inability to allocate memory will throw a std::bad_allac error
-  // which will be caught and signals a lack of success
-  catch (std::bad_alloc &exc) {
-    return false;
-  }
-}
+bool LinkedList::add(int newEntry) { return nodes.add(newEntry); }
 
 /**
  * Removes the first occurrence of a Node containing the specified integer
@@ -127,36 +288,285 @@ bool LinkedList::add(int newEntry) {
  * @return           true if a Node is found with the specified integer value
  * and is removed from this LinkedList, false otherwise
  */
-bool LinkedList::remove(int anEntry) {
+bool LinkedList::remove(int anEntry) { return nodes.remove(anEntry); }
+
+/**
+ * Moves every Node of another LinkedList to the end of this LinkedList
+ * without visiting the Nodes of either list
+ *
+ * @param   other  the LinkedList whose Nodes are moved
+ *
+ * @pre     both lists must be pooled, or both not pooled
+ *
+ * @post    if successful, other is empty and its values follow the values of
+ *          this LinkedList in their old order. No change in state if
+ *          unsuccessful.
+ *
+ * @return  true if successful, false if other is this LinkedList or the lists
+ *          obtain their Nodes differently
+ */
+bool LinkedList::append(LinkedList &other) { return nodes.append(other.nodes); }
+
+/**
+ * Moves every Node of another LinkedList to the beginning of this LinkedList
+ * without visiting the Nodes of either list
+ *
+ * @param   other  the LinkedList whose Nodes are moved
+ *
+ * @pre     both lists must be pooled, or both not pooled
+ *
+ * @post    if successful, other is empty and its values precede the values of
+ *          this LinkedList in their old order. No change in state if
+ *          unsuccessful.
+ *
+ * @return  true if successful, false if other is this LinkedList or the lists
+ *          obtain their Nodes differently
+ */
+bool LinkedList::splice(LinkedList &other) { return nodes.splice(other.nodes); }
 
-  Node *currNode = LinkedList::head;
-  Node *prevNode = nullptr;
+/**
+ * Copies every Node into one newly allocated slab in the current order of this
+ * LinkedList and frees the old Nodes, so that walks from the front read memory
+ * sequentially. Lookups of values held by the first Nodes are timed before and
+ * after.
+ *
+ * @post    if successful, the values and their order are unchanged, this
+ *          LinkedList is pooled from now on and getLastRelayout() reports the
+ *          timings. No change in state if unsuccessful.
+ *
+ * @return  true if successful, false if memory could not be allocated
+ */
+bool LinkedList::relayout() {
+  std::vector<int> sample;
+  try {
+    sample = samplePrefix(nodes.front());
+  }
+  // inability to allocate memory will throw a std::bad_alloc error
+  // which will be caught and signals a lack of success
+  catch (std::bad_alloc &exc) {
+    return false;
+  }
 
-  while (currNode != nullptr) {
-    if (currNode->item == anEntry) {
-      Node *nextNode = currNode->next;
-      // deallocate memory from removed Node and recalculate size
-      // of this LinkedList
-      delete currNode;
-      currNode = nullptr;
-      currentSize--;
+  RelayoutReport report;
+  report.nodes = nodes.getCurrentSize();
+  if (!sample.empty()) {
+    report.nsPerLookupBefore = timeLookups(nodes.front(), sample);
+  }
+  if (!nodes.relayout()) {
+    return false;
+  }
+  if (!sample.empty()) {
+    report.nsPerLookupAfter = timeLookups(nodes.front(), sample);
+  }
 
-      // after memory deallocation, replace currNode address to the
-      // address of the next Node in this LinkedList.
-      prevNode->next = nextNode;
-      return true;
+  lastRelayout = report;
+  relayoutCount++;
+  return true;
+}
+
+/**
+ * Copies every Node into one newly allocated slab in the current order of this
+ * LinkedList, as relayout() does, without timing lookups, for relayouts made
+ * in the middle of a measured workload
+ *
+ * @post    if successful, the values and their order are unchanged, this
+ *          LinkedList is pooled from now on and getLastRelayout() reports the
+ *          Nodes copied with timings of 0. No change in state if unsuccessful.
+ *
+ * @return  true if successful, false if memory could not be allocated
+ */
+bool LinkedList::relayoutUntimed() {
+  RelayoutReport report;
+  report.nodes = nodes.getCurrentSize();
+  if (!nodes.relayout()) {
+    return false;
+  }
+
+  lastRelayout = report;
+  relayoutCount++;
+  return true;
+}
+
+/**
+ * Retrieves what was measured around the latest relayout
+ *
+ * @return  the report, all 0 before the first relayout
+ */
+const RelayoutReport &LinkedList::getLastRelayout() const {
+  return lastRelayout;
+}
+
+/**
+ * Retrieves the number of relayouts of this LinkedList
+ *
+ * @return  the number of successful relayouts
+ */
+int LinkedList::getRelayoutCount() const { return relayoutCount; }
+
+/**
+ * Attaches a Bloom filter of the values held, kept up to date by add, remove
+ * and clear, so that contains answers most searches for absent values without
+ * traversing any Node
+ *
+ * @param   bitsPerValue  bits of filter per value; 10 rules out about 99% of
+ *                        absent values
+ *
+ * @post    if successful, the statistics count the misses the filter
+ *          answered, the traversals it saved and its false positives. No
+ *          change in state if unsuccessful.
+ *
+ * @return  true if successful, false if memory could not be allocated
+ */
+bool LinkedList::enableFilter(int bitsPerValue) {
+  return nodes.enableFilter(bitsPerValue);
+}
+
+/**
+ * Frees the Bloom filter, if any, so that every search walks the Nodes
+ */
+void LinkedList::disableFilter() { nodes.disableFilter(); }
+
+/**
+ * Determines whether a Bloom filter is attached
+ *
+ * @return  true if searches go through a filter, false otherwise
+ */
+bool LinkedList::hasFilter() const { return nodes.getFilter() != nullptr; }
+
+/**
+ * Writes the values of this LinkedList in their current order, with the hit
+ * count of every Node, to a snapshot file. A snapshot is the 8-byte magic
+ * "MTFSNAPS", a 4-byte version, 4 reserved bytes, an 8-byte Node count, then
+ * every value and then every hit count as 4-byte words, all little-endian.
+ * The file is written under a temporary name and renamed over path, so a
+ * failed save leaves any older snapshot intact.
+ *
+ * @param   path  name of the snapshot file
+ *
+ * @post    state of this LinkedList does not change
+ *
+ * @return  true if the snapshot was written, false otherwise
+ */
+bool LinkedList::save(const std::string &path) const {
+  std::string temporary = path + ".tmp";
+  std::FILE *file = std::fopen(temporary.c_str(), "wb");
+  if (file == nullptr) {
+    return false;
+  }
+
+  bool written = true;
+  try {
+    std::vector<unsigned char> buffer;
+    buffer.reserve(SNAPSHOT_BUFFER_BYTES + SNAPSHOT_HEADER_BYTES);
+    auto flush = [&buffer, &written, file]() {
+      if (written && !buffer.empty() &&
+          std::fwrite(buffer.data(), 1, buffer.size(), file) !=
+              buffer.size()) {
+        written = false;
+      }
+      buffer.clear();
+    };
+
+    buffer.insert(buffer.end(), SNAPSHOT_MAGIC,
+                  SNAPSHOT_MAGIC + sizeof(SNAPSHOT_MAGIC));
+    appendBytes(buffer, SNAPSHOT_VERSION, 4);
+    appendBytes(buffer, 0, 4);
+    appendBytes(buffer, std::uint64_t(nodes.getCurrentSize()), 8);
+
+    // values and hit counts are stored apart, so that a load reads each in
+    // one sequential sweep
+    for (const Node *currNode = nodes.front(); currNode != nullptr;
+         currNode = currNode->next) {
+      appendBytes(buffer, std::uint32_t(currNode->item), 4);
+      if (buffer.size() >= SNAPSHOT_BUFFER_BYTES) {
+        flush();
+      }
     }
+    for (const Node *currNode = nodes.front(); currNode != nullptr;
+         currNode = currNode->next) {
+      appendBytes(buffer, currNode->hits, 4);
+      if (buffer.size() >= SNAPSHOT_BUFFER_BYTES) {
+        flush();
+      }
+    }
+    flush();
+  }
+  // inability to allocate memory will throw a std::bad_alloc error
+  // which will be caught and signals a lack of success
+  catch (std::bad_alloc &exc) {
+    written = false;
+  }
+
+  if (std::fclose(file) != 0) {
+    written = false;
+  }
+  if (written && std::rename(temporary.c_str(), path.c_str()) != 0) {
+    written = false;
+  }
+  if (!written) {
+    std::remove(temporary.c_str());
+  }
+  return written;
+}
+
+/**
+ * Replaces the Nodes of this LinkedList with the values and hit counts of a
+ * snapshot file, in the order they were saved. The file is memory-mapped and
+ * every Node is carved from one slab in a single pass.
+ *
+ * @param   path  name of the snapshot file
+ *
+ * @post    if successful, this LinkedList holds the saved values in order and
+ *          is pooled from now on. No change in state if the file is not a
+ *          snapshot of a known version; empty if memory could not be
+ *          allocated.
+ *
+ * @return  true if the snapshot was loaded, false otherwise
+ */
+bool LinkedList::load(const std::string &path) {
+  int descriptor = ::open(path.c_str(), O_RDONLY);
+  if (descriptor < 0) {
+    return false;
+  }
 
-    prevNode = currNode;
-    currNode = currNode->next;
+  struct stat status;
+  void *mapping = MAP_FAILED;
+  if (fstat(descriptor, &status) == 0 &&
+      std::size_t(status.st_size) >= SNAPSHOT_HEADER_BYTES) {
+    mapping = mmap(nullptr, std::size_t(status.st_size), PROT_READ,
+                   MAP_PRIVATE, descriptor, 0);
   }
+  // the mapping stays valid once the descriptor is closed
+  ::close(descriptor);
+  if (mapping == MAP_FAILED) {
+    return false;
+  }
+
+  const unsigned char *data = static_cast<const unsigned char *>(mapping);
+  std::size_t size = std::size_t(status.st_size);
+  std::uint64_t count = readBytes(data + sizeof(SNAPSHOT_MAGIC) + 8, 8);
+  bool loaded =
+      std::memcmp(data, SNAPSHOT_MAGIC, sizeof(SNAPSHOT_MAGIC)) == 0 &&
+      readBytes(data + sizeof(SNAPSHOT_MAGIC), 4) == SNAPSHOT_VERSION &&
+      count <= std::uint64_t(INT_MAX) &&
+      size == SNAPSHOT_HEADER_BYTES + 8 * std::size_t(count);
 
-  return false;
+  if (loaded) {
+    madvise(mapping, size, MADV_SEQUENTIAL);
+    const unsigned char *items = data + SNAPSHOT_HEADER_BYTES;
+    const unsigned char *hits = items + 4 * std::size_t(count);
+    loaded = nodes.assign(LittleEndianWords<int>{items},
+                          LittleEndianWords<int>{hits},
+                          LittleEndianWords<unsigned>{hits});
+  }
+  munmap(mapping, size);
+  return loaded;
 }
 
 /**
  * Removes all entries from this list by sequentially deallocating memory
- * from each Node existing in this list
+ * from each Node existing in this list. When Nodes are pooled, every slab is
+ * instead returned to the freestore at once.
  *
  * @pre     LinkedList must be initialized, which will also initialize
  *          manipulated class members head and currentSize
@@ -164,25 +574,7 @@ bool LinkedList::remove(int anEntry) {
  * @post    this LinkedList will have no Nodes (is empty) and class member
  *          currentCount will be set to 0
  */
-void LinkedList::clear() {
-  Node *currNode = head;
-  Node *nextNode = nullptr;
-
-  // deallocate memory from Nodes in this LinkedList if not empty
-  while (currNode != nullptr) {
-    // obtains the reference for the next node to avoid dangling pointers
-    nextNode = currNode->next;
-    // deallocate memory from currentNode in freestore
-    delete currNode;
-    currNode = nullptr;
-    // move to the next Node in this LinkedList
-    currNode = nextNode;
-  }
-
-  // reset this LinkedList to starting conditions (empty list)
-  head = nullptr;
-  currentSize = 0;
-}
+void LinkedList::clear() { nodes.clear(); }
 
 /**
  * Determines if the specified integer value is held by a Node in this
@@ -192,9 +584,9 @@ void LinkedList::clear() {
  * in this LinkedList
  *
  * @pre              LinkedList must be initialized, which will also initialize
- *                   accessed class members head and traverseCount
+ *                   its Nodes and instrumentation
  *
- * @post             class member traverseCount is incremented by 1 with each
+ * @post             the traversal count is incremented by 1 with each
  * Node traversed in the search for the first occurance of the specified integer
  * value (even if not found). No traversals will occur if this LinkedList is
  * empty.
@@ -202,26 +594,28 @@ void LinkedList::clear() {
  * @return           true if the specified integer value is contained in
  *                   at least one Node in this LinkedList, false otherwise
  */
-bool LinkedList::contains(int anEntry) {
-  Node *currNode = head;
-
-  // look for specified integer in Nodes in this LinkedList
-  // if not empty or until the end of the list is reached
-  while (currNode != nullptr) {
-    // for each operation of looking into a Node, a traversal count
-    // is recorded
-    traverseCount++;
+bool LinkedList::contains(int anEntry) { return nodes.contains(anEntry); }
 
-    if (currNode->item == anEntry) {
-      return true;
-    }
-
-    currNode = currNode->next;
-  }
-
-  // returns false if this LinkedList is empty or if
-  // end is reached without finding specified integer value
-  return false;
+/**
+ * Determines for many integer values at once whether each is held by a Node in
+ * this LinkedList, resolving all of them in a single pass over the Nodes
+ * instead of one pass per value
+ *
+ * @param   keys  the sought integer values
+ * @param   n     number of sought values
+ * @param   out   set so that out[i] is true if keys[i] is contained in this
+ *                LinkedList, false otherwise
+ *
+ * @pre             keys and out must each reference n elements
+ *
+ * @post            the traversal count is incremented by 1 with each Node
+ * visited by the single pass, which ends once every distinct value is found
+ *
+ * @return          true if the values were looked up, false if memory for the
+ *                  lookup could not be allocated
+ */
+bool LinkedList::containsBatch(const int *keys, std::size_t n, bool *out) {
+  return nodes.containsBatch(keys, n, out);
 }
 
 /**
@@ -229,22 +623,52 @@ bool LinkedList::contains(int anEntry) {
  * reset in this LinkedList.
  *
  * @pre     LinkedList must be initialized, which will also initialize
- *          retrieved class member traverseCount
+ *          its instrumentation
  *
  * @post    state of this LinkedList does not change
  *
  * @return  the number of Nodes traversed
  */
-int LinkedList::getTraverseCount() const { return traverseCount; }
+long long LinkedList::getTraverseCount() const {
+  return nodes.getTraverseCount();
+}
+
+/**
+ * Retrieves everything recorded about this LinkedList since the last reset
+ *
+ * @post    state of this LinkedList does not change
+ *
+ * @return  traversals, hits, misses, the histogram of hit positions,
+ *          promotions and splices, all 0 if instrumentation is compiled out
+ */
+ListStatistics LinkedList::getStatistics() const {
+  return nodes.getStatistics();
+}
 
 /**
  * Resets the count of Nodes traversed in this LinkedList
  *
  * @pre  LinkedList must be initialized, which will also initialize
- *       accessed class member traverseCount
+ *       its instrumentation
  *
- * @post sets class member traverseCount to traverseCount to 0
+ * @post sets the traversal count and all other statistics to 0
  */
-void LinkedList::resetTraverseCount() {
-  traverseCount = 0;
-} // end LinkedList.cpp
\ No newline at end of file
+void LinkedList::resetTraverseCount() { nodes.resetTraverseCount(); }
+
+/**
+ * Looks up many integer values by calling contains for each of them in turn,
+ * for subclasses whose reorganization depends on the exact sequence of
+ * searches
+ *
+ * @param   keys  the sought integer values
+ * @param   n     number of sought values
+ * @param   out   set so that out[i] is the result of contains(keys[i])
+ *
+ * @return  always true
+ */
+bool LinkedList::containsEach(const int *keys, std::size_t n, bool *out) {
+  for (std::size_t i = 0; i < n; i++) {
+    out[i] = contains(keys[i]);
+  }
+  return true;
+} // end LinkedList.cpp
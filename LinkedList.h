@@ -4,7 +4,8 @@
  * Declarations for the "vanilla" LinkedList class, which initializes as an
  * empty list but can be populated with Nodes through the the addition of
  * integer values. Furthermore, the LinkedList class keeps track of traversals
- * of each Node during contains method calls.
+ * of each Node during contains method calls. LinkedList is a thin IList
+ * wrapper around a SelfOrganizingList of integers that never promotes Nodes.
  *
  * Joshua Scheck
  * 2020-10-18
@@ -12,16 +13,21 @@
 
 #pragma once
 #include "IList.h"
+#include "SelfOrganizingList.h"
+#include <cstddef>
+#include <string>
 
 /**
- * This struct represents a single node that composes a list ADT
+ * What a LinkedList measured around one relayout
  */
-struct Node {
-  /** Integer value held by this Node */
-  int item;
-  /** Reference to the address of the next Node in this LinkedList, otherwise
-   * nullptr */
-  struct Node *next;
+struct RelayoutReport {
+  /** Number of Nodes copied into the new slab */
+  int nodes = 0;
+  /** Wall-clock time per lookup of a sample of the values held by the first
+   * Nodes, before the relayout */
+  double nsPerLookupBefore = 0.0;
+  /** Wall-clock time per lookup of the same values after the relayout */
+  double nsPerLookupAfter = 0.0;
 };
 
 /**
@@ -35,11 +41,60 @@ public:
    */
   LinkedList();
 
+  /**
+   * Constructor for this LinkedList class. Initializes an empty LinkedList
+   * whose Nodes are obtained using the specified allocation mode.
+   *
+   * @param   allocation  NodeAllocation::Pooled to carve Nodes from per-list
+   *                      slabs, NodeAllocation::Heap to allocate each Node
+   *                      individually
+   */
+  explicit LinkedList(NodeAllocation allocation);
+
+  /**
+   * Constructor for this LinkedList class. Initializes a LinkedList holding a
+   * range of integer values, whose Nodes are carved from one slab allocated
+   * at once.
+   *
+   * @param   first  the value to become the first Node
+   * @param   last   the end of the range
+   *
+   * @post    this LinkedList holds the values in range order and is pooled,
+   *          or is empty if memory could not be allocated
+   */
+  template <typename ForwardIt> LinkedList(ForwardIt first, ForwardIt last) {
+    nodes.assign(first, last);
+  }
+
+  /**
+   * Move constructor for this LinkedList class. Takes over the Nodes of
+   * another LinkedList in constant time.
+   *
+   * @param   other  the LinkedList whose Nodes are taken over
+   *
+   * @post    other is empty
+   */
+  LinkedList(LinkedList &&other) noexcept;
+
+  /**
+   * Move assignment for this LinkedList class. Frees the Nodes of this
+   * LinkedList, then takes over the Nodes of another LinkedList in constant
+   * time.
+   *
+   * @param   other  the LinkedList whose Nodes are taken over
+   *
+   * @post    other is empty
+   *
+   * @return  this LinkedList
+   */
+  LinkedList &operator=(LinkedList &&other) noexcept;
+
   /**
    * Destructor for this LinkedList class that destroys this LinkedList
    * and frees memory allocated by the object.
    *
-   * Calls LinkedList::clear() method.
+   * Nodes are freed by the destructor of the underlying SelfOrganizingList,
+   * which calls its clear method.
    *
    * @pre     LinkedList must be initialized
    *
@@ -115,9 +170,148 @@ public:
    */
   bool remove(int anEntry) override;
 
+  /**
+   * Replaces the Nodes of this LinkedList with Nodes holding a range of
+   * integer values, all carved from one slab allocated at once
+   *
+   * @param   first  the value to become the first Node
+   * @param   last   the end of the range
+   *
+   * @post    if successful, this LinkedList holds the values in range order
+   *          and is pooled from now on. This LinkedList is empty if
+   *          unsuccessful.
+   *
+   * @return  true if the values are held, false if memory could not be
+   *          allocated
+   */
+  template <typename ForwardIt> bool assign(ForwardIt first, ForwardIt last) {
+    return nodes.assign(first, last);
+  }
+
+  /**
+   * Moves every Node of another LinkedList to the end of this LinkedList
+   * without visiting the Nodes of either list
+   *
+   * @param   other  the LinkedList whose Nodes are moved
+   *
+   * @pre     both lists must be pooled, or both not pooled
+   *
+   * @post    if successful, other is empty and its values follow the values
+   *          of this LinkedList in their old order. No change in state if
+   *          unsuccessful.
+   *
+   * @return  true if successful, false if other is this LinkedList or the
+   *          lists obtain their Nodes differently
+   */
+  bool append(LinkedList &other);
+
+  /**
+   * Moves every Node of another LinkedList to the beginning of this
+   * LinkedList without visiting the Nodes of either list
+   *
+   * @param   other  the LinkedList whose Nodes are moved
+   *
+   * @pre     both lists must be pooled, or both not pooled
+   *
+   * @post    if successful, other is empty and its values precede the values
+   *          of this LinkedList in their old order. No change in state if
+   *          unsuccessful.
+   *
+   * @return  true if successful, false if other is this LinkedList or the
+   *          lists obtain their Nodes differently
+   */
+  bool splice(LinkedList &other);
+
+  /**
+   * Copies every Node into one newly allocated slab in the current order of
+   * this LinkedList and frees the old Nodes, so that walks from the front
+   * read memory sequentially. Lookups of values held by the first Nodes are
+   * timed before and after.
+   *
+   * @post    if successful, the values and their order are unchanged, this
+   *          LinkedList is pooled from now on and getLastRelayout() reports
+   *          the timings. No change in state if unsuccessful.
+   *
+   * @return  true if successful, false if memory could not be allocated
+   */
+  bool relayout();
+
+  /**
+   * Retrieves what was measured around the latest relayout
+   *
+   * @return  the report, all 0 before the first relayout
+   */
+  const RelayoutReport &getLastRelayout() const;
+
+  /**
+   * Retrieves the number of relayouts of this LinkedList
+   *
+   * @return  the number of successful relayouts
+   */
+  int getRelayoutCount() const;
+
+  /**
+   * Attaches a Bloom filter of the values held, kept up to date by add,
+   * remove and clear, so that contains answers most searches for absent
+   * values without traversing any Node
+   *
+   * @param   bitsPerValue  bits of filter per value; 10 rules out about 99%
+   *                        of absent values
+   *
+   * @post    if successful, the statistics count the misses the filter
+   *          answered, the traversals it saved and its false positives. No
+   *          change in state if unsuccessful.
+   *
+   * @return  true if successful, false if memory could not be allocated
+   */
+  bool enableFilter(int bitsPerValue = BloomFilter::DEFAULT_BITS_PER_KEY);
+
+  /**
+   * Frees the Bloom filter, if any, so that every search walks the Nodes
+   */
+  void disableFilter();
+
+  /**
+   * Determines whether a Bloom filter is attached
+   *
+   * @return  true if searches go through a filter, false otherwise
+   */
+  bool hasFilter() const;
+
+  /**
+   * Writes the values of this LinkedList in their current order, with the
+   * hit count of every Node, to a snapshot file. The file is written under a
+   * temporary name and renamed over path, so a failed save leaves any older
+   * snapshot intact.
+   *
+   * @param   path  name of the snapshot file
+   *
+   * @post    state of this LinkedList does not change
+   *
+   * @return  true if the snapshot was written, false otherwise
+   */
+  bool save(const std::string &path) const;
+
+  /**
+   * Replaces the Nodes of this LinkedList with the values and hit counts of
+   * a snapshot file, in the order they were saved. The file is memory-mapped
+   * and every Node is carved from one slab in a single pass.
+   *
+   * @param   path  name of the snapshot file
+   *
+   * @post    if successful, this LinkedList holds the saved values in order
+   *          and is pooled from now on. No change in state if the file is
+   *          not a snapshot of a known version; empty if memory could not be
+   *          allocated.
+   *
+   * @return  true if the snapshot was loaded, false otherwise
+   */
+  bool load(const std::string &path);
+
   /**
    * Removes all entries from this list by sequentially deallocating memory
-   * from each Node existing in this list
+   * from each Node existing in this list. When Nodes are pooled, every slab is
+   * instead returned to the freestore at once.
    *
    * @pre     LinkedList must be initialized, which will also initialize
    *          manipulated class members head and currentSize
@@ -135,9 +329,9 @@ public:
    * for in this LinkedList
    *
    * @pre              LinkedList must be initialized, which will also
-   * initialize accessed class members head and traverseCount
+   * initialize its Nodes and instrumentation
    *
-   * @post             class member traverseCount is incremented by 1 with each
+   * @post             the traversal count is incremented by 1 with each
    * Node traversed in the search for the first occurance of the specified
    *                   integer value (even if not found). No traversals will
    * occur if this LinkedList is empty.
@@ -147,33 +341,92 @@ public:
    */
   bool contains(int anEntry) override;
 
+  /**
+   * Determines for many integer values at once whether each is held by a Node
+   * in this LinkedList, resolving all of them in a single pass over the Nodes
+   * instead of one pass per value
+   *
+   * @param   keys  the sought integer values
+   * @param   n     number of sought values
+   * @param   out   set so that out[i] is true if keys[i] is contained in this
+   *                LinkedList, false otherwise
+   *
+   * @pre             keys and out must each reference n elements
+   *
+   * @post            the traversal count is incremented by 1 with each Node
+   * visited by the single pass, which ends once every distinct value is found
+   *
+   * @return          true if the values were looked up, false if memory for
+   *                  the lookup could not be allocated
+   */
+  virtual bool containsBatch(const int *keys, std::size_t n, bool *out);
+
   /**
    * Retrieves the number of nodes traversed since the last time the count was
    * reset in this LinkedList.
    *
    * @pre     LinkedList must be initialized, which will also initialize
-   *          retrieved class member traverseCount
+   *          its instrumentation
    *
    * @post    state of this LinkedList does not change
    *
    * @return  the number of Nodes traversed
    */
-  int getTraverseCount() const override;
+  long long getTraverseCount() const override;
+
+  /**
+   * Retrieves everything recorded about this LinkedList since the last reset
+   *
+   * @post    state of this LinkedList does not change
+   *
+   * @return  traversals, hits, misses, the histogram of hit positions,
+   *          promotions and splices, all 0 if instrumentation is compiled out
+   */
+  ListStatistics getStatistics() const override;
 
   /**
    * Resets the count of Nodes traversed in this LinkedList
    *
    * @pre  LinkedList must be initialized, which will also initialize
-   *       accessed class member traverseCount
+   *       its instrumentation
    *
-   * @post sets class member traverseCount to traverseCount to 0
+   * @post sets the traversal count and all other statistics to 0
    */
   void resetTraverseCount() override;
 
 protected:
-  /** The current number of Nodes in this LinkedList. */
-  int currentSize;
-  /** Reference to the address of the first Node in this LinkedList, otherwise
-   * nullptr. */
-  Node *head;
+  /**
+   * Looks up many integer values by calling contains for each of them in
+   * turn, for subclasses whose reorganization depends on the exact sequence
+   * of searches
+   *
+   * @param   keys  the sought integer values
+   * @param   n     number of sought values
+   * @param   out   set so that out[i] is the result of contains(keys[i])
+   *
+   * @return  always true
+   */
+  bool containsEach(const int *keys, std::size_t n, bool *out);
+
+  /**
+   * Copies every Node into one newly allocated slab in the current order of
+   * this LinkedList, as relayout() does, without timing lookups, for
+   * relayouts made in the middle of a measured workload
+   *
+   * @post    if successful, the values and their order are unchanged, this
+   *          LinkedList is pooled from now on and getLastRelayout() reports
+   *          the Nodes copied with timings of 0. No change in state if
+   *          unsuccessful.
+   *
+   * @return  true if successful, false if memory could not be allocated
+   */
+  bool relayoutUntimed();
+
+  /** The Nodes of this LinkedList. Subclasses choose how a search promotes
+   * the Node it finds by calling contains with their own policy. */
+  SelfOrganizingList<int, NoPromotion, ListCounter> nodes;
+  /** What was measured around the latest relayout. */
+  RelayoutReport lastRelayout;
+  /** The number of successful relayouts. */
+  int relayoutCount = 0;
 }; // end LinkedList.h
\ No newline at end of file
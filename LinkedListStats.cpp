@@ -1,15 +1,54 @@
 // Test program to evaluate linked list performance
 // Written 10/4/19 by Michael Stiber
 //
+// Runs every IList implementation in ListCatalog (or those selected with
+// --lists) against configurable list sizes, access counts, seeds and access
+// distributions, and reports the average number of nodes traversed and the
+// wall-clock time per access as text, CSV or JSON. Run with --help for the
+// options, or --test to run the unit and integration tests.
+//
 
+#include <algorithm>
+#include <atomic>
 #include <iostream>
+#include <stdexcept>
 #include <string>
 #include <random>
+#include <set>
+#include <sstream>
 #include <vector>
 #include <cassert>
+#include <climits>
+#include <cstdint>
+#include <cstdlib>
+#include <memory>
+#include <thread>
+#include <sys/wait.h>
+#include <unistd.h>
 
+#include "AccessTrace.h"
+#include "Benchmark.h"
+#include "CompactLinkedList.h"
+#include "ConcurrentMTFList.h"
+#include "FrequencyCountList.h"
+#include "IndexedMTFList.h"
+#include "LatencyHistogram.h"
 #include "LinkedList.h"
+#include "ListCatalog.h"
+#include "MTFArray.h"
+#include "MTFCache.h"
+#include "MTFCodec.h"
 #include "MTFList.h"
+#include "MoveAheadKList.h"
+#include "SelfOrganizingList.h"
+#include "ShardedMTFList.h"
+#include "SharedMTFList.h"
+#include "SplayTreeList.h"
+#include "Sweep.h"
+#include "TimedList.h"
+#include "TransposeList.h"
+#include "UnrolledList.h"
+#include "Workloads.h"
 
 using namespace std;
 
@@ -127,6 +166,1690 @@ void testModifiedContainsAndTraverseCount() {
    assert(testList.getTraverseCount() == 1);
 }
 
+/**
+ * Tests LinkedList and MTFList behavior when Nodes are drawn from a NodePool
+ */ 
+void testPooledAllocation() {
+   MTFList testList(NodeAllocation::Pooled);
+   for (int i = 0; i < 600; i++) {
+      assert(testList.add(i));
+   }
+   assert(testList.getCurrentSize() == 600);
+
+   // removal works at the front, middle and end of the list
+   assert(testList.remove(599));
+   assert(testList.remove(300));
+   assert(testList.remove(0));
+   assert(testList.contains(300) == false);
+   assert(testList.getCurrentSize() == 597);
+
+   // removed Nodes are reused and move-to-front still splices correctly
+   assert(testList.add(1000));
+   assert(testList.contains(1));
+   testList.resetTraverseCount();
+   assert(testList.contains(1));
+   assert(testList.getTraverseCount() == 1);
+
+   testList.clear();
+   assert(testList.isEmpty() == true);
+   assert(testList.add(7));
+   assert(testList.contains(7));
+}
+
+/**
+ * Finds the 1-based position of a value in a LinkedList, which never reorders
+ */
+long long positionOf(LinkedList &theList, int value) {
+   theList.resetTraverseCount();
+   return theList.contains(value) ? theList.getTraverseCount() : -1;
+}
+
+/**
+ * Tests bulk construction, moves, append and splice of LinkedList
+ */ 
+void testBulkAndSplice() {
+   vector<int> values = {5, 6, 7, 8};
+   LinkedList bulkList(values.begin(), values.end());
+   assert(bulkList.getCurrentSize() == 4);
+   for (int i = 0; i < 4; i++) {
+      assert(positionOf(bulkList, values[i]) == i + 1);
+   }
+   // a bulk-built list keeps working as an ordinary list
+   assert(bulkList.add(4));
+   assert(bulkList.remove(8));
+   assert(bulkList.add(9));
+   assert(positionOf(bulkList, 7) == 5);
+
+   int raw[] = {1, 2, 3};
+   assert(bulkList.assign(raw, raw + 3));
+   assert(bulkList.getCurrentSize() == 3);
+   assert(positionOf(bulkList, 3) == 3);
+   assert(bulkList.assign(raw, raw));
+   assert(bulkList.isEmpty());
+
+   // moves hand the Nodes over and leave the source empty
+   MTFList source(values.begin(), values.end());
+   MTFList moved(std::move(source));
+   assert(source.isEmpty());
+   assert(moved.getCurrentSize() == 4);
+   assert(moved.contains(8));
+   vector<LinkedList> stored;
+   stored.push_back(LinkedList(raw, raw + 3));
+   stored.emplace_back();
+   stored.push_back(LinkedList(values.begin(), values.end()));
+   assert(stored[0].getCurrentSize() == 3);
+   assert(stored[2].getCurrentSize() == 4);
+   stored[1] = std::move(stored[2]);
+   assert(stored[1].getCurrentSize() == 4 && stored[2].isEmpty());
+
+   // append and splice join pooled lists, keeping every Node usable
+   LinkedList front(raw, raw + 3);
+   LinkedList back(values.begin(), values.end());
+   assert(front.append(back));
+   assert(back.isEmpty());
+   assert(front.getCurrentSize() == 7);
+   assert(positionOf(front, 8) == 7);
+   LinkedList first(raw, raw + 1);
+   assert(front.splice(first));
+   assert(positionOf(front, 1) == 1);
+   assert(front.getCurrentSize() == 8);
+   assert(front.remove(8));
+   assert(front.add(10));
+   assert(front.append(back));
+   assert(positionOf(front, 7) == 8);
+
+   // lists that obtain their Nodes differently cannot be joined
+   LinkedList heapList;
+   heapList.add(1);
+   assert(!front.append(heapList));
+   assert(!front.splice(front));
+   assert(heapList.getCurrentSize() == 1);
+   LinkedList otherHeap;
+   otherHeap.add(2);
+   assert(heapList.append(otherHeap));
+   assert(positionOf(heapList, 2) == 2);
+   assert(heapList.splice(otherHeap));
+   assert(heapList.add(0));
+   assert(positionOf(heapList, 0) == 1);
+}
+
+/**
+ * Tests the frequency reorganization mode of MTFList
+ */ 
+void testFrequencyReorganization() {
+   MTFList testList;
+   for (int i = 9; i >= 0; i--) {
+      testList.add(i);
+   }
+   FrequencyReorganization settings;
+   settings.interval = 10;
+   testList.setReorganization(settings);
+
+   // between reorganizations no Node moves: 9 stays last
+   for (int i = 0; i < 6; i++) {
+      testList.resetTraverseCount();
+      assert(testList.contains(9));
+      assert(testList.getTraverseCount() == 10);
+   }
+   assert(testList.contains(8) && testList.contains(8) && testList.contains(7));
+   assert(testList.getStatistics().promotions == 0);
+   assert(testList.getReorganizationCount() == 0);
+
+   // the tenth lookup sorts by hits: 9 (6 hits), 8 (2), 7 (1), then the rest
+   // in their old order
+   assert(!testList.contains(42));
+   assert(testList.getReorganizationCount() == 1);
+   const ReorganizationReport &report = testList.getLastReorganization();
+   assert(report.lookups == 10);
+   assert(report.costBefore == (6 * 10 + 2 * 9 + 8) / 9.0);
+   // the new order is costed with the counts it was sorted by, not the
+   // halved counts 3, 1 and 0 left after decay
+   assert(report.costAfter == (6 * 1 + 2 * 2 + 3) / 9.0);
+   assert(report.costAfter != (3 * 1 + 1 * 2) / 4.0);
+   assert(!report.drifted);
+   testList.resetTraverseCount();
+   assert(testList.contains(9));
+   assert(testList.getTraverseCount() == 1);
+   assert(testList.contains(0));
+   assert(testList.getTraverseCount() == 1 + 4);
+
+   // a sudden shift of the hot value triggers an early reorganization, once
+   // a whole interval has measured the cost of a sorted order
+   MTFList driftList;
+   for (int i = 99; i >= 0; i--) {
+      driftList.add(i);
+   }
+   settings.interval = 800;
+   settings.driftRatio = 2.0;
+   driftList.setReorganization(settings);
+   for (int i = 0; i < 1600; i++) {
+      driftList.contains(99);
+   }
+   assert(driftList.getReorganizationCount() == 2);
+   assert(driftList.getLastReorganization().costBefore == 1.0);
+   for (int i = 0; i < 99; i++) {
+      driftList.contains(50);
+   }
+   assert(driftList.getReorganizationCount() == 2);
+   driftList.contains(50);
+   assert(driftList.getReorganizationCount() == 3);
+   assert(driftList.getLastReorganization().drifted);
+
+   // a steady skewed workload costs more after a sort than the sort expected,
+   // since the sort is measured on the hits it was made from, yet it does not
+   // drift
+   MTFList steadyList;
+   for (int i = 0; i < 1000; i++) {
+      steadyList.add(i);
+   }
+   steadyList.setReorganization(settings);
+   mt19937 steadyRandom(7);
+   geometric_distribution<int> skewed(0.01);
+   for (int i = 0; i < 20000; i++) {
+      steadyList.contains(skewed(steadyRandom) % 1000);
+   }
+   assert(steadyList.getReorganizationCount() == 20000 / 800);
+
+   // an interval of 0 restores plain move-to-front
+   testList.setReorganization(FrequencyReorganization());
+   assert(testList.contains(5));
+   testList.resetTraverseCount();
+   assert(testList.contains(5));
+   assert(testList.getTraverseCount() == 1);
+}
+
+/**
+ * Tests that CompactLinkedList and CompactMTFList match LinkedList and MTFList
+ * value for value and count for count while taking 8 bytes per value
+ */ 
+void testCompactLists() {
+   CompactLinkedList compactList;
+   CompactMTFList compactMTF;
+   LinkedList referenceList;
+   MTFList referenceMTF;
+   assert(compactList.isEmpty() == true);
+   assert(compactList.getStorageBytes() == 0);
+   // an empty list is its bookkeeping and a single counter
+   assert(sizeof(CompactLinkedList) <= 48 + sizeof(ListCounter));
+   assert(sizeof(CompactMTFList) == sizeof(CompactLinkedList));
+
+   assert(compactMTF.reserve(250));
+   size_t reserved = compactMTF.getStorageBytes();
+   assert(reserved == 250 * sizeof(CompactNode));
+   for (int i = 0; i < 250; i++) {
+      assert(compactList.add(i % 200));
+      assert(compactMTF.add(i % 200));
+      referenceList.add(i % 200);
+      referenceMTF.add(i % 200);
+   }
+   assert(compactMTF.getStorageBytes() == reserved);
+
+   default_random_engine generator(9);
+   uniform_int_distribution<int> values(0, 220);
+   int largestSize = 0;
+   for (int i = 0; i < 10000; i++) {
+      int theNumber = values(generator);
+      largestSize = max(largestSize, compactMTF.getCurrentSize());
+      if (i % 10 == 0) {
+         assert(compactList.remove(theNumber) == referenceList.remove(theNumber));
+         assert(compactMTF.remove(theNumber) == referenceMTF.remove(theNumber));
+      }
+      else if (i % 10 == 1) {
+         assert(compactList.add(theNumber));
+         assert(compactMTF.add(theNumber));
+         referenceList.add(theNumber);
+         referenceMTF.add(theNumber);
+      }
+      assert(compactList.contains(theNumber) == referenceList.contains(theNumber));
+      assert(compactMTF.contains(theNumber) == referenceMTF.contains(theNumber));
+   }
+   assert(compactList.getTraverseCount() == referenceList.getTraverseCount());
+   assert(compactMTF.getTraverseCount() == referenceMTF.getTraverseCount());
+   assert(compactMTF.getStatistics().promotions ==
+          referenceMTF.getStatistics().promotions);
+   assert(compactMTF.getCurrentSize() == referenceMTF.getCurrentSize());
+
+   // removed values leave their storage for the values added next, so the
+   // storage only grows with the largest size the list has had
+   assert(compactMTF.getStorageBytes() <=
+          2 * size_t(largestSize + 1) * sizeof(CompactNode));
+
+   // the value found last is at the front
+   assert(compactMTF.add(-5));
+   assert(compactMTF.add(-6));
+   compactMTF.resetTraverseCount();
+   assert(compactMTF.contains(-5) == true);
+   assert(compactMTF.getTraverseCount() == 2);
+   assert(compactMTF.contains(-5) == true);
+   assert(compactMTF.getTraverseCount() == 3);
+
+   compactMTF.clear();
+   assert(compactMTF.isEmpty() == true);
+   assert(compactMTF.getStorageBytes() == 0);
+   assert(compactMTF.contains(5) == false);
+}
+
+/**
+ * Tests that a relayout keeps the values and their order while placing the
+ * Nodes at increasing addresses, on demand and automatically
+ */ 
+void testRelayout() {
+   MTFList testList;
+   MTFList referenceList;
+   assert(testList.relayout() == true);
+   assert(testList.getRelayoutCount() == 1);
+   assert(testList.getLastRelayout().nodes == 0);
+
+   for (int i = 0; i < 500; i++) {
+      testList.add(i);
+      referenceList.add(i);
+   }
+   default_random_engine generator(11);
+   uniform_int_distribution<int> values(0, 520);
+   for (int i = 0; i < 2000; i++) {
+      int theNumber = values(generator);
+      testList.contains(theNumber);
+      referenceList.contains(theNumber);
+   }
+
+   assert(testList.relayout() == true);
+   const RelayoutReport &report = testList.getLastRelayout();
+   assert(report.nodes == 500);
+   assert(report.nsPerLookupBefore > 0.0 && report.nsPerLookupAfter > 0.0);
+
+   // the order is unchanged: every value is found at the same position
+   for (int i = 0; i < 2000; i++) {
+      int theNumber = values(generator);
+      assert(testList.contains(theNumber) == referenceList.contains(theNumber));
+      assert(testList.getTraverseCount() == referenceList.getTraverseCount());
+   }
+
+   // a relayout is automatic after every 100 Nodes moved to the front
+   MTFList autoList;
+   autoList.setAutoRelayout(100);
+   for (int i = 0; i < 300; i++) {
+      autoList.add(i);
+   }
+   for (int i = 0; i < 100; i++) {
+      autoList.contains(299 - i);
+   }
+   assert(autoList.getRelayoutCount() == 0);
+   autoList.contains(299);
+   assert(autoList.getRelayoutCount() == 1);
+   // no lookups are timed inside contains
+   assert(autoList.getLastRelayout().nodes == 300);
+   assert(autoList.getLastRelayout().nsPerLookupBefore == 0.0);
+   assert(autoList.getLastRelayout().nsPerLookupAfter == 0.0);
+   // a value found at the front moves no Node
+   for (int i = 0; i < 200; i++) {
+      autoList.contains(299);
+   }
+   assert(autoList.getRelayoutCount() == 1);
+
+   // in the frequency reorganization mode, every reorganization relayouts
+   FrequencyReorganization settings;
+   settings.interval = 50;
+   autoList.setReorganization(settings);
+   for (int i = 0; i < 100; i++) {
+      autoList.contains(i);
+   }
+   assert(autoList.getReorganizationCount() == 2);
+   assert(autoList.getRelayoutCount() == 3);
+   assert(autoList.getCurrentSize() == 300);
+}
+
+/**
+ * Tests that a Bloom filter never hides a held value, answers most searches
+ * for absent values without a walk and survives removals, bulk changes and
+ * relayouts
+ */ 
+void testMembershipFilter() {
+   MTFList testList;
+   MTFList referenceList;
+   assert(testList.hasFilter() == false);
+   assert(testList.enableFilter() == true);
+   assert(testList.hasFilter() == true);
+   assert(testList.contains(1) == false);
+   assert(testList.getTraverseCount() == 0);
+   assert(testList.remove(1) == false);
+
+   // the filter grows with the list and shrinks back after removals
+   default_random_engine generator(13);
+   uniform_int_distribution<int> values(0, 3999);
+   for (int i = 0; i < 40000; i++) {
+      int theNumber = values(generator);
+      if (i % 3 == 0) {
+         assert(testList.add(theNumber));
+         referenceList.add(theNumber);
+      }
+      else if (i % 3 == 1 && i > 20000) {
+         assert(testList.remove(theNumber) == referenceList.remove(theNumber));
+      }
+      else {
+         assert(testList.contains(theNumber) == referenceList.contains(theNumber));
+      }
+   }
+   assert(testList.getCurrentSize() == referenceList.getCurrentSize());
+
+   // values never added are ruled out without a walk, most of the time
+   testList.resetTraverseCount();
+   for (int i = 0; i < 10000; i++) {
+      assert(testList.contains(10000 + i) == false);
+   }
+   ListStatistics stats = testList.getStatistics();
+   assert(stats.misses == 10000);
+   assert(stats.filtered + stats.filterFalsePositives == 10000);
+   assert(stats.filterFalsePositiveRate() < 0.05);
+   assert(stats.traversalsSaved == stats.filtered * testList.getCurrentSize());
+   assert(stats.traversals ==
+          stats.filterFalsePositives * testList.getCurrentSize());
+
+   // relayouts and bulk changes keep every held value visible
+   assert(testList.relayout());
+   vector<int> range = {-1, -2, -3};
+   LinkedList other(range.begin(), range.end());
+   assert(testList.append(other) == true);
+   assert(testList.contains(-3) == true);
+   assert(other.isEmpty() == true);
+   LinkedList pooled(NodeAllocation::Pooled);
+   assert(pooled.enableFilter(4));
+   assert(pooled.assign(range.begin(), range.end()));
+   assert(pooled.contains(-1) && pooled.contains(-2) && pooled.contains(-3));
+   assert(pooled.contains(-4) == false);
+
+   testList.clear();
+   assert(testList.hasFilter() == true);
+   assert(testList.contains(-3) == false);
+   assert(testList.add(7));
+   assert(testList.contains(7) == true);
+   testList.disableFilter();
+   assert(testList.hasFilter() == false);
+   assert(testList.contains(7) == true);
+}
+
+/**
+ * Tests UnrolledList and UnrolledMTFList against the orderings and traverse
+ * counts produced by LinkedList and MTFList
+ */ 
+void testUnrolledList() {
+   UnrolledList plainList;
+   UnrolledMTFList mtfList;
+   LinkedList referencePlain;
+   MTFList referenceMtf;
+
+   for (int i = 99; i >= 0; i--) {
+      assert(plainList.add(i));
+      assert(mtfList.add(i));
+      referencePlain.add(i);
+      referenceMtf.add(i);
+   }
+   assert(mtfList.getCurrentSize() == 100);
+
+   default_random_engine generator(7);
+   uniform_int_distribution<int> values(0, 120);
+   for (int i = 0; i < 2000; i++) {
+      int theNumber = values(generator);
+      assert(plainList.contains(theNumber) == referencePlain.contains(theNumber));
+      assert(mtfList.contains(theNumber) == referenceMtf.contains(theNumber));
+      assert(plainList.getTraverseCount() == referencePlain.getTraverseCount());
+      assert(mtfList.getTraverseCount() == referenceMtf.getTraverseCount());
+   }
+   assert(mtfList.getBlockTraverseCount() < mtfList.getTraverseCount());
+
+   // removal keeps the remaining order intact
+   for (int i = 0; i < 100; i += 3) {
+      assert(mtfList.remove(i) == referenceMtf.remove(i));
+   }
+   assert(mtfList.remove(500) == false);
+   assert(mtfList.getCurrentSize() == referenceMtf.getCurrentSize());
+   for (int i = 0; i < 500; i++) {
+      int theNumber = values(generator);
+      assert(mtfList.contains(theNumber) == referenceMtf.contains(theNumber));
+      assert(mtfList.getTraverseCount() == referenceMtf.getTraverseCount());
+   }
+
+   mtfList.clear();
+   assert(mtfList.isEmpty() == true);
+}
+
+/**
+ * Tests that MTFArray produces the same results and traverse counts as
+ * MTFList
+ */ 
+void testMTFArray() {
+   MTFArray testArray;
+   MTFList referenceList;
+   assert(testArray.isEmpty() == true);
+
+   for (int i = 0; i < 200; i++) {
+      assert(testArray.add(i));
+      referenceList.add(i);
+   }
+   assert(testArray.getCurrentSize() == 200);
+
+   default_random_engine generator(11);
+   uniform_int_distribution<int> values(0, 250);
+   for (int i = 0; i < 3000; i++) {
+      int theNumber = values(generator);
+      if (i % 50 == 0) {
+         assert(testArray.remove(theNumber) == referenceList.remove(theNumber));
+      }
+      assert(testArray.contains(theNumber) == referenceList.contains(theNumber));
+      assert(testArray.getTraverseCount() == referenceList.getTraverseCount());
+   }
+   assert(testArray.getCurrentSize() == referenceList.getCurrentSize());
+
+   testArray.clear();
+   assert(testArray.isEmpty() == true);
+   assert(testArray.add(5));
+   assert(testArray.contains(5));
+
+   // FIFO churn, adding at the front and removing the oldest value at the
+   // back, reuses the buffer instead of growing it with every cycle
+   MTFArray churnArray;
+   for (int i = 0; i < 100000; i++) {
+      assert(churnArray.add(i));
+      if (i >= 10) {
+         assert(churnArray.remove(i - 10));
+      }
+   }
+   assert(churnArray.getCurrentSize() == 10);
+   assert(churnArray.getCapacity() <= 32);
+   assert(churnArray.moveToFrontAt(9) == 99990);
+}
+
+/**
+ * A composite key whose hashes all collide, so that every fingerprint matches
+ */
+struct CollidingKey {
+   string name;
+   int id;
+   bool operator==(const CollidingKey &other) const {
+      return id == other.id && name == other.name;
+   }
+};
+
+namespace std {
+template <> struct hash<CollidingKey> {
+   size_t operator()(const CollidingKey &) const { return 42; }
+};
+}
+
+/**
+ * Tests SelfOrganizingList directly with non-integer keys and compile-time
+ * promotion and instrumentation choices
+ */ 
+void testSelfOrganizingList() {
+   SelfOrganizingList<long long, MoveToFront> idList;
+   const long long bigId = 1LL << 40;
+   assert(idList.add(bigId));
+   assert(idList.add(bigId + 1));
+   assert(idList.add(bigId + 2));
+
+   // move-to-front with 64-bit keys
+   assert(idList.contains(bigId));
+   assert(idList.getTraverseCount() == 3);
+   assert(idList.front()->item == bigId);
+   assert(idList.contains(5) == false);
+
+   // a per-call policy override leaves the list order untouched
+   idList.resetTraverseCount();
+   assert(idList.contains<NoPromotion>(bigId + 1));
+   assert(idList.front()->item == bigId);
+   assert(idList.getTraverseCount() == 3);
+
+   // pointer keys with instrumentation compiled out
+   int values[3] = {1, 2, 3};
+   SelfOrganizingList<const int *, MoveToFront, NullTraverseCounter> ptrList(
+      NodeAllocation::Pooled);
+   for (const int &value : values) {
+      assert(ptrList.add(&value));
+   }
+   assert(ptrList.contains(&values[0]));
+   assert(ptrList.front()->item == &values[0]);
+   assert(ptrList.getTraverseCount() == 0);
+   assert(ptrList.remove(&values[1]));
+   assert(ptrList.getCurrentSize() == 2);
+
+   // small keys are compared inline; wider keys keep a fingerprint
+   static_assert(sizeof(Node) == 16, "an integer Node must stay 16 bytes");
+   static_assert(isInlineKey<const int *> && !isInlineKey<string>,
+                 "only word-sized trivial keys are compared inline");
+
+   // string keys sharing a long prefix behave exactly like integer keys
+   const string prefix(64, 'k');
+   SelfOrganizingList<string, MoveToFront> nameList;
+   SelfOrganizingList<int, MoveToFront> numberList;
+   for (int i = 0; i < 200; i++) {
+      assert(nameList.add(prefix + to_string(i)));
+      numberList.add(i);
+   }
+   default_random_engine generator(17);
+   uniform_int_distribution<int> ids(0, 219);
+   for (int i = 0; i < 2000; i++) {
+      int id = ids(generator);
+      if (i % 50 == 0) {
+         assert(nameList.remove(prefix + to_string(id)) == numberList.remove(id));
+      }
+      assert(nameList.contains(prefix + to_string(id)) == numberList.contains(id));
+      assert(nameList.getTraverseCount() == numberList.getTraverseCount());
+   }
+   assert(nameList.front()->item == prefix + to_string(numberList.front()->item));
+   assert(nameList.relayout());
+   assert(nameList.enableFilter());
+   string front = nameList.front()->item;
+   nameList.resetTraverseCount();
+   assert(nameList.contains(front) && nameList.getTraverseCount() == 1);
+   assert(nameList.contains(prefix) == false);
+   vector<string> names = {"a", "b", "c"};
+   assert(nameList.assign(names.begin(), names.end()));
+   assert(nameList.contains("c") && nameList.front()->item == "c");
+
+   // colliding fingerprints fall back on comparing the keys in full
+   SelfOrganizingList<CollidingKey, MoveToFront> collidingList;
+   for (int i = 0; i < 10; i++) {
+      assert(collidingList.add(CollidingKey{prefix, i}));
+   }
+   collidingList.resetTraverseCount();
+   assert(collidingList.contains(CollidingKey{prefix, 0}));
+   assert(collidingList.getTraverseCount() == 10);
+   assert(collidingList.contains(CollidingKey{prefix, 10}) == false);
+   assert(collidingList.remove(CollidingKey{prefix, 5}));
+   assert(collidingList.remove(CollidingKey{"", 5}) == false);
+   assert(collidingList.getCurrentSize() == 9);
+}
+
+/**
+ * Tests the overriden contains methods of TransposeList, FrequencyCountList
+ * and MoveAheadKList classes
+ */ 
+void testSelfOrganizingHeuristics() {
+   // each list holds 1, 2, 3, 4, 5 from front to back, except frequencyList,
+   // which adds at the back and holds 5, 4, 3, 2, 1
+   TransposeList transposeList;
+   FrequencyCountList frequencyList;
+   MoveAheadKList aheadTwoList(MoveAheadK::byPositions(2));
+   MoveAheadKList aheadHalfList(MoveAheadK::byFraction(0.5));
+   IList *lists[] = {&transposeList, &frequencyList, &aheadTwoList,
+                     &aheadHalfList};
+   for (IList *list : lists) {
+      for (int i = 5; i >= 1; i--) {
+         list->add(i);
+      }
+   }
+
+   // transpose moves 5 up by one position per hit
+   assert(transposeList.contains(5));
+   transposeList.resetTraverseCount();
+   assert(transposeList.contains(5));
+   assert(transposeList.getTraverseCount() == 4);
+   transposeList.resetTraverseCount();
+   assert(transposeList.contains(1));
+   assert(transposeList.getTraverseCount() == 1);
+
+   // 4 found twice passes 3 (found once) and everything never found
+   assert(frequencyList.contains(3));
+   assert(frequencyList.contains(4));
+   assert(frequencyList.contains(4));
+   frequencyList.resetTraverseCount();
+   assert(frequencyList.contains(4));
+   assert(frequencyList.getTraverseCount() == 1);
+   frequencyList.resetTraverseCount();
+   assert(frequencyList.contains(3));
+   assert(frequencyList.getTraverseCount() == 2);
+
+   // a value added once others have hits goes behind them, so 3 found twice
+   // still stays behind 2 found 5 times, and 1 never found stays last
+   FrequencyCountList countedList;
+   countedList.add(2);
+   countedList.add(3);
+   for (int i = 0; i < 5; i++) {
+      assert(countedList.contains(2));
+   }
+   assert(countedList.contains(3));
+   assert(countedList.add(1));
+   assert(countedList.contains(3));
+   countedList.resetTraverseCount();
+   assert(countedList.contains(2));
+   assert(countedList.getTraverseCount() == 1);
+   countedList.resetTraverseCount();
+   assert(countedList.contains(1));
+   assert(countedList.getTraverseCount() == 3);
+
+   // move ahead by two positions: 5 goes from position 4 to 2, then 0
+   assert(aheadTwoList.contains(5));
+   aheadTwoList.resetTraverseCount();
+   assert(aheadTwoList.contains(5));
+   assert(aheadTwoList.getTraverseCount() == 3);
+   aheadTwoList.resetTraverseCount();
+   assert(aheadTwoList.contains(5));
+   assert(aheadTwoList.getTraverseCount() == 1);
+
+   // move ahead by half the distance: 5 goes from position 4 to 2, then 1
+   assert(aheadHalfList.contains(5));
+   aheadHalfList.resetTraverseCount();
+   assert(aheadHalfList.contains(5));
+   assert(aheadHalfList.getTraverseCount() == 3);
+   aheadHalfList.resetTraverseCount();
+   assert(aheadHalfList.contains(5));
+   assert(aheadHalfList.getTraverseCount() == 2);
+
+   // misses never reorganize and all lists keep their values
+   for (IList *list : lists) {
+      assert(list->contains(9) == false);
+      assert(list->getCurrentSize() == 5);
+      for (int i = 1; i <= 5; i++) {
+         assert(list->contains(i));
+      }
+   }
+}
+
+/**
+ * Tests that IndexedMTFList reports the same positions and traverse counts as
+ * a linear MTFList, including duplicates and removals
+ */ 
+void testIndexedMTFList() {
+   IndexedMTFList testList;
+   MTFList referenceList;
+   assert(testList.rankOf(1) == -1);
+
+   for (int i = 0; i < 300; i++) {
+      assert(testList.add(i % 250));
+      referenceList.add(i % 250);
+   }
+   assert(testList.rankOf(49) == 1);
+   assert(testList.rankOf(0) == 50);
+
+   default_random_engine generator(3);
+   uniform_int_distribution<int> values(0, 260);
+   for (int i = 0; i < 5000; i++) {
+      int theNumber = values(generator);
+      if (i % 40 == 0) {
+         assert(testList.remove(theNumber) == referenceList.remove(theNumber));
+      }
+      assert(testList.contains(theNumber) == referenceList.contains(theNumber));
+      assert(testList.getTraverseCount() == referenceList.getTraverseCount());
+   }
+   assert(testList.getCurrentSize() == referenceList.getCurrentSize());
+
+   int theNumber = values(generator);
+   referenceList.resetTraverseCount();
+   referenceList.contains(theNumber);
+   assert(testList.rankOf(theNumber) == -1 ||
+          testList.rankOf(theNumber) == referenceList.getTraverseCount());
+
+   testList.clear();
+   assert(testList.isEmpty() == true);
+   assert(testList.contains(5) == false);
+}
+
+/**
+ * Tests that SplayTreeList holds the same values as a multiset, counts the
+ * nodes compared and brings sought values to the root
+ */ 
+void testSplayTreeList() {
+   SplayTreeList testList;
+   multiset<int> reference;
+   assert(testList.isEmpty() == true);
+   assert(testList.contains(1) == false);
+   assert(testList.getTraverseCount() == 0);
+
+   // adding in order builds a path: the smallest value is at the bottom
+   for (int i = 0; i < 100; i++) {
+      assert(testList.add(i));
+   }
+   assert(testList.getHeight() == 100);
+   assert(testList.contains(0) == true);
+   assert(testList.getTraverseCount() == 100);
+   assert(testList.getHeight() < 60);
+
+   // a value just found is at the root
+   testList.resetTraverseCount();
+   assert(testList.contains(0) == true);
+   assert(testList.getTraverseCount() == 1);
+   assert(testList.getStatistics().hitPositions[0] == 1);
+   testList.clear();
+   testList.resetTraverseCount();
+   assert(testList.isEmpty() == true);
+
+   default_random_engine generator(5);
+   uniform_int_distribution<int> values(0, 300);
+   for (int i = 0; i < 20000; i++) {
+      int theNumber = values(generator);
+      switch (i % 4) {
+      case 0:
+         assert(testList.add(theNumber));
+         reference.insert(theNumber);
+         break;
+      case 1: {
+         auto found = reference.find(theNumber);
+         assert(testList.remove(theNumber) == (found != reference.end()));
+         if (found != reference.end()) {
+            reference.erase(found);
+         }
+         break;
+      }
+      default:
+         assert(testList.contains(theNumber) ==
+                (reference.count(theNumber) > 0));
+      }
+      assert(testList.getCurrentSize() == int(reference.size()));
+   }
+   ListStatistics stats = testList.getStatistics();
+   assert(stats.hits + stats.misses == 10000);
+   assert(stats.traversals >= stats.hits);
+
+   // a deep tree is freed without recursion
+   for (int i = 0; i < 200000; i++) {
+      assert(testList.add(-i));
+   }
+   testList.clear();
+   assert(testList.getCurrentSize() == 0);
+   assert(testList.getHeight() == 0);
+}
+
+/**
+ * Tests that ConcurrentMTFList matches MTFList when used by one thread and
+ * never misses a held value while other threads change the list
+ */ 
+void testConcurrentMTFList() {
+   ConcurrentMTFList testList;
+   MTFList referenceList;
+   for (int i = 0; i < 100; i++) {
+      assert(testList.add(i));
+      referenceList.add(i);
+   }
+
+   default_random_engine generator(5);
+   uniform_int_distribution<int> values(0, 110);
+   for (int i = 0; i < 1000; i++) {
+      int theNumber = values(generator);
+      if (i % 25 == 0) {
+         assert(testList.remove(theNumber) == referenceList.remove(theNumber));
+      }
+      assert(testList.contains(theNumber) == referenceList.contains(theNumber));
+      assert(testList.getTraverseCount() == referenceList.getTraverseCount());
+   }
+   assert(testList.getSkippedPromotionCount() == 0);
+   ListStatistics stats = testList.getStatistics();
+   ListStatistics expected = referenceList.getStatistics();
+   assert(stats.hits == expected.hits && stats.misses == expected.misses);
+   assert(stats.promotions == expected.promotions);
+   assert(stats.splices == expected.splices);
+   for (int b = 0; b < ListStatistics::HISTOGRAM_BUCKETS; b++) {
+      assert(stats.hitPositions[b] == expected.hitPositions[b]);
+   }
+
+   // values 1000..1049 are always held while another thread churns others
+   testList.clear();
+   assert(testList.isEmpty() == true);
+   for (int i = 1000; i < 1050; i++) {
+      testList.add(i);
+   }
+   bool missed = false;
+   thread mutator([&testList]() {
+      for (int i = 0; i < 2000; i++) {
+         testList.add(i % 10);
+         testList.remove(i % 10);
+      }
+   });
+   thread reader([&testList, &missed]() {
+      for (int i = 0; i < 20000; i++) {
+         if (!testList.contains(1000 + i % 50)) {
+            missed = true;
+         }
+      }
+   });
+   mutator.join();
+   reader.join();
+   assert(missed == false);
+   assert(testList.getCurrentSize() == 50);
+
+   // removed Nodes are reclaimed while other threads keep searching: each
+   // batch waits only for the searches running when it was removed
+   atomic<bool> stop(false);
+   atomic<int> searches(0);
+   vector<thread> readers;
+   for (int t = 0; t < 3; t++) {
+      readers.emplace_back([&testList, &stop, &searches]() {
+         while (!stop) {
+            testList.contains(1049);
+            searches++;
+         }
+      });
+   }
+   // a reader preempted mid-search holds back reclamation until it runs
+   // again, so the mutator yields now and then to let it finish
+   int reclamations = 0;
+   int lastRetired = testList.getRetiredCount();
+   for (int i = 0; i < 20000; i++) {
+      testList.add(i % 10);
+      testList.remove(i % 10);
+      int retiredNow = testList.getRetiredCount();
+      if (retiredNow < lastRetired) {
+         reclamations++;
+      }
+      lastRetired = retiredNow;
+      if (i % 64 == 0) {
+         this_thread::yield();
+      }
+   }
+   int searchesDuring = searches;
+   stop = true;
+   for (thread &worker : readers) {
+      worker.join();
+   }
+   assert(searchesDuring > 0);
+   assert(reclamations > 0);
+   // with no search running, two removals start two epochs and free all but
+   // the Node removed last
+   testList.remove(1000);
+   testList.remove(1001);
+   assert(testList.getRetiredCount() == 1);
+}
+
+/**
+ * Tests that SharedMTFList matches MTFList within one process and shares its
+ * values and ordering with forked processes and with other mappings of a
+ * named segment
+ */ 
+void testSharedMTFList() {
+   SharedMTFList testList(1000);
+   MTFList referenceList;
+   assert(testList.isAttached() == true);
+   assert(testList.getCapacity() == 1000);
+   for (int i = 0; i < 100; i++) {
+      assert(testList.add(i));
+      referenceList.add(i);
+   }
+
+   default_random_engine generator(8);
+   uniform_int_distribution<int> values(0, 110);
+   for (int i = 0; i < 1000; i++) {
+      int theNumber = values(generator);
+      if (i % 25 == 0) {
+         assert(testList.remove(theNumber) == referenceList.remove(theNumber));
+         assert(testList.add(theNumber + 200));
+         referenceList.add(theNumber + 200);
+      }
+      assert(testList.contains(theNumber) == referenceList.contains(theNumber));
+      assert(testList.getTraverseCount() == referenceList.getTraverseCount());
+   }
+   assert(testList.getCurrentSize() == referenceList.getCurrentSize());
+
+   // a forked worker's changes are seen by its parent
+   int sizeBefore = testList.getCurrentSize();
+   pid_t child = fork();
+   assert(child >= 0);
+   if (child == 0) {
+      bool ok = testList.add(5000) && testList.add(5001) &&
+                testList.contains(5000);
+      _exit(ok ? 0 : 1);
+   }
+   int status = 0;
+   waitpid(child, &status, 0);
+   assert(WIFEXITED(status) && WEXITSTATUS(status) == 0);
+   assert(testList.getCurrentSize() == sizeBefore + 2);
+   testList.resetTraverseCount();
+   assert(testList.contains(5000) == true);
+   assert(testList.getTraverseCount() == 1);
+   assert(testList.getRepairCount() == 0);
+
+   // a second mapping of a named segment sees the same list
+   string name = "/LinkedListStats-" + to_string(getpid());
+   SharedMTFList::unlink(name);
+   {
+      SharedMTFList creator(name, 4);
+      SharedMTFList opener(name, 1000);
+      assert(creator.isAttached() && opener.isAttached());
+      assert(opener.getCapacity() == 4);
+      for (int i = 0; i < 4; i++) {
+         assert(creator.add(i));
+      }
+      assert(opener.add(4) == false);
+      assert(opener.contains(0) == true);
+      creator.resetTraverseCount();
+      assert(creator.contains(0) == true);
+      assert(creator.getTraverseCount() == 1);
+      assert(opener.remove(2) == true);
+      assert(creator.getCurrentSize() == 3);
+      assert(creator.add(9) == true);
+      opener.clear();
+      assert(creator.isEmpty() == true);
+   }
+   assert(SharedMTFList::unlink(name) == true);
+   assert(SharedMTFList::unlink(name) == false);
+
+   SharedMTFList detached(0);
+   assert(detached.isAttached() == false);
+   assert(detached.add(1) == false);
+   assert(detached.contains(1) == false);
+}
+
+/**
+ * Tests that ShardedMTFList finds exactly the values held, walks far fewer
+ * Nodes than one MTFList, and keeps its values through resizes and
+ * concurrent use
+ */ 
+void testShardedMTFList() {
+   // a single shard is a plain move-to-front list
+   ShardedMTFList singleList(1);
+   MTFList referenceList;
+   for (int i = 0; i < 100; i++) {
+      assert(singleList.add(i));
+      referenceList.add(i);
+   }
+   for (int i = 0; i < 300; i++) {
+      int theNumber = (i * 37) % 110;
+      assert(singleList.contains(theNumber) == referenceList.contains(theNumber));
+   }
+   assert(singleList.getTraverseCount() == referenceList.getTraverseCount());
+
+   ShardedMTFList testList(16);
+   multiset<int> held;
+   assert(testList.getShardCount() == 16);
+   for (int i = 0; i < 1000; i++) {
+      assert(testList.add(i));
+      held.insert(i);
+   }
+   referenceList.clear();
+   for (int i = 0; i < 1000; i++) {
+      referenceList.add(i);
+   }
+   testList.resetTraverseCount();
+   referenceList.resetTraverseCount();
+   default_random_engine generator(23);
+   uniform_int_distribution<int> values(0, 1099);
+   for (int i = 0; i < 5000; i++) {
+      int theNumber = values(generator);
+      if (i % 10 == 0) {
+         bool removed = testList.remove(theNumber);
+         assert(removed == (held.count(theNumber) > 0));
+         if (removed) {
+            held.erase(held.find(theNumber));
+         }
+      }
+      assert(testList.contains(theNumber) == (held.count(theNumber) > 0));
+      referenceList.contains(theNumber);
+   }
+   assert(testList.getCurrentSize() == int(held.size()));
+   assert(testList.getTraverseCount() * 8 < referenceList.getTraverseCount());
+
+   // the shards add up to the whole list
+   int sizes = 0;
+   ListStatistics shardTotals;
+   for (int shard = 0; shard < testList.getShardCount(); shard++) {
+      sizes += testList.getShardSize(shard);
+      shardTotals += testList.getShardStatistics(shard);
+   }
+   assert(sizes == testList.getCurrentSize());
+   assert(shardTotals.traversals == testList.getTraverseCount());
+   assert(shardTotals.hits + shardTotals.misses == 5000);
+   assert(testList.getShardSize(16) == 0);
+
+   // resizing keeps every value and the counts gathered so far
+   long long traversals = testList.getTraverseCount();
+   assert(testList.resize(5));
+   assert(testList.getShardCount() == 5);
+   assert(testList.getTraverseCount() == traversals);
+   assert(testList.getCurrentSize() == int(held.size()));
+   for (int value : held) {
+      assert(testList.contains(value));
+   }
+   assert(testList.getShardStatistics(0).misses == 0);
+
+   // growth doubles the shards as values arrive
+   ShardedMTFList growingList(1);
+   growingList.setGrowth(8);
+   for (int i = 0; i < 1000; i++) {
+      assert(growingList.add(i));
+   }
+   assert(growingList.getShardCount() == 128);
+   for (int i = 0; i < 1000; i++) {
+      assert(growingList.contains(i));
+   }
+
+   // threads adding, seeking and removing their own values never disturb
+   // each other, even while the shards grow
+   growingList.clear();
+   assert(growingList.isEmpty());
+   vector<thread> workers;
+   vector<int> failures(4, 0);
+   for (int t = 0; t < 4; t++) {
+      workers.emplace_back([&growingList, &failures, t]() {
+         for (int i = 0; i < 2000; i++) {
+            int theNumber = t * 100000 + i;
+            growingList.add(theNumber);
+            if (!growingList.contains(theNumber)) {
+               failures[t]++;
+            }
+            if (i % 2 == 0 && !growingList.remove(theNumber)) {
+               failures[t]++;
+            }
+         }
+      });
+   }
+   for (thread &worker : workers) {
+      worker.join();
+   }
+   for (int t = 0; t < 4; t++) {
+      assert(failures[t] == 0);
+   }
+   assert(growingList.getCurrentSize() == 4000);
+
+   // the size always matches the shards, even with clears racing the adds
+   ShardedMTFList racedList(8);
+   thread adder([&racedList]() {
+      for (int i = 0; i < 20000; i++) {
+         racedList.add(i);
+      }
+   });
+   thread clearer([&racedList]() {
+      for (int i = 0; i < 200; i++) {
+         racedList.clear();
+      }
+   });
+   adder.join();
+   clearer.join();
+   int shardTotal = 0;
+   for (int shard = 0; shard < racedList.getShardCount(); shard++) {
+      shardTotal += racedList.getShardSize(shard);
+   }
+   assert(racedList.getCurrentSize() == shardTotal);
+}
+
+/**
+ * Tests containsBatch of LinkedList and MTFList against looking up the same
+ * values one at a time
+ */ 
+void testContainsBatch() {
+   LinkedList batchList;
+   LinkedList referenceList;
+   MTFList batchMtf;
+   MTFList referenceMtf;
+   for (int i = 0; i < 200; i++) {
+      batchList.add(i);
+      referenceList.add(i);
+      batchMtf.add(i);
+      referenceMtf.add(i);
+   }
+
+   default_random_engine generator(9);
+   uniform_int_distribution<int> values(0, 260);
+   for (int round = 0; round < 20; round++) {
+      int keys[64];
+      bool out[64];
+      for (int &key : keys) {
+         key = values(generator);
+      }
+
+      assert(batchList.containsBatch(keys, 64, out));
+      for (int i = 0; i < 64; i++) {
+         assert(out[i] == referenceList.contains(keys[i]));
+      }
+
+      assert(batchMtf.containsBatch(keys, 64, out));
+      for (int i = 0; i < 64; i++) {
+         assert(out[i] == referenceMtf.contains(keys[i]));
+      }
+   }
+
+   // a single pass never visits more Nodes than the list holds
+   assert(batchList.getTraverseCount() <= 20 * 200);
+   assert(batchList.getTraverseCount() < referenceList.getTraverseCount());
+
+   // the batch left the MTFList in the same order as sequential lookups
+   batchMtf.resetTraverseCount();
+   referenceMtf.resetTraverseCount();
+   for (int i = 0; i < 200; i++) {
+      assert(batchMtf.contains(i));
+      assert(referenceMtf.contains(i));
+      assert(batchMtf.getTraverseCount() == referenceMtf.getTraverseCount());
+   }
+
+   // an empty batch is answered without visiting any Node
+   batchMtf.resetTraverseCount();
+   assert(batchMtf.containsBatch(nullptr, 0, nullptr));
+   assert(batchMtf.getTraverseCount() == 0);
+}
+
+/**
+ * Tests the hit, miss, hit position and promotion statistics of the lists
+ */ 
+void testListStatistics() {
+   assert(ListStatistics::bucketOf(1) == 0);
+   assert(ListStatistics::bucketOf(3) == 1);
+   assert(ListStatistics::bucketOf(4) == 2);
+   assert(ListStatistics::bucketOf(LLONG_MAX) ==
+          ListStatistics::HISTOGRAM_BUCKETS - 1);
+
+   vector<unique_ptr<IList>> lists;
+   lists.emplace_back(new MTFList());
+   lists.emplace_back(new UnrolledMTFList());
+   lists.emplace_back(new MTFArray());
+   lists.emplace_back(new IndexedMTFList());
+   for (unique_ptr<IList> &theList : lists) {
+      for (int i = 9; i >= 0; i--) {
+         theList->add(i);
+      }
+      theList->resetTraverseCount();
+
+      assert(theList->contains(0));
+      assert(theList->contains(5));
+      assert(theList->contains(5));
+      assert(!theList->contains(42));
+
+      ListStatistics stats = theList->getStatistics();
+      assert(stats.traversals == theList->getTraverseCount());
+      assert(stats.traversals == 1 + 6 + 1 + 10);
+      assert(stats.hits == 3);
+      assert(stats.misses == 1);
+      // hits at positions 1, 6 and 1 fall into buckets [1,2) and [4,8)
+      assert(stats.hitPositions[0] == 2);
+      assert(stats.hitPositions[2] == 1);
+      // only the hit away from the front reorganized the list
+      assert(stats.promotions == 1);
+
+      theList->resetTraverseCount();
+      assert(theList->getStatistics().hits == 0);
+      assert(theList->getStatistics().hitPositions[0] == 0);
+   }
+
+   // a Transpose promotion is one unlink plus one insert
+   TransposeList transposeList;
+   for (int i = 3; i >= 0; i--) {
+      transposeList.add(i);
+   }
+   assert(transposeList.contains(2));
+   assert(transposeList.getStatistics().promotions == 1);
+   assert(transposeList.getStatistics().splices == 2);
+
+   // LinkedList never promotes
+   LinkedList plainList;
+   plainList.add(1);
+   assert(plainList.contains(1));
+   assert(plainList.getStatistics().promotions == 0);
+   assert(plainList.getStatistics().splices == 0);
+
+   // counts of more than 2^31 Nodes do not wrap around
+   TraverseCounter counter;
+   counter.traversed(3000000000LL);
+   counter.traversed(3000000000LL);
+   assert(counter.get() == 6000000000LL);
+}
+
+/**
+ * Tests recording operations into a trace file and replaying the trace
+ */ 
+void testAccessTrace() {
+   const char *path = "testAccessTrace.trace";
+   TraceWriter writer;
+   assert(writer.open(path));
+
+   MTFList recordedList;
+   RecordingList recorder(recordedList, writer);
+   for (int i = 99; i >= 0; i--) {
+      assert(recorder.add(i * 1000));
+   }
+   assert(recorder.remove(5000));
+   assert(!recorder.remove(5000));
+   mt19937_64 generator(3);
+   uniform_int_distribution<int> index(0, 99);
+   long long hits = 0;
+   for (int i = 0; i < 1000; i++) {
+      hits += recorder.contains(index(generator) * 1000) ? 1 : 0;
+   }
+   assert(recorder.add(INT_MIN));
+   assert(recorder.add(INT_MAX));
+   assert(recorder.contains(INT_MIN));
+   assert(writer.getRecordCount() == 100 + 2 + 1000 + 3);
+   assert(writer.close());
+
+   // replaying the trace leaves a fresh list exactly as the recorded one
+   TraceReader reader;
+   assert(reader.open(path));
+   // close keys take far fewer bytes than 4 per record
+   assert(reader.getByteCount() < 3 * 1105);
+   MTFList replayedList;
+   ReplayResult replay = replayTrace(reader, replayedList);
+   assert(replay.complete);
+   assert(replay.records == 1105);
+   assert(replay.lookups == 1001);
+   assert(replay.hits == hits + 1);
+   assert(replayedList.getCurrentSize() == recordedList.getCurrentSize());
+   assert(replayedList.getTraverseCount() == recordedList.getTraverseCount());
+
+   // replaying again from the first record produces the same counts
+   reader.rewind();
+   LinkedList plainList;
+   assert(replayTrace(reader, plainList).records == 1105);
+
+   // a trace benchmark averages over the lookups, the only operations that
+   // traverse
+   BenchmarkResult traced =
+       runTraceBenchmark(*findListEntry("MTFList"), path, reader, false);
+   assert(traced.numAccesses == 1001 && traced.hits == hits + 1);
+   assert(traced.averageTraversals ==
+          recordedList.getTraverseCount() / 1001.0);
+
+   // a truncated record is reported instead of being replayed
+   reader.close();
+   FILE *file = fopen(path, "r+b");
+   fseek(file, 0, SEEK_END);
+   fputc(0x80, file);
+   fclose(file);
+   assert(reader.open(path));
+   LinkedList truncatedList;
+   replay = replayTrace(reader, truncatedList);
+   assert(!replay.complete);
+   assert(replay.records == 1105);
+   reader.close();
+
+   // a file that is not a trace cannot be opened
+   file = fopen(path, "wb");
+   fputs("not a trace file", file);
+   fclose(file);
+   assert(!reader.open(path));
+   assert(!reader.open("noSuchDirectory/noSuchTrace.trace"));
+   remove(path);
+}
+
+/**
+ * Tests saving the learned order of a list to a snapshot and loading it into
+ * another list
+ */ 
+void testSnapshot() {
+   const char *path = "testSnapshot.snapshot";
+   MTFList learnedList;
+   for (int i = 0; i < 1000; i++) {
+      assert(learnedList.add(i));
+   }
+   assert(learnedList.add(INT_MIN));
+   assert(learnedList.add(INT_MAX));
+   default_random_engine generator(21);
+   uniform_int_distribution<int> values(0, 999);
+   for (int i = 0; i < 5000; i++) {
+      learnedList.contains(values(generator));
+   }
+   assert(learnedList.save(path));
+
+   // the loaded list seeks every value with the traversals of the saved one
+   MTFList warmList;
+   assert(warmList.add(-1));
+   assert(warmList.load(path));
+   assert(warmList.getCurrentSize() == learnedList.getCurrentSize());
+   assert(warmList.contains(-1) == false);
+   assert(warmList.contains(INT_MIN) && warmList.contains(INT_MAX));
+   assert(learnedList.contains(INT_MIN) && learnedList.contains(INT_MAX));
+   learnedList.resetTraverseCount();
+   warmList.resetTraverseCount();
+   for (int i = 0; i < 5000; i++) {
+      int theNumber = values(generator);
+      assert(warmList.contains(theNumber) == learnedList.contains(theNumber));
+   }
+   assert(warmList.getTraverseCount() == learnedList.getTraverseCount());
+
+   // hit counts come back with the order of a frequency-ordered list
+   MTFList countingList;
+   FrequencyReorganization settings;
+   settings.interval = 1000;
+   countingList.setReorganization(settings);
+   for (int i = 0; i < 100; i++) {
+      countingList.add(i);
+   }
+   for (int i = 0; i < 999; i++) {
+      countingList.contains(i % 7 == 0 ? 50 : i % 100);
+   }
+   assert(countingList.save(path));
+   MTFList restoredList;
+   assert(restoredList.load(path));
+   settings.interval = 1;
+   countingList.setReorganization(settings);
+   restoredList.setReorganization(settings);
+   countingList.contains(3);
+   restoredList.contains(3);
+   assert(countingList.getLastReorganization().costAfter > 0.0);
+   assert(restoredList.getLastReorganization().costAfter ==
+          countingList.getLastReorganization().costAfter);
+   restoredList.resetTraverseCount();
+   assert(restoredList.contains(50));
+   assert(restoredList.getTraverseCount() == 1);
+
+   // an empty list round-trips, and a failed load leaves the list alone
+   LinkedList emptyList;
+   assert(emptyList.save(path));
+   assert(restoredList.load(path));
+   assert(restoredList.isEmpty());
+   assert(restoredList.add(7));
+   FILE *file = fopen(path, "r+b");
+   fseek(file, 0, SEEK_END);
+   fputc(0, file);
+   fclose(file);
+   assert(restoredList.load(path) == false);
+   assert(restoredList.load("noSuchDirectory/noSuchList.snapshot") == false);
+   assert(restoredList.save("noSuchDirectory/noSuchList.snapshot") == false);
+   assert(restoredList.contains(7) && restoredList.getCurrentSize() == 1);
+   remove(path);
+}
+
+/**
+ * Tests the move-to-front coders over bytes and over larger alphabets
+ */ 
+void testMTFCodec() {
+   // every rank is checked against MTFArray holding the bytes 0..255
+   MTFArray reference;
+   for (int i = 255; i >= 0; i--) {
+      reference.add(i);
+   }
+
+   // runs of skewed bytes as left by a Burrows-Wheeler transform, plus every
+   // rank from 0 to 255 so that every shift length is exercised
+   mt19937_64 generator(5);
+   uniform_int_distribution<int> byteValue(0, 255);
+   uniform_int_distribution<int> runLength(1, 8);
+   vector<unsigned char> symbols;
+   while (symbols.size() < 20000) {
+      unsigned char symbol = (unsigned char)(byteValue(generator) & 0x3f);
+      symbols.insert(symbols.end(), runLength(generator), symbol);
+   }
+   for (int i = 0; i < 4096; i++) {
+      symbols.push_back((unsigned char)byteValue(generator));
+   }
+
+   vector<unsigned char> ranks(symbols.size());
+   MTFByteCodec encoder;
+   // coding in uneven chunks keeps the list between calls
+   size_t done = 0;
+   for (size_t chunk = 1; done < symbols.size(); chunk = chunk * 3 + 1) {
+      size_t n = min(chunk, symbols.size() - done);
+      encoder.encode(symbols.data() + done, n, ranks.data() + done);
+      done += n;
+   }
+   for (size_t i = 0; i < symbols.size(); i++) {
+      assert(ranks[i] == reference.moveToFront(symbols[i]));
+   }
+
+   // decoding in place restores the symbols
+   MTFByteCodec decoder;
+   vector<unsigned char> decoded = ranks;
+   decoder.decode(decoded.data(), decoded.size(), decoded.data());
+   assert(decoded == symbols);
+
+   // a reset coder starts the stream over
+   encoder.reset();
+   unsigned char again[3];
+   encoder.encode(symbols.data(), 3, again);
+   assert(equal(again, again + 3, ranks.begin()));
+   string name = MTFByteCodec::instructionSet();
+   assert(name == "avx2" || name == "sse2" || name == "scalar");
+
+   // symbols from a larger alphabet round-trip through MTFArray
+   MTFSymbolCodec symbolEncoder(1000);
+   MTFSymbolCodec symbolDecoder(1000);
+   vector<int> values = {999, 999, 0, 500, 999, 3};
+   vector<int> coded(values.size());
+   assert(symbolEncoder.encode(values.data(), values.size(), coded.data()));
+   assert((coded == vector<int>{999, 0, 1, 501, 2, 5}));
+   assert(symbolDecoder.decode(coded.data(), coded.size(), coded.data()));
+   assert(coded == values);
+   int outside = 1000;
+   assert(!symbolEncoder.encode(&outside, 1, &outside));
+   assert(!symbolDecoder.decode(&outside, 1, &outside));
+   assert(symbolEncoder.getAlphabetSize() == 1000);
+}
+
+/**
+ * Tests the bounded move-to-front cache, its loader and its eviction
+ */ 
+void testMTFCache() {
+   int loads = 0;
+   MTFCache<int, string> cache(3, [&loads](const int &key) {
+      loads++;
+      return to_string(key);
+   });
+   assert(cache.getCapacity() == 3);
+   assert(cache.getCurrentSize() == 0);
+
+   assert(cache.get(1) == "1");
+   const string *second = &cache.get(2);
+   assert(*second == "2");
+   assert(cache.get(3) == "3");
+   assert(loads == 3);
+   assert(cache.getCurrentSize() == 3);
+
+   // a hit promotes without loading: 1 becomes the most recent key
+   cache.resetCounts();
+   assert(cache.get(1) == "1");
+   assert(loads == 3);
+   assert(cache.getTraverseCount() == 3);
+
+   // 2 is now the least recent key, so loading 4 evicts it and reuses its
+   // node in place
+   assert(&cache.get(4) == second);
+   assert(*second == "4");
+   assert(!cache.isCached(2));
+   assert(cache.isCached(1) && cache.isCached(3) && cache.isCached(4));
+   assert(cache.getCurrentSize() == 3);
+
+   const CacheStatistics &stats = cache.getCacheStatistics();
+   assert(stats.hits == 1);
+   assert(stats.misses == 1);
+   assert(stats.evictions == 1);
+   assert(loads == 4);
+
+   // a loader that throws leaves the cache as it was
+   MTFCache<int, int> failing(1, [](const int &key) -> int {
+      if (key < 0) {
+         throw invalid_argument("negative key");
+      }
+      return key * 2;
+   });
+   assert(failing.get(5) == 10);
+   bool thrown = false;
+   try {
+      failing.get(-1);
+   }
+   catch (invalid_argument &exc) {
+      thrown = true;
+   }
+   assert(thrown);
+   assert(failing.isCached(5));
+   assert(failing.getCacheStatistics().evictions == 0);
+
+   // a cache of one entry evicts on every miss
+   assert(failing.get(6) == 12);
+   assert(!failing.isCached(5));
+   failing.clear();
+   assert(failing.getCurrentSize() == 0);
+   assert(failing.get(7) == 14);
+}
+
+/**
+ * Tests the access distributions and the benchmark runner used by main
+ */ 
+void testWorkloadsAndBenchmark() {
+   assert(makeAccessDistribution("triangle") == nullptr);
+   assert(makeAccessDistribution("zipf:-1") == nullptr);
+   assert(makeAccessDistribution("hotset:0.1:2") == nullptr);
+
+   const char *specs[] = {"uniform", "normal", "normal:0.1", "zipf",
+                          "zipf:1.5", "hotset", "hotset:0.05:0.99",
+                          "phase:100:0.1"};
+   for (const char *spec : specs) {
+      unique_ptr<AccessDistribution> distribution = makeAccessDistribution(spec);
+      assert(distribution != nullptr);
+      assert(distribution->getName() == spec);
+
+      // the same seed always produces the same accesses
+      mt19937_64 first(42);
+      mt19937_64 second(42);
+      vector<int> accesses = distribution->generate(50, 500, first);
+      assert(accesses == distribution->generate(50, 500, second));
+      for (int access : accesses) {
+         assert(access >= 0 && access < 50);
+      }
+   }
+
+   // a hot set of 5 values receiving every access touches only 5 values
+   mt19937_64 generator(1);
+   vector<int> hot = makeAccessDistribution("hotset:0.1:1")
+                        ->generate(50, 1000, generator);
+   vector<bool> touched(50, false);
+   int distinct = 0;
+   for (int access : hot) {
+      distinct += touched[access] ? 0 : 1;
+      touched[access] = true;
+   }
+   assert(distinct == 5);
+
+   // seeking every value once costs 1 + 2 + ... + n traversals in LinkedList
+   vector<int> everyValue = {0, 1, 2, 3};
+   BenchmarkResult result =
+      runBenchmark(*findListEntry("LinkedList"), 4, "custom", 0, everyValue);
+   assert(result.hits == 4);
+   assert(result.averageTraversals == 10 / 4.0);
+   assert(findListEntry("NoSuchList") == nullptr);
+}
+
+/**
+ * Tests that a parallel sweep gives the same counts as a serial one and that
+ * runs are summarized over their seeds with confidence intervals
+ */ 
+void testSweep() {
+   // streams depend on the size, distribution and seed, and on nothing else
+   mt19937_64 first = sweepGenerator(100, "uniform", 7);
+   mt19937_64 second = sweepGenerator(100, "uniform", 7);
+   assert(first() == second());
+   assert(sweepGenerator(100, "uniform", 8)() != second());
+   assert(sweepGenerator(100, "normal", 7)() != sweepGenerator(100, "uniform", 7)());
+
+   unique_ptr<AccessDistribution> uniform = makeAccessDistribution("uniform");
+   unique_ptr<AccessDistribution> zipf = makeAccessDistribution("zipf");
+   vector<SweepCell> cells;
+   for (uint64_t seed = 1; seed <= 4; seed++) {
+      for (const char *name : {"LinkedList", "MTFList", "SplayTreeList"}) {
+         cells.push_back(SweepCell{findListEntry(name), 200, uniform.get(), seed});
+         cells.push_back(SweepCell{findListEntry(name), 200, zipf.get(), seed});
+      }
+   }
+   vector<BenchmarkResult> serial = runSweep(cells, 2000, 1);
+   vector<BenchmarkResult> parallel = runSweep(cells, 2000, 4);
+   assert(serial.size() == cells.size());
+   for (size_t i = 0; i < cells.size(); i++) {
+      assert(parallel[i].list == cells[i].list->name);
+      assert(parallel[i].seed == cells[i].seed);
+      assert(parallel[i].hits == 2000);
+      assert(parallel[i].averageTraversals == serial[i].averageTraversals);
+   }
+
+   // 3 lists x 2 distributions, each over 4 seeds
+   vector<SweepSummary> summaries = summarizeSweep(parallel);
+   assert(summaries.size() == 6);
+   for (const SweepSummary &summary : summaries) {
+      assert(summary.runs == 4);
+      assert(summary.traversalsMargin > 0.0);
+   }
+
+   // mean 2 and standard deviation 1 over 3 runs: t(0.975, 2) / sqrt(3)
+   vector<BenchmarkResult> runs(3, parallel[0]);
+   for (int i = 0; i < 3; i++) {
+      runs[i].averageTraversals = i + 1;
+   }
+   SweepSummary summary = summarizeSweep(runs)[0];
+   assert(summary.meanTraversals == 2.0);
+   assert(summary.traversalsMargin > 2.484 && summary.traversalsMargin < 2.485);
+   assert(summarizeSweep({parallel[0]})[0].traversalsMargin < 0.0);
+}
+
+/**
+ * Tests that latency histograms keep percentiles within their bucket width
+ * and that timed lists and benchmarks record every operation
+ */ 
+void testLatency() {
+   LatencyHistogram empty;
+   assert(empty.getCount() == 0 && empty.percentile(0.99) == 0);
+
+   // 1..10000 ns: the reported percentiles exceed the exact ones by at most
+   // one bucket, 1/32 of their power of two
+   LatencyHistogram latency;
+   for (uint64_t ns = 1; ns <= 10000; ns++) {
+      latency.record(ns);
+   }
+   assert(latency.getCount() == 10000 && latency.getMax() == 10000);
+   assert(latency.getMean() == 5000.5);
+   assert(latency.percentile(0.0) == 1 && latency.percentile(1.0) == 10000);
+   for (double fraction : {0.25, 0.5, 0.9, 0.99, 0.999}) {
+      uint64_t exact = uint64_t(fraction * 10000);
+      uint64_t reported = latency.percentile(fraction);
+      assert(reported >= exact && reported <= exact + exact / 32);
+   }
+   // latencies below 32 ns are exact
+   LatencyHistogram small;
+   small.record(3);
+   small.record(7);
+   assert(small.percentile(0.5) == 3 && small.percentile(0.51) == 7);
+
+   // merged histograms count every latency of both
+   LatencyHistogram slow;
+   slow.record(1000000);
+   assert(slow.merge(latency));
+   assert(slow.getCount() == 10001 && slow.getMax() == 1000000);
+   assert(slow.percentile(0.5) == latency.percentile(0.5));
+   assert(slow.percentile(1.0) == 1000000);
+   slow.reset();
+   assert(slow.getCount() == 0 && slow.getMax() == 0);
+
+   // a timed list answers as the list it wraps and counts each operation
+   LinkedList target;
+   TimedList timed(target);
+   for (int i = 0; i < 10; i++) {
+      assert(timed.add(i));
+   }
+   assert(timed.contains(3) && !timed.contains(42));
+   assert(timed.remove(3) && !timed.remove(3));
+   assert(timed.getCurrentSize() == 9 && target.getCurrentSize() == 9);
+   assert(timed.getTraverseCount() == target.getTraverseCount());
+   assert(timed.getAddLatency().getCount() == 10);
+   assert(timed.getContainsLatency().getCount() == 2);
+   assert(timed.getRemoveLatency().getCount() == 2);
+   timed.resetLatency();
+   assert(timed.getContainsLatency().getCount() == 0);
+
+   // timed runs traverse as many nodes as untimed ones and record each value
+   // sought; only timed results add percentile columns
+   vector<int> accesses = {0, 1, 2, 3, 3, 3};
+   const ListEntry &entry = *findListEntry("MTFList");
+   BenchmarkResult plain = runBenchmark(entry, 4, "custom", 0, accesses);
+   BenchmarkResult result = runBenchmark(entry, 4, "custom", 0, accesses, true);
+   assert(!plain.timed && result.timed);
+   assert(result.averageTraversals == plain.averageTraversals);
+   assert(result.lookupLatency.getCount() == 6);
+   assert(result.updateLatency.getCount() == 4);
+   ostringstream plainCsv;
+   ostringstream timedCsv;
+   writeCsv(plainCsv, {plain});
+   writeCsv(timedCsv, {result});
+   assert(plainCsv.str().find("p99") == string::npos);
+   assert(timedCsv.str().find("lookup_p99_ns") != string::npos);
+
+   // a replayed trace path is escaped in JSON output
+   BenchmarkResult replayed = plain;
+   replayed.distribution = "traces\\\"a\"\n";
+   ostringstream json;
+   writeJson(json, {replayed});
+   string escaped = "\"distribution\": \"traces\\\\\\\"a\\\"\\u000a\"";
+   assert(json.str().find(escaped) != string::npos);
+
+   // percentiles of a sweep are taken over the latencies of every seed
+   unique_ptr<AccessDistribution> uniform = makeAccessDistribution("uniform");
+   vector<SweepCell> cells;
+   for (uint64_t seed = 1; seed <= 3; seed++) {
+      cells.push_back(SweepCell{&entry, 50, uniform.get(), seed});
+   }
+   SweepSummary summary = summarizeSweep(runSweep(cells, 100, 1, true))[0];
+   assert(summary.timed && summary.lookupLatency.getCount() == 300);
+}
+
 /**
  * A single method with all of the tests used to assess structure
  * and feature requirements of LinkedList and MTFList classes
@@ -138,89 +1861,326 @@ void runAllTests() {
    testClearNodes();
    testContainsAndTraverseCount();
    testModifiedContainsAndTraverseCount();
+   testPooledAllocation();
+   testBulkAndSplice();
+   testFrequencyReorganization();
+   testCompactLists();
+   testRelayout();
+   testMembershipFilter();
+   testUnrolledList();
+   testMTFArray();
+   testSelfOrganizingList();
+   testSelfOrganizingHeuristics();
+   testIndexedMTFList();
+   testSplayTreeList();
+   testConcurrentMTFList();
+   testSharedMTFList();
+   testShardedMTFList();
+   testContainsBatch();
+   testListStatistics();
+   testAccessTrace();
+   testSnapshot();
+   testMTFCodec();
+   testMTFCache();
+   testWorkloadsAndBenchmark();
+   testSweep();
+   testLatency();
 }
 
-int main()
+/**
+ * Prints the command-line options understood by this program
+ *
+ * @param   out      stream written to
+ * @param   program  name the program was started with
+ */
+void printUsage(ostream &out, const char *program)
 {
-   // Uncomment next line to run unit and integration tests
-   //runAllTests();
+   out << "Usage: " << program << " [options]\n"
+        << "  --sizes N[,N...]          list sizes (1000)\n"
+        << "  --accesses N              values sought per run (100000)\n"
+        << "  --seeds S[,S...]          random seeds (1)\n"
+        << "  --distributions D[,D...]  access distributions (uniform,normal):\n"
+        << "                            uniform, normal[:sd], zipf[:skew],\n"
+        << "                            hotset[:fraction[:share]],\n"
+        << "                            phase[:length[:fraction[:share]]],\n"
+        << "                            misses[:share]\n"
+        << "  --lists L[,L...]          list implementations (all):\n";
+   for (const ListEntry &entry : listCatalog())
+   {
+      out << "                            " << entry.name << "\n";
+   }
+   out << "  --replay FILE[,FILE...]   replay recorded traces instead of\n"
+        << "                            generating accesses\n"
+        << "  --threads N               worker threads running the\n"
+        << "                            combinations in parallel (1)\n"
+        << "  --format text|csv|json|summary\n"
+        << "                            output format (text); summary is\n"
+        << "                            CSV of the mean over the seeds with\n"
+        << "                            its 95% confidence interval\n"
+        << "  --latency                 record the latency of every\n"
+        << "                            operation and report its\n"
+        << "                            p50/p99/p99.9/max in nanoseconds\n"
+        << "  --test                    run unit and integration tests\n"
+        << "  --help                    print this message\n";
+}
 
-   // Alter the following declaration to change the linked list class
-   // name.
-   LinkedList theList;
-   MTFList theOtherList;
+/**
+ * Splits a comma-separated option value
+ *
+ * @param   value  the option value
+ *
+ * @return  the parts between commas
+ */
+vector<string> splitList(const string &value)
+{
+   vector<string> parts;
+   string::size_type start = 0;
+   while (true)
+   {
+      string::size_type comma = value.find(',', start);
+      parts.push_back(value.substr(start, comma - start));
+      if (comma == string::npos)
+      {
+         return parts;
+      }
+      start = comma + 1;
+   }
+}
 
-   const int numValues = 1000;
-   const int numAccesses = 100000;
+/**
+ * Parses a positive integer option value
+ *
+ * @param   text   the text to parse
+ * @param   value  set to the parsed number
+ *
+ * @return  true if text is a positive integer, false otherwise
+ */
+bool parsePositive(const string &text, long long &value)
+{
+   char *end = nullptr;
+   value = strtoll(text.c_str(), &end, 10);
+   return end != text.c_str() && *end == '\0' && value > 0;
+}
+
+int main(int argc, char *argv[])
+{
+   vector<int> sizes = {1000};
+   long long numAccesses = 100000;
+   vector<uint64_t> seeds = {1};
+   vector<string> distributionSpecs = {"uniform", "normal"};
+   vector<const ListEntry *> lists;
+   vector<string> tracePaths;
+   string format = "text";
+   int threads = 1;
+   bool timeLatency = false;
 
-   // Create a linked list of the numbers 0..numValues-1
-   for (int i = numValues - 1; i >= 0; i--)
+   for (int i = 1; i < argc; i++)
    {
-      theList.add(i);
-      theOtherList.add(i);
+      string option = argv[i];
+      string value;
+      string::size_type equals = option.find('=');
+      if (equals != string::npos)
+      {
+         value = option.substr(equals + 1);
+         option = option.substr(0, equals);
+      }
+      else if (option != "--test" && option != "--help" &&
+               option != "--latency" && i + 1 < argc)
+      {
+         value = argv[++i];
+      }
+
+      long long number = 0;
+      bool valid = true;
+      if (option == "--test")
+      {
+#ifdef NO_LIST_INSTRUMENTATION
+         // the tests check traversal counts, which are compiled out
+         cerr << "--test needs a build without NO_LIST_INSTRUMENTATION"
+              << endl;
+         return 1;
+#endif
+         runAllTests();
+         cout << "All tests passed" << endl;
+         return 0;
+      }
+      else if (option == "--help")
+      {
+         printUsage(cout, argv[0]);
+         return 0;
+      }
+      else if (option == "--sizes")
+      {
+         sizes.clear();
+         for (const string &part : splitList(value))
+         {
+            valid = valid && parsePositive(part, number) && number <= INT_MAX;
+            sizes.push_back(int(number));
+         }
+      }
+      else if (option == "--accesses")
+      {
+         valid = parsePositive(value, numAccesses) && numAccesses <= INT_MAX;
+      }
+      else if (option == "--seeds")
+      {
+         seeds.clear();
+         for (const string &part : splitList(value))
+         {
+            valid = valid && parsePositive(part, number);
+            seeds.push_back(uint64_t(number));
+         }
+      }
+      else if (option == "--distributions")
+      {
+         distributionSpecs = splitList(value);
+      }
+      else if (option == "--lists")
+      {
+         for (const string &part : splitList(value))
+         {
+            const ListEntry *entry = findListEntry(part);
+            valid = valid && entry != nullptr;
+            lists.push_back(entry);
+         }
+      }
+      else if (option == "--threads")
+      {
+         valid = parsePositive(value, number) && number <= 4096;
+         threads = int(number);
+      }
+      else if (option == "--replay")
+      {
+         tracePaths = splitList(value);
+      }
+      else if (option == "--latency")
+      {
+         timeLatency = true;
+      }
+      else if (option == "--format")
+      {
+         format = value;
+         valid = format == "text" || format == "csv" || format == "json" ||
+                 format == "summary";
+      }
+      else
+      {
+         valid = false;
+      }
+
+      if (!valid)
+      {
+         cerr << "Invalid option: " << argv[i] << endl;
+         printUsage(cerr, argv[0]);
+         return 1;
+      }
    }
 
-   // Reset the traversal counter, just in case
-   theList.resetTraverseCount();
-   theOtherList.resetTraverseCount();
-
-   // Now, access the elements randomly many times
-   int theNumber;
-   default_random_engine generator;
-   uniform_int_distribution<int> uniform(0, numValues - 1);
-   normal_distribution<double> normal(numValues / 2.0, numValues / 5.0);
-
-   // As the statistic of comparison, we use a uniform
-   // distribution. For sequential search, even a "smart" algorithm
-   // shouldn't be able to improve performance.
-   for (int i = 0; i < numAccesses; i++)
+   // timings are wall-clock, so workers taking turns on a core inflate them
+   unsigned cores = thread::hardware_concurrency();
+   if (threads > 1 && cores != 0 && unsigned(threads) > cores)
    {
-      // Access a random item by value
-      theNumber = uniform(generator);
-      assert(theList.contains(theNumber));
-      assert(theOtherList.contains(theNumber));
+      cerr << "Warning: " << threads << " threads on " << cores
+           << " cores; ns/op includes time spent waiting for a core" << endl;
    }
 
-   cout << "LinkedList - Average number of nodes traversed per access (uniform): "
-        << theList.getTraverseCount() / double(numAccesses)
-        << endl;
-
-   cout << "MTFList - Average number of nodes traversed per access (uniform): "
-        << theOtherList.getTraverseCount() / double(numAccesses)
-        << endl;
+   if (lists.empty())
+   {
+      for (const ListEntry &entry : listCatalog())
+      {
+         lists.push_back(&entry);
+      }
+   }
 
-   // Reset the traversal counter.
-   theList.resetTraverseCount();
-   theOtherList.resetTraverseCount();
-
-   // We use a normal distribution so that some values are accessed
-   // much more frequently. It will be peaked around numValues/2 and fall off
-   // rapidly above and below. Note that there is some chance of
-   // generating a number outside the legal range, so we test and get a
-   // new number if that happens (this is because a uniform
-   // distribution goes to +/- infinity). A smart algorithm could in
-   // principle take advantage of the higher frequency of access of
-   // certain items to lower the average access time. On the other hand,
-   // without any "smarts", the mean number of nodes traversed should still
-   // be the mean of the distribution, the same as for the uniform distribution.
-   for (int i = 0; i < numAccesses; i++)
+   // Recorded traces replace the generated accesses. Every list replays the
+   // same memory-mapped trace from its first record.
+   vector<BenchmarkResult> results;
+   for (const string &path : tracePaths)
    {
-      theNumber = 0;
-      do
+      TraceReader reader;
+      if (!reader.open(path))
+      {
+         cerr << "Cannot read trace: " << path << endl;
+         return 1;
+      }
+      for (const ListEntry *entry : lists)
       {
-         theNumber = int(normal(generator));
-      } while ((theNumber < 0) || (theNumber >= numValues));
+         results.push_back(runTraceBenchmark(*entry, path, reader,
+                                              timeLatency));
+         if (results.back().hits < 0)
+         {
+            cerr << "Corrupt trace: " << path << endl;
+            return 1;
+         }
+      }
+   }
+   if (!tracePaths.empty())
+   {
+      distributionSpecs.clear();
+      sizes.clear();
+   }
 
-      assert(theList.contains(theNumber));
-      assert(theOtherList.contains(theNumber));
+   // Every distribution is checked before any benchmark runs. As the
+   // statistic of comparison, a uniform distribution gives no list an
+   // advantage; the others access some values much more frequently, which
+   // a "smart" list can take advantage of.
+   vector<unique_ptr<AccessDistribution>> distributions;
+   for (const string &spec : distributionSpecs)
+   {
+      distributions.push_back(makeAccessDistribution(spec));
+      if (distributions.back() == nullptr)
+      {
+         cerr << "Unknown distribution: " << spec << endl;
+         printUsage(cerr, argv[0]);
+         return 1;
+      }
    }
 
-   cout << "LinkedList - Average number of nodes traversed per access (normal): "
-        << theList.getTraverseCount() / double(numAccesses)
-        << endl;
+   // Every list sees exactly the same sequence of values for a given size,
+   // distribution and seed, generated from a stream of its own before timing
+   // starts, so the cells can run on any number of threads.
+   vector<SweepCell> cells;
+   for (int numValues : sizes)
+   {
+      for (uint64_t seed : seeds)
+      {
+         for (const auto &distribution : distributions)
+         {
+            for (const ListEntry *entry : lists)
+            {
+               cells.push_back(SweepCell{entry, numValues, distribution.get(),
+                                         seed});
+            }
+         }
+      }
+   }
+   vector<BenchmarkResult> sweep =
+       runSweep(cells, numAccesses, threads, timeLatency);
+   for (size_t i = 0; i < sweep.size(); i++)
+   {
+      // every list of a size, distribution and seed must find the same
+      // values; the cells of the lists are next to each other
+      assert(i == 0 || cells[i].list == cells[0].list ||
+             sweep[i].hits == sweep[i - 1].hits);
+      results.push_back(sweep[i]);
+   }
 
-   cout << "MTFList - Average number of nodes traversed per access (normal): "
-        << theOtherList.getTraverseCount() / double(numAccesses)
-        << endl;
+   if (format == "csv")
+   {
+      writeCsv(cout, results);
+   }
+   else if (format == "json")
+   {
+      writeJson(cout, results);
+   }
+   else if (format == "summary")
+   {
+      writeSummaryCsv(cout, summarizeSweep(results));
+   }
+   else
+   {
+      writeText(cout, results);
+   }
 
+   return 0;
 } // end LinkedListStats
\ No newline at end of file
@@ -0,0 +1,121 @@
+/**
+ * ListCatalog.cpp
+ *
+ * Implementations for the catalog of IList implementations known to the
+ * benchmark driver. Every entry pairs the name printed in reports with a
+ * factory creating an empty list, so that every benchmark run starts from a
+ * fresh instance.
+ *
+ * Joshua Scheck
+ * 2020-10-18
+ */
+
+#include "ListCatalog.h"
+#include "CompactLinkedList.h"
+#include "ConcurrentMTFList.h"
+#include "FrequencyCountList.h"
+#include "IndexedMTFList.h"
+#include "LinkedList.h"
+#include "MTFArray.h"
+#include "MTFList.h"
+#include "MoveAheadKList.h"
+#include "ShardedMTFList.h"
+#include "SharedMTFList.h"
+#include "SplayTreeList.h"
+#include "TransposeList.h"
+#include "UnrolledList.h"
+
+/**
+ * Creates a catalog entry for a default constructible IList implementation
+ */
+template <typename List> static ListEntry entry(const std::string &name) {
+  return ListEntry{name, []() { return std::unique_ptr<IList>(new List()); }};
+}
+
+/**
+ * Retrieves every IList implementation that can be benchmarked
+ *
+ * @return  the entries, in the order they are reported
+ */
+const std::vector<ListEntry> &listCatalog() {
+  static const std::vector<ListEntry> catalog = {
+      entry<LinkedList>("LinkedList"),
+      ListEntry{"LinkedList(filter)",
+                []() {
+                  LinkedList *theList = new LinkedList();
+                  theList->enableFilter();
+                  return std::unique_ptr<IList>(theList);
+                }},
+      entry<MTFList>("MTFList"),
+      ListEntry{"MTFList(filter)",
+                []() {
+                  MTFList *theList = new MTFList();
+                  theList->enableFilter();
+                  return std::unique_ptr<IList>(theList);
+                }},
+      ListEntry{"MTFList(pooled)",
+                []() {
+                  return std::unique_ptr<IList>(
+                      new MTFList(NodeAllocation::Pooled));
+                }},
+      ListEntry{"MTFList(reorg=1000)",
+                []() {
+                  MTFList *theList = new MTFList();
+                  FrequencyReorganization settings;
+                  settings.interval = 1000;
+                  settings.driftRatio = 1.5;
+                  theList->setReorganization(settings);
+                  return std::unique_ptr<IList>(theList);
+                }},
+      ListEntry{"MTFList(relayout=10000)",
+                []() {
+                  MTFList *theList = new MTFList();
+                  theList->setAutoRelayout(10000);
+                  return std::unique_ptr<IList>(theList);
+                }},
+      entry<CompactLinkedList>("CompactLinkedList"),
+      entry<CompactMTFList>("CompactMTFList"),
+      entry<UnrolledList>("UnrolledList"),
+      entry<UnrolledMTFList>("UnrolledMTFList"),
+      entry<MTFArray>("MTFArray"),
+      entry<IndexedMTFList>("IndexedMTFList"),
+      entry<ConcurrentMTFList>("ConcurrentMTFList"),
+      entry<SharedMTFList>("SharedMTFList"),
+      entry<ShardedMTFList>("ShardedMTFList(shards=16)"),
+      ListEntry{"ShardedMTFList(grow=64)",
+                []() {
+                  ShardedMTFList *theList = new ShardedMTFList(1);
+                  theList->setGrowth(64);
+                  return std::unique_ptr<IList>(theList);
+                }},
+      entry<SplayTreeList>("SplayTreeList"),
+      entry<TransposeList>("TransposeList"),
+      entry<FrequencyCountList>("FrequencyCountList"),
+      ListEntry{"MoveAheadKList(k=4)",
+                []() {
+                  return std::unique_ptr<IList>(
+                      new MoveAheadKList(MoveAheadK::byPositions(4)));
+                }},
+      ListEntry{"MoveAheadKList(1/2)",
+                []() {
+                  return std::unique_ptr<IList>(
+                      new MoveAheadKList(MoveAheadK::byFraction(0.5)));
+                }}};
+  return catalog;
+}
+
+/**
+ * Finds an IList implementation by name
+ *
+ * @param   name  name of the implementation, as printed in reports
+ *
+ * @return  the entry, or nullptr if no implementation has that name
+ */
+const ListEntry *findListEntry(const std::string &name) {
+  for (const ListEntry &candidate : listCatalog()) {
+    if (candidate.name == name) {
+      return &candidate;
+    }
+  }
+  return nullptr;
+} // end ListCatalog.cpp
@@ -0,0 +1,44 @@
+/**
+ * ListCatalog.h
+ *
+ * Declarations for the catalog of IList implementations known to the
+ * benchmark driver. Every entry pairs the name printed in reports with a
+ * factory creating an empty list, so that every benchmark run starts from a
+ * fresh instance.
+ *
+ * Joshua Scheck
+ * 2020-10-18
+ */
+
+#pragma once
+#include "IList.h"
+#include <functional>
+#include <memory>
+#include <string>
+#include <vector>
+
+/**
+ * Names an IList implementation and knows how to create it
+ */
+struct ListEntry {
+  /** Name of the implementation as printed in reports */
+  std::string name;
+  /** Creates an empty instance of the implementation */
+  std::function<std::unique_ptr<IList>()> create;
+};
+
+/**
+ * Retrieves every IList implementation that can be benchmarked
+ *
+ * @return  the entries, in the order they are reported
+ */
+const std::vector<ListEntry> &listCatalog();
+
+/**
+ * Finds an IList implementation by name
+ *
+ * @param   name  name of the implementation, as printed in reports
+ *
+ * @return  the entry, or nullptr if no implementation has that name
+ */
+const ListEntry *findListEntry(const std::string &name);
@@ -0,0 +1,264 @@
+/**
+ * MTFArray.cpp
+ *
+ * Implementations for the MTFArray class, a "move-to-front" list that stores
+ * its integer values in one contiguous buffer instead of Nodes. Searching is a
+ * vectorized linear scan and a found value is moved to the front with a single
+ * memmove of the values before it. MTFArray produces the same orderings and
+ * traverse counts as MTFList while reading memory sequentially.
+ *
+ * Joshua Scheck
+ * 2020-10-18
+ */
+
+#include "MTFArray.h"
+#include "SimdSearch.h"
+#include <cstring>
+#include <new>
+
+/** Number of integers in the first buffer allocated by an MTFArray */
+static const int INITIAL_CAPACITY = 16;
+
+/**
+ * Constructor for this MTFArray class. Initializes an empty MTFArray that owns
+ * no buffer yet.
+ */
+MTFArray::MTFArray()
+    : buffer(nullptr), capacity(0), begin(0), currentSize(0) {}
+
+/**
+ * Destructor for this MTFArray class that frees the buffer allocated by the
+ * object.
+ */
+MTFArray::~MTFArray() { delete[] buffer; }
+
+/**
+ * Retrieves the current number of values in this MTFArray
+ *
+ * @post    state of this MTFArray does not change
+ *
+ * @return  the number of values in this MTFArray
+ */
+int MTFArray::getCurrentSize() const { return currentSize; }
+
+/**
+ * Determines if the number of values in this MTFArray is zero
+ *
+ * @post    state of this MTFArray does not change
+ *
+ * @return  true if this MTFArray holds no values, false otherwise
+ */
+bool MTFArray::isEmpty() const { return currentSize == 0; }
+
+/**
+ * Adds the specified value to the beginning of this MTFArray. Duplicate integer
+ * values are allowed. Free room is kept before the first value, so adding is
+ * amortized constant time.
+ *
+ * @param   newEntry integer value to be added to the beginning of this
+ *                   MTFArray
+ *
+ * @post             if successful, the size of this MTFArray increases by 1
+ * and newEntry is the first value. No change in class state if unsuccessful.
+ *
+ * @return           true if the value is successfully added, false if a larger
+ *                   buffer could not be allocated
+ */
+bool MTFArray::add(int newEntry) {
+  if (begin == 0 && currentSize > 0 && currentSize <= capacity / 2) {
+    // removals from the back leave their room there, so the values are moved
+    // back to the end of the buffer instead of growing it; at least half of
+    // the buffer is then free in front of the first value, which keeps adds
+    // amortized O(1) and the capacity bounded by twice the largest size
+    std::memmove(buffer + capacity - currentSize, buffer,
+                 currentSize * sizeof(int));
+    begin = capacity - currentSize;
+  } else if (begin == 0) {
+    int newCapacity = capacity == 0 ? INITIAL_CAPACITY : capacity * 2;
+    int *newBuffer = nullptr;
+    try {
+      newBuffer = new int[newCapacity];
+    }
+    // inability to allocate memory will throw a std::bad_alloc error
+    // which will be caught and signals a lack of success
+    catch (std::bad_alloc &exc) {
+      return false;
+    }
+
+    // values are placed at the end of the new buffer so that all of the
+    // free room is in front of the first value
+    int newBegin = newCapacity - currentSize;
+    if (currentSize > 0) {
+      std::memcpy(newBuffer + newBegin, buffer + begin,
+                  currentSize * sizeof(int));
+    }
+    delete[] buffer;
+    buffer = newBuffer;
+    capacity = newCapacity;
+    begin = newBegin;
+  }
+
+  begin--;
+  buffer[begin] = newEntry;
+  currentSize++;
+  return true;
+}
+
+/**
+ * Removes the first occurrence of the specified integer from this MTFArray
+ *
+ * @param   anEntry  the sought integer value to be removed
+ *
+ * @post             if successful, the size of this MTFArray decreases by 1
+ * and the remaining values keep their order. No change in class state if
+ * unsuccessful.
+ *
+ * @return           true if the value is found and removed, false otherwise
+ */
+bool MTFArray::remove(int anEntry) {
+  int *items = buffer + begin;
+  int index = findFirstInt(items, currentSize, anEntry);
+  if (index < 0) {
+    return false;
+  }
+
+  // close the gap by moving whichever side of it holds fewer values
+  if (index < currentSize - index - 1) {
+    std::memmove(items + 1, items, index * sizeof(int));
+    begin++;
+  } else {
+    std::memmove(items + index, items + index + 1,
+                 (currentSize - index - 1) * sizeof(int));
+  }
+
+  currentSize--;
+  return true;
+}
+
+/**
+ * Removes all entries from this MTFArray. The buffer is kept for reuse.
+ *
+ * @post    this MTFArray is empty and class member currentSize is 0
+ */
+void MTFArray::clear() {
+  begin = capacity;
+  currentSize = 0;
+}
+
+/**
+ * Determines if the specified integer value is held in this MTFArray, then
+ * moves it to the front by shifting the values before it back by one
+ *
+ * @param   anEntry  the sought integer value
+ *
+ * @post             the traversal count is incremented by 1 for each
+ * value examined in the search for the first occurrence of the value (even if
+ * not found), exactly as MTFList counts Nodes. If found, the value is the first
+ * value of this MTFArray.
+ *
+ * @return           true if the specified integer value is contained in this
+ *                   MTFArray, false otherwise
+ */
+bool MTFArray::contains(int anEntry) { return moveToFront(anEntry) >= 0; }
+
+/**
+ * Finds the rank of the specified integer value, then moves it to the front as
+ * contains(int anEntry) does. This is the encoding step of a move-to-front
+ * coder.
+ *
+ * @param   anEntry  the sought integer value
+ *
+ * @post             the same as for contains(int anEntry)
+ *
+ * @return           the 0-based position the value held before it was moved,
+ *                   or -1 if it is not contained in this MTFArray
+ */
+int MTFArray::moveToFront(int anEntry) {
+  int *items = buffer + begin;
+  int index = findFirstInt(items, currentSize, anEntry);
+
+  if (index < 0) {
+    counter.traversed(currentSize);
+    counter.miss();
+    return -1;
+  }
+
+  counter.traversed(index + 1);
+  counter.hit(index + 1);
+
+  // only shift values if the found value is not at the front already
+  if (index > 0) {
+    std::memmove(items + 1, items, index * sizeof(int));
+    items[0] = anEntry;
+    counter.promoted();
+  }
+
+  return index;
+}
+
+/**
+ * Retrieves the number of nodes traversed since the last time the count was
+ * reset in this MTFArray.
+ *
+ * @post    state of this MTFArray does not change
+ *
+ * @return  the number of values traversed
+ */
+long long MTFArray::getTraverseCount() const { return counter.get(); }
+
+/**
+ * Retrieves everything recorded about this MTFArray since the last reset
+ *
+ * @post    state of this MTFArray does not change
+ *
+ * @return  traversals, hits, misses, the histogram of hit positions,
+ *          promotions and splices, all 0 if instrumentation is compiled out
+ */
+ListStatistics MTFArray::getStatistics() const {
+  return counter.statistics();
+}
+
+/**
+ * Resets the count of values traversed in this MTFArray
+ *
+ * @post sets the traversal count and all other statistics to 0
+ */
+void MTFArray::resetTraverseCount() { counter.reset(); }
+
+/**
+ * Moves the value at a position to the front, shifting the values before it
+ * back by one. This is the decoding step of a move-to-front coder.
+ *
+ * @param   rank  0-based position of the value
+ *
+ * @pre     rank must be in 0..getCurrentSize()-1
+ *
+ * @post    the traversal count is incremented by rank + 1, as if the value had
+ *          been sought; the value is the first value of this MTFArray
+ *
+ * @return  the value that was at the position
+ */
+int MTFArray::moveToFrontAt(int rank) {
+  int *items = buffer + begin;
+  int value = items[rank];
+
+  counter.traversed(rank + 1);
+  counter.hit(rank + 1);
+
+  if (rank > 0) {
+    std::memmove(items + 1, items, rank * sizeof(int));
+    items[0] = value;
+    counter.promoted();
+  }
+
+  return value;
+}
+
+/**
+ * Retrieves the number of integers the buffer of this MTFArray can hold
+ *
+ * @post    state of this MTFArray does not change
+ *
+ * @return  the capacity, 0 before the first value is added
+ */
+int MTFArray::getCapacity() const { return capacity; } // end MTFArray.cpp
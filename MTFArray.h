@@ -0,0 +1,186 @@
+/**
+ * MTFArray.h
+ *
+ * Declarations for the MTFArray class, a "move-to-front" list that stores its
+ * integer values in one contiguous buffer instead of Nodes. Searching is a
+ * vectorized linear scan and a found value is moved to the front with a single
+ * memmove of the values before it. MTFArray produces the same orderings and
+ * traverse counts as MTFList while reading memory sequentially.
+ *
+ * Joshua Scheck
+ * 2020-10-18
+ */
+
+#pragma once
+#include "IList.h"
+
+/**
+ * Represents a move-to-front list backed by a contiguous array that is the
+ * subclass of IList
+ */
+class MTFArray : public IList {
+public:
+  /**
+   * Constructor for this MTFArray class. Initializes an empty MTFArray that
+   * owns no buffer yet.
+   */
+  MTFArray();
+
+  /**
+   * Destructor for this MTFArray class that frees the buffer allocated by the
+   * object.
+   */
+  ~MTFArray() override;
+
+  MTFArray(const MTFArray &) = delete;
+  MTFArray &operator=(const MTFArray &) = delete;
+
+  /**
+   * Retrieves the current number of values in this MTFArray
+   *
+   * @post    state of this MTFArray does not change
+   *
+   * @return  the number of values in this MTFArray
+   */
+  int getCurrentSize() const override;
+
+  /**
+   * Determines if the number of values in this MTFArray is zero
+   *
+   * @post    state of this MTFArray does not change
+   *
+   * @return  true if this MTFArray holds no values, false otherwise
+   */
+  bool isEmpty() const override;
+
+  /**
+   * Adds the specified value to the beginning of this MTFArray. Duplicate
+   * integer values are allowed. Free room is kept before the first value, so
+   * adding is amortized constant time.
+   *
+   * @param   newEntry integer value to be added to the beginning of this
+   *                   MTFArray
+   *
+   * @post             if successful, the size of this MTFArray increases by 1
+   * and newEntry is the first value. No change in class state if
+   * unsuccessful.
+   *
+   * @return           true if the value is successfully added, false if a
+   *                   larger buffer could not be allocated
+   */
+  bool add(int newEntry) override;
+
+  /**
+   * Removes the first occurrence of the specified integer from this MTFArray
+   *
+   * @param   anEntry  the sought integer value to be removed
+   *
+   * @post             if successful, the size of this MTFArray decreases by 1
+   * and the remaining values keep their order. No change in class state if
+   * unsuccessful.
+   *
+   * @return           true if the value is found and removed, false otherwise
+   */
+  bool remove(int anEntry) override;
+
+  /**
+   * Removes all entries from this MTFArray. The buffer is kept for reuse.
+   *
+   * @post    this MTFArray is empty and class member currentSize is 0
+   */
+  void clear() override;
+
+  /**
+   * Determines if the specified integer value is held in this MTFArray, then
+   * moves it to the front by shifting the values before it back by one
+   *
+   * @param   anEntry  the sought integer value
+   *
+   * @post             the traversal count is incremented by 1 for each
+   * value examined in the search for the first occurrence of the value (even
+   * if not found), exactly as MTFList counts Nodes. If found, the value is the
+   * first value of this MTFArray.
+   *
+   * @return           true if the specified integer value is contained in
+   *                   this MTFArray, false otherwise
+   */
+  bool contains(int anEntry) override;
+
+  /**
+   * Retrieves the number of nodes traversed since the last time the count was
+   * reset in this MTFArray.
+   *
+   * @post    state of this MTFArray does not change
+   *
+   * @return  the number of values traversed
+   */
+  long long getTraverseCount() const override;
+
+  /**
+   * Retrieves everything recorded about this MTFArray since the last reset
+   *
+   * @post    state of this MTFArray does not change
+   *
+   * @return  traversals, hits, misses, the histogram of hit positions,
+   *          promotions and splices, all 0 if instrumentation is compiled out
+   */
+  ListStatistics getStatistics() const override;
+
+  /**
+   * Resets the count of values traversed in this MTFArray
+   *
+   * @post sets the traversal count and all other statistics to 0
+   */
+  void resetTraverseCount() override;
+
+  /**
+   * Finds the rank of the specified integer value, then moves it to the
+   * front as contains(int anEntry) does. This is the encoding step of a
+   * move-to-front coder.
+   *
+   * @param   anEntry  the sought integer value
+   *
+   * @post             the same as for contains(int anEntry)
+   *
+   * @return           the 0-based position the value held before it was
+   *                   moved, or -1 if it is not contained in this MTFArray
+   */
+  int moveToFront(int anEntry);
+
+  /**
+   * Moves the value at a position to the front, shifting the values before it
+   * back by one. This is the decoding step of a move-to-front coder.
+   *
+   * @param   rank  0-based position of the value
+   *
+   * @pre     rank must be in 0..getCurrentSize()-1
+   *
+   * @post    the traversal count is incremented by rank + 1, as if the value
+   *          had been sought; the value is the first value of this MTFArray
+   *
+   * @return  the value that was at the position
+   */
+  int moveToFrontAt(int rank);
+
+  /**
+   * Retrieves the number of integers the buffer of this MTFArray can hold
+   *
+   * @post    state of this MTFArray does not change
+   *
+   * @return  the capacity, 0 before the first value is added
+   */
+  int getCapacity() const;
+
+private:
+  /** Contiguous storage; values occupy buffer[begin, begin + currentSize). */
+  int *buffer;
+  /** Number of integers the buffer can hold. */
+  int capacity;
+  /** Position of the first value of this MTFArray in buffer. */
+  int begin;
+  /** The current number of values in this MTFArray. */
+  int currentSize;
+  /** Instrumentation of this MTFArray; a no-op when built with
+   * NO_LIST_INSTRUMENTATION. */
+  ListCounter counter;
+}; // end MTFArray.h
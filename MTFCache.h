@@ -0,0 +1,226 @@
+/**
+ * MTFCache.h
+ *
+ * Declaration and implementation of the MTFCache class template, a
+ * move-to-front list of key-value pairs used as a recency cache of bounded
+ * capacity. A hit moves its entry to the front; a miss asks a loader for the
+ * value and inserts it at the front, evicting the entry at the back once the
+ * cache is full. Every node is allocated when the cache is created, and an
+ * evicted node is reused in place, so a full cache allocates nothing.
+ *
+ * Joshua Scheck
+ * 2020-10-18
+ */
+
+#pragma once
+#include <cstddef>
+#include <functional>
+#include <utility>
+#include <vector>
+
+#include "TraverseCounters.h"
+
+/**
+ * What an MTFCache has answered since the counts were last reset. These
+ * counts are kept even when instrumentation is compiled out, since they are
+ * what a cache is sized by.
+ */
+struct CacheStatistics {
+  /** Lookups answered from the cache */
+  long long hits = 0;
+  /** Lookups answered by the loader */
+  long long misses = 0;
+  /** Entries evicted to make room for a loaded entry */
+  long long evictions = 0;
+};
+
+/**
+ * Represents a recency cache of bounded capacity kept in move-to-front order
+ *
+ * @tparam  Key      type of the keys; must be copy constructible, copy
+ *                   assignable and equality comparable
+ * @tparam  Value    type of the cached values; must be move constructible and
+ *                   move assignable
+ * @tparam  Counter  instrumentation of traversals, such as TraverseCounter or
+ *                   NullTraverseCounter
+ */
+template <typename Key, typename Value, typename Counter = ListCounter>
+class MTFCache {
+public:
+  /** Produces the value of a key that is not cached */
+  typedef std::function<Value(const Key &)> Loader;
+
+  /**
+   * Constructor for this MTFCache class. Allocates every node the cache will
+   * ever use.
+   *
+   * @param   capacity  the greatest number of entries held at once
+   * @param   loader    called with the key of every miss
+   *
+   * @pre     capacity must be greater than 0
+   *
+   * @throw   std::bad_alloc if memory for the nodes could not be allocated
+   */
+  MTFCache(int capacity, Loader loader)
+      : capacity(capacity), loader(std::move(loader)), head(nullptr) {
+    nodes.reserve(std::size_t(capacity));
+  }
+
+  MTFCache(const MTFCache &) = delete;
+  MTFCache &operator=(const MTFCache &) = delete;
+
+  /**
+   * Retrieves the value of a key, loading it on a miss
+   *
+   * @param   key  the sought key
+   *
+   * @post    the entry of the key is the first entry of this MTFCache. On a
+   *          miss in a full cache, the last entry has been evicted. If the
+   *          loader throws, this MTFCache is unchanged.
+   *
+   * @return  the value, valid until the next call that loads
+   */
+  const Value &get(const Key &key) {
+    CacheNode *prevNode = nullptr;
+    CacheNode *prevPrevNode = nullptr;
+    long long position = 0;
+
+    for (CacheNode *currNode = head; currNode != nullptr;
+         prevPrevNode = prevNode, prevNode = currNode,
+                   currNode = currNode->next) {
+      position++;
+      if (currNode->key == key) {
+        counter.traversed(position);
+        counter.hit(position);
+        stats.hits++;
+        if (prevNode != nullptr) {
+          prevNode->next = currNode->next;
+          currNode->next = head;
+          head = currNode;
+          counter.promoted();
+        }
+        return currNode->value;
+      }
+    }
+
+    // the search visited every node, so prevNode is the last node and
+    // prevPrevNode the one before it
+    counter.traversed(position);
+    counter.miss();
+    stats.misses++;
+    Value value = loader(key);
+
+    CacheNode *node = nullptr;
+    // reserve may have made room for more nodes than the capacity allows
+    if (nodes.size() < std::size_t(capacity)) {
+      nodes.push_back(CacheNode{key, std::move(value), nullptr});
+      node = &nodes.back();
+    } else {
+      node = prevNode;
+      if (prevPrevNode == nullptr) {
+        head = nullptr;
+      } else {
+        prevPrevNode->next = nullptr;
+      }
+      node->key = key;
+      node->value = std::move(value);
+      stats.evictions++;
+    }
+
+    node->next = head;
+    head = node;
+    return node->value;
+  }
+
+  /**
+   * Determines if a key is cached, without loading it or reordering
+   *
+   * @param   key  the sought key
+   *
+   * @return  true if the key is cached, false otherwise
+   */
+  bool isCached(const Key &key) const {
+    for (const CacheNode *currNode = head; currNode != nullptr;
+         currNode = currNode->next) {
+      if (currNode->key == key) {
+        return true;
+      }
+    }
+    return false;
+  }
+
+  /**
+   * Forgets every entry. The nodes stay allocated for reuse.
+   */
+  void clear() {
+    nodes.clear();
+    head = nullptr;
+  }
+
+  /**
+   * Retrieves the current number of entries
+   *
+   * @return  the number of entries, at most getCapacity()
+   */
+  int getCurrentSize() const { return int(nodes.size()); }
+
+  /**
+   * Retrieves the greatest number of entries held at once
+   *
+   * @return  the capacity
+   */
+  int getCapacity() const { return capacity; }
+
+  /**
+   * Retrieves the hits, misses and evictions since the last reset
+   *
+   * @return  the counts
+   */
+  const CacheStatistics &getCacheStatistics() const { return stats; }
+
+  /**
+   * Retrieves the number of nodes traversed since the last reset
+   *
+   * @return  the count kept by the counter, always 0 for NullTraverseCounter
+   */
+  long long getTraverseCount() const { return counter.get(); }
+
+  /**
+   * Retrieves everything recorded by the counter since the last reset
+   *
+   * @return  the statistics, all 0 for NullTraverseCounter
+   */
+  const ListStatistics &getStatistics() const { return counter.statistics(); }
+
+  /**
+   * Resets the hit, miss, eviction and traversal counts to 0
+   */
+  void resetCounts() {
+    stats = CacheStatistics();
+    counter.reset();
+  }
+
+private:
+  /** A cached entry */
+  struct CacheNode {
+    /** The key of the entry */
+    Key key;
+    /** The value of the key */
+    Value value;
+    /** Reference to the next node, otherwise nullptr */
+    CacheNode *next;
+  };
+
+  /** The greatest number of entries held at once. */
+  int capacity;
+  /** Called with the key of every miss. */
+  Loader loader;
+  /** Storage of every node; reserved up front so that nodes never move. */
+  std::vector<CacheNode> nodes;
+  /** Reference to the first node, otherwise nullptr. */
+  CacheNode *head;
+  /** Hits, misses and evictions since the last reset. */
+  CacheStatistics stats;
+  /** Instrumentation told about every node traversed by get. */
+  Counter counter;
+}; // end MTFCache.h
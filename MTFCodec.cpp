@@ -0,0 +1,396 @@
+/**
+ * MTFCodec.cpp
+ *
+ * Implementations for move-to-front coders. The byte coder searches its
+ * 256-byte list a vector at a time and shifts the values before a found byte
+ * back by one in registers, a vector at a time, instead of byte by byte. The
+ * widest instruction set supported by the running processor is selected once
+ * at runtime, as for findFirstInt().
+ *
+ * Joshua Scheck
+ * 2020-10-18
+ */
+
+#include "MTFCodec.h"
+#include <cstring>
+
+#if (defined(__x86_64__) || defined(__i386__)) &&                             \
+    (defined(__GNUC__) || defined(__clang__))
+#define MTF_CODEC_X86 1
+#include <immintrin.h>
+#endif
+
+namespace {
+
+/** Signature shared by every implementation of encoding and decoding */
+typedef void (*CodeChunkFn)(unsigned char *, const unsigned char *,
+                            std::size_t, unsigned char *);
+
+/**
+ * Portable implementation of encoding
+ */
+void encodeScalar(unsigned char *table, const unsigned char *in, std::size_t n,
+                  unsigned char *out) {
+  for (std::size_t i = 0; i < n; i++) {
+    unsigned char symbol = in[i];
+    const void *found = std::memchr(table, symbol, 256);
+    int rank = int(static_cast<const unsigned char *>(found) - table);
+    std::memmove(table + 1, table, rank);
+    table[0] = symbol;
+    out[i] = (unsigned char)rank;
+  }
+}
+
+/**
+ * Portable implementation of decoding
+ */
+void decodeScalar(unsigned char *table, const unsigned char *in, std::size_t n,
+                  unsigned char *out) {
+  for (std::size_t i = 0; i < n; i++) {
+    int rank = in[i];
+    unsigned char symbol = table[rank];
+    std::memmove(table + 1, table, rank);
+    table[0] = symbol;
+    out[i] = symbol;
+  }
+}
+
+#ifdef MTF_CODEC_X86
+/**
+ * Finds a byte 16 positions per instruction using SSE2
+ *
+ * @pre     table must hold every byte value
+ */
+__attribute__((target("sse2"))) inline int findSse2(const unsigned char *table,
+                                                    unsigned char symbol) {
+  const __m128i needle = _mm_set1_epi8(char(symbol));
+  for (int i = 0;; i += 16) {
+    __m128i block =
+        _mm_loadu_si128(reinterpret_cast<const __m128i *>(table + i));
+    int mask = _mm_movemask_epi8(_mm_cmpeq_epi8(block, needle));
+    if (mask != 0) {
+      return i + __builtin_ctz(mask);
+    }
+  }
+}
+
+/**
+ * Moves table[rank], which is symbol, to the front 16 positions per
+ * instruction using SSE2. Every block up to the one holding rank is shifted
+ * by one byte, taking its first byte from the last byte of the block before.
+ */
+__attribute__((target("sse2"))) inline void
+shiftSse2(unsigned char *table, int rank, unsigned char symbol) {
+  const __m128i lanes = _mm_setr_epi8(0, 1, 2, 3, 4, 5, 6, 7, 8, 9, 10, 11, 12,
+                                      13, 14, 15);
+  // the byte shifted into the first block is the found symbol itself
+  __m128i prev = _mm_set1_epi8(char(symbol));
+  int last = rank & ~15;
+
+  for (int i = 0; i <= last; i += 16) {
+    __m128i *address = reinterpret_cast<__m128i *>(table + i);
+    __m128i curr = _mm_loadu_si128(address);
+    __m128i shifted =
+        _mm_or_si128(_mm_slli_si128(curr, 1), _mm_srli_si128(prev, 15));
+    if (i == last) {
+      // only positions up to rank move; the rest of the block stays
+      __m128i moved =
+          _mm_cmplt_epi8(lanes, _mm_set1_epi8(char(rank - i + 1)));
+      shifted = _mm_or_si128(_mm_and_si128(moved, shifted),
+                             _mm_andnot_si128(moved, curr));
+    }
+    _mm_storeu_si128(address, shifted);
+    prev = curr;
+  }
+}
+
+/**
+ * Encodes with SSE2
+ */
+__attribute__((target("sse2"))) void encodeSse2(unsigned char *table,
+                                                const unsigned char *in,
+                                                std::size_t n,
+                                                unsigned char *out) {
+  for (std::size_t i = 0; i < n; i++) {
+    unsigned char symbol = in[i];
+    // repeated symbols, the most frequent case after a Burrows-Wheeler
+    // transform, need neither a search nor a shift
+    if (table[0] == symbol) {
+      out[i] = 0;
+      continue;
+    }
+    int rank = findSse2(table, symbol);
+    shiftSse2(table, rank, symbol);
+    out[i] = (unsigned char)rank;
+  }
+}
+
+/**
+ * Decodes with SSE2
+ */
+__attribute__((target("sse2"))) void decodeSse2(unsigned char *table,
+                                                const unsigned char *in,
+                                                std::size_t n,
+                                                unsigned char *out) {
+  for (std::size_t i = 0; i < n; i++) {
+    int rank = in[i];
+    unsigned char symbol = table[rank];
+    if (rank > 0) {
+      shiftSse2(table, rank, symbol);
+    }
+    out[i] = symbol;
+  }
+}
+
+/**
+ * Finds a byte 32 positions per instruction using AVX2
+ *
+ * @pre     table must hold every byte value
+ */
+__attribute__((target("avx2"))) inline int findAvx2(const unsigned char *table,
+                                                    unsigned char symbol) {
+  const __m256i needle = _mm256_set1_epi8(char(symbol));
+  for (int i = 0;; i += 32) {
+    __m256i block =
+        _mm256_loadu_si256(reinterpret_cast<const __m256i *>(table + i));
+    unsigned mask =
+        unsigned(_mm256_movemask_epi8(_mm256_cmpeq_epi8(block, needle)));
+    if (mask != 0) {
+      return i + __builtin_ctz(mask);
+    }
+  }
+}
+
+/**
+ * Moves table[rank], which is symbol, to the front 32 positions per
+ * instruction using AVX2, as shiftSse2() does
+ */
+__attribute__((target("avx2"))) inline void
+shiftAvx2(unsigned char *table, int rank, unsigned char symbol) {
+  const __m256i lanes = _mm256_setr_epi8(
+      0, 1, 2, 3, 4, 5, 6, 7, 8, 9, 10, 11, 12, 13, 14, 15, 16, 17, 18, 19, 20,
+      21, 22, 23, 24, 25, 26, 27, 28, 29, 30, 31);
+  __m256i prev = _mm256_set1_epi8(char(symbol));
+  int last = rank & ~31;
+
+  for (int i = 0; i <= last; i += 32) {
+    __m256i *address = reinterpret_cast<__m256i *>(table + i);
+    __m256i curr = _mm256_loadu_si256(address);
+    // byte shifts stay within 128-bit lanes, so each lane takes its first
+    // byte from the lane before it, the first lane from the previous block
+    __m256i carry = _mm256_permute2x128_si256(prev, curr, 0x21);
+    __m256i shifted = _mm256_alignr_epi8(curr, carry, 15);
+    if (i == last) {
+      __m256i moved =
+          _mm256_cmpgt_epi8(_mm256_set1_epi8(char(rank - i + 1)), lanes);
+      shifted = _mm256_blendv_epi8(curr, shifted, moved);
+    }
+    _mm256_storeu_si256(address, shifted);
+    prev = curr;
+  }
+}
+
+/**
+ * Encodes with AVX2
+ */
+__attribute__((target("avx2"))) void encodeAvx2(unsigned char *table,
+                                                const unsigned char *in,
+                                                std::size_t n,
+                                                unsigned char *out) {
+  for (std::size_t i = 0; i < n; i++) {
+    unsigned char symbol = in[i];
+    // repeated symbols, the most frequent case after a Burrows-Wheeler
+    // transform, need neither a search nor a shift
+    if (table[0] == symbol) {
+      out[i] = 0;
+      continue;
+    }
+    int rank = findAvx2(table, symbol);
+    shiftAvx2(table, rank, symbol);
+    out[i] = (unsigned char)rank;
+  }
+}
+
+/**
+ * Decodes with AVX2
+ */
+__attribute__((target("avx2"))) void decodeAvx2(unsigned char *table,
+                                                const unsigned char *in,
+                                                std::size_t n,
+                                                unsigned char *out) {
+  for (std::size_t i = 0; i < n; i++) {
+    int rank = in[i];
+    unsigned char symbol = table[rank];
+    if (rank > 0) {
+      shiftAvx2(table, rank, symbol);
+    }
+    out[i] = symbol;
+  }
+}
+#endif
+
+/**
+ * The implementations chosen for the running processor
+ */
+struct CodecKernels {
+  /** Name of the instruction set */
+  const char *name;
+  /** Encodes a chunk */
+  CodeChunkFn encode;
+  /** Decodes a chunk */
+  CodeChunkFn decode;
+};
+
+/**
+ * Chooses the widest implementations supported by the running processor
+ */
+CodecKernels detectKernels() {
+#ifdef MTF_CODEC_X86
+  __builtin_cpu_init();
+  if (__builtin_cpu_supports("avx2")) {
+    return {"avx2", encodeAvx2, decodeAvx2};
+  }
+  if (__builtin_cpu_supports("sse2")) {
+    return {"sse2", encodeSse2, decodeSse2};
+  }
+#endif
+  return {"scalar", encodeScalar, decodeScalar};
+}
+
+/**
+ * Retrieves the implementations detected on first use
+ */
+const CodecKernels &selectedKernels() {
+  static const CodecKernels selected = detectKernels();
+  return selected;
+}
+
+} // namespace
+
+/**
+ * Creates a coder whose list holds the bytes 0..255 in order
+ */
+MTFByteCodec::MTFByteCodec() { reset(); }
+
+/**
+ * Restores the list to the bytes 0..255 in order, to start a new stream
+ */
+void MTFByteCodec::reset() {
+  for (int i = 0; i < 256; i++) {
+    table[i] = (unsigned char)i;
+  }
+}
+
+/**
+ * Encodes a chunk of a stream
+ *
+ * @param   in   the symbols
+ * @param   n    number of symbols
+ * @param   out  set to the position of each symbol; may be in itself
+ *
+ * @post    every symbol is at the front of the list when the next is coded
+ */
+void MTFByteCodec::encode(const unsigned char *in, std::size_t n,
+                          unsigned char *out) {
+  selectedKernels().encode(table, in, n, out);
+}
+
+/**
+ * Decodes a chunk of a stream
+ *
+ * @param   in   the positions
+ * @param   n    number of positions
+ * @param   out  set to the symbol at each position; may be in itself
+ *
+ * @post    every symbol is at the front of the list when the next is coded
+ */
+void MTFByteCodec::decode(const unsigned char *in, std::size_t n,
+                          unsigned char *out) {
+  selectedKernels().decode(table, in, n, out);
+}
+
+/**
+ * Retrieves the name of the instruction set used to search and shift
+ *
+ * @return  "avx2", "sse2" or "scalar"
+ */
+const char *MTFByteCodec::instructionSet() { return selectedKernels().name; }
+
+/**
+ * Creates a coder whose list holds the symbols 0..alphabetSize-1 in order. If
+ * memory cannot be allocated for the list, every later call reports failure.
+ *
+ * @param   alphabetSize  number of distinct symbols
+ *
+ * @pre     alphabetSize must be greater than 0
+ */
+MTFSymbolCodec::MTFSymbolCodec(int alphabetSize) : alphabetSize(alphabetSize) {
+  reset();
+}
+
+/**
+ * Restores the list to the symbols 0..alphabetSize-1 in order, to start a new
+ * stream
+ *
+ * @return  true if successful, false if memory could not be allocated
+ */
+bool MTFSymbolCodec::reset() {
+  symbols.clear();
+  for (int symbol = alphabetSize - 1; symbol >= 0; symbol--) {
+    if (!symbols.add(symbol)) {
+      symbols.clear();
+      return false;
+    }
+  }
+  return true;
+}
+
+/**
+ * Encodes a chunk of a stream
+ *
+ * @param   in   the symbols
+ * @param   n    number of symbols
+ * @param   out  set to the position of each symbol; may be in itself
+ *
+ * @return  true if every symbol is in the alphabet, false at the first one
+ *          that is not, leaving the symbols after it uncoded
+ */
+bool MTFSymbolCodec::encode(const int *in, std::size_t n, int *out) {
+  for (std::size_t i = 0; i < n; i++) {
+    int rank = symbols.moveToFront(in[i]);
+    if (rank < 0) {
+      return false;
+    }
+    out[i] = rank;
+  }
+  return true;
+}
+
+/**
+ * Decodes a chunk of a stream
+ *
+ * @param   in   the positions
+ * @param   n    number of positions
+ * @param   out  set to the symbol at each position; may be in itself
+ *
+ * @return  true if every position is below alphabetSize, false at the first
+ *          one that is not, leaving the positions after it uncoded
+ */
+bool MTFSymbolCodec::decode(const int *in, std::size_t n, int *out) {
+  for (std::size_t i = 0; i < n; i++) {
+    if (in[i] < 0 || in[i] >= symbols.getCurrentSize()) {
+      return false;
+    }
+    out[i] = symbols.moveToFrontAt(in[i]);
+  }
+  return true;
+}
+
+/**
+ * Retrieves the number of distinct symbols
+ *
+ * @return  alphabetSize
+ */
+int MTFSymbolCodec::getAlphabetSize() const {
+  return alphabetSize;
+} // end MTFCodec.cpp
@@ -0,0 +1,134 @@
+/**
+ * MTFCodec.h
+ *
+ * Declarations for move-to-front coders, the stage that follows a
+ * Burrows-Wheeler transform in block-sorting compressors. Encoding replaces
+ * every symbol by its position in a move-to-front list and then moves it to
+ * the front; decoding replaces every position by the symbol found there and
+ * moves that symbol to the front. Both keep their list between calls, so a
+ * stream can be coded in chunks of any size.
+ *
+ * Joshua Scheck
+ * 2020-10-18
+ */
+
+#pragma once
+#include "MTFArray.h"
+#include <cstddef>
+
+/**
+ * Move-to-front coder over bytes. The list is a 256-byte array searched and
+ * shifted with the widest vector instructions the processor supports (AVX2,
+ * then SSE2), with a portable scalar fallback.
+ *
+ * One coder codes one stream in one direction: a stream encoded by one coder
+ * is decoded by another that starts from the same, initial list.
+ */
+class MTFByteCodec {
+public:
+  /**
+   * Creates a coder whose list holds the bytes 0..255 in order
+   */
+  MTFByteCodec();
+
+  /**
+   * Restores the list to the bytes 0..255 in order, to start a new stream
+   */
+  void reset();
+
+  /**
+   * Encodes a chunk of a stream
+   *
+   * @param   in   the symbols
+   * @param   n    number of symbols
+   * @param   out  set to the position of each symbol; may be in itself
+   *
+   * @post    every symbol is at the front of the list when the next is coded
+   */
+  void encode(const unsigned char *in, std::size_t n, unsigned char *out);
+
+  /**
+   * Decodes a chunk of a stream
+   *
+   * @param   in   the positions
+   * @param   n    number of positions
+   * @param   out  set to the symbol at each position; may be in itself
+   *
+   * @post    every symbol is at the front of the list when the next is coded
+   */
+  void decode(const unsigned char *in, std::size_t n, unsigned char *out);
+
+  /**
+   * Retrieves the name of the instruction set used to search and shift
+   *
+   * @return  "avx2", "sse2" or "scalar"
+   */
+  static const char *instructionSet();
+
+private:
+  /** The move-to-front list; table[0] is the front */
+  alignas(64) unsigned char table[256];
+};
+
+/**
+ * Move-to-front coder over the integer symbols 0..alphabetSize-1, for
+ * alphabets too large for MTFByteCodec. The list is an MTFArray.
+ *
+ * One coder codes one stream in one direction, as for MTFByteCodec.
+ */
+class MTFSymbolCodec {
+public:
+  /**
+   * Creates a coder whose list holds the symbols 0..alphabetSize-1 in order
+   *
+   * @param   alphabetSize  number of distinct symbols
+   *
+   * @pre     alphabetSize must be greater than 0
+   */
+  explicit MTFSymbolCodec(int alphabetSize);
+
+  /**
+   * Restores the list to the symbols 0..alphabetSize-1 in order, to start a
+   * new stream
+   *
+   * @return  true if successful, false if memory could not be allocated
+   */
+  bool reset();
+
+  /**
+   * Encodes a chunk of a stream
+   *
+   * @param   in   the symbols
+   * @param   n    number of symbols
+   * @param   out  set to the position of each symbol; may be in itself
+   *
+   * @return  true if every symbol is in the alphabet, false at the first one
+   *          that is not, leaving the symbols after it uncoded
+   */
+  bool encode(const int *in, std::size_t n, int *out);
+
+  /**
+   * Decodes a chunk of a stream
+   *
+   * @param   in   the positions
+   * @param   n    number of positions
+   * @param   out  set to the symbol at each position; may be in itself
+   *
+   * @return  true if every position is below alphabetSize, false at the first
+   *          one that is not, leaving the positions after it uncoded
+   */
+  bool decode(const int *in, std::size_t n, int *out);
+
+  /**
+   * Retrieves the number of distinct symbols
+   *
+   * @return  alphabetSize
+   */
+  int getAlphabetSize() const;
+
+private:
+  /** Number of distinct symbols */
+  int alphabetSize;
+  /** The move-to-front list of symbols */
+  MTFArray symbols;
+};
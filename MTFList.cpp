@@ -8,6 +8,9 @@
  * "move-to-front" strategy. Specifically, Nodes with the sought integer values
  * are moved to the front of the initialized MTFList which can introduce
  * efficiency with iterative searching through normally distributed values.
+ * Alternatively, an MTFList can count hits without moving Nodes and reorder
+ * itself by frequency every so many lookups. Either way, it can copy its Nodes
+ * into list order now and then, so that walks from the front stay sequential.
  *
  * Joshua Scheck
  * 2020-10-18
@@ -15,6 +18,7 @@
  */
 
 #include "MTFList.h"
+#include <algorithm>
 
 /**
  * Overrides LinkedList::contains(int anEntry) method. Similarly determines if
@@ -25,9 +29,9 @@
  *                   in this MTFList
  *
  * @pre              MTFList must be initialized, which will also initialize
- *                   accessed class members head and traverseCount
+ *                   its Nodes and instrumentation
  *
- * @post             class member traverseCount is incremented by 1 with each
+ * @post             the traversal count is incremented by 1 with each
  * Node traversed in the search for the first occurance of the specified integer
  * value (even if not found). If the value is found in a Node, that Node is then
  *                   moved up to the front of this MTFList. No traversals will
@@ -37,38 +41,140 @@
  *                   at least one Node in this MTFList, false otherwise
  */
 bool MTFList::contains(int anEntry) {
+  if (settings.interval <= 0 && autoRelayoutPromotions <= 0) {
+    // the found Node is spliced out and becomes the new front of this MTFList
+    return nodes.contains<MoveToFront>(anEntry);
+  }
 
-  Node *currNode = head;
-  Node *prevNode = nullptr;
+  if (settings.interval <= 0) {
+    // a Node was moved exactly when the front changed
+    const Node *oldFront = nodes.front();
+    bool found = nodes.contains<MoveToFront>(anEntry);
+    if (found && nodes.front() != oldFront &&
+        ++promotionsSinceRelayout >= autoRelayoutPromotions) {
+      // the count restarts even if memory was short, so a failed relayout
+      // is not retried on every lookup
+      promotionsSinceRelayout = 0;
+      relayoutUntimed();
+    }
+    return found;
+  }
 
-  // look for specified integer in Nodes in this MTFList
-  // if not empty or until the end of the list is reached
-  while (currNode != nullptr) {
+  // between reorganizations a lookup only counts, and writes no links
+  bool found = nodes.contains(anEntry, CountHits{&windowPositions});
+  windowLookups++;
+  windowHits += found ? 1 : 0;
 
-    // for each operation of looking into a Node, a traversal count
-    // is recorded
-    traverseCount++;
+  // costAfter is measured on the very hits the order was sorted by, so hits
+  // are compared for drift with costBefore, measured on hits the previous
+  // sorted order had not seen
+  if (windowLookups >= settings.interval) {
+    reorganize(false);
+  } else if (settings.driftRatio > 0.0 && reorganizationCount > 1 &&
+             windowLookups % std::max(1, settings.interval / 8) == 0 &&
+             windowHits > 0 &&
+             double(windowPositions) / windowHits >
+                 lastReport.costBefore * settings.driftRatio) {
+    reorganize(true);
+  }
+  return found;
+}
 
-    if (currNode->item == anEntry) {
+/**
+ * Overrides LinkedList::containsBatch method. Resolves every value in a single
+ * pass over the Nodes, then leaves this MTFList in exactly the order that
+ * calling contains for each value in turn would have produced: the found Nodes
+ * are at the front, the most recently sought first.
+ *
+ * @param   keys  the sought integer values, in the order they are sought
+ * @param   n     number of sought values
+ * @param   out   set so that out[i] is true if keys[i] is contained in this
+ *                MTFList, false otherwise
+ *
+ * @pre             keys and out must each reference n elements
+ *
+ * @post            the traversal count is incremented by 1 with each Node
+ * visited by the single pass
+ *
+ * @return          true if the values were looked up, false if memory for the
+ *                  lookup could not be allocated (no Node moves then)
+ */
+bool MTFList::containsBatch(const int *keys, std::size_t n, bool *out) {
+  if (settings.interval > 0) {
+    return containsEach(keys, n, out);
+  }
+  return nodes.containsBatchMoveToFront(keys, n, out);
+}
+
+/**
+ * Selects between plain move-to-front and the frequency reorganization mode,
+ * in which contains counts the hits of every Node without moving it and the
+ * whole MTFList is stably sorted by decayed hit count every interval lookups,
+ * or earlier once the measured cost drifts
+ *
+ * @param   settings  the interval, decay and drift ratio; an interval of 0
+ *                    selects plain move-to-front
+ *
+ * @post    the lookups counted towards the next reorganization restart at 0
+ */
+void MTFList::setReorganization(const FrequencyReorganization &settings) {
+  this->settings = settings;
+  lastReport = ReorganizationReport();
+  reorganizationCount = 0;
+  windowLookups = 0;
+  windowHits = 0;
+  windowPositions = 0;
+}
 
-      // only make structural modifications to MTFList if the found
-      // Node is not at the front of this MTFList
-      if (prevNode != nullptr) {
-        // have previous Node hold reference to the next Node after
-        // current Node in order to splice out currNode
-        prevNode->next = currNode->next;
+/**
+ * Retrieves what was measured around the latest reorganization
+ *
+ * @return  the report, all 0 before the first reorganization
+ */
+const ReorganizationReport &MTFList::getLastReorganization() const {
+  return lastReport;
+}
 
-        // found Node is the new front of this MTFList
-        currNode->next = head;
-        head = currNode;
-      }
+/**
+ * Retrieves the number of reorganizations since the mode was selected
+ *
+ * @return  the number of reorganizations
+ */
+int MTFList::getReorganizationCount() const { return reorganizationCount; }
 
-      return true;
-    }
+/**
+ * Makes this MTFList lay its Nodes out again in their current order, as
+ * LinkedList::relayout() does but without timing lookups inside contains,
+ * after every so many Nodes moved by contains. In the frequency reorganization
+ * mode, every reorganization is followed by a relayout instead.
+ *
+ * @param   promotions  Nodes moved to the front between relayouts; 0 disables
+ *                      automatic relayouts
+ *
+ * @post    the promotions counted towards the next relayout restart at 0
+ */
+void MTFList::setAutoRelayout(long long promotions) {
+  autoRelayoutPromotions = promotions;
+  promotionsSinceRelayout = 0;
+}
 
-    prevNode = currNode;
-    currNode = currNode->next;
+/**
+ * Sorts this MTFList by hit count and records the report
+ *
+ * @param   drifted  true if triggered early by drift
+ */
+void MTFList::reorganize(bool drifted) {
+  lastReport.lookups = windowLookups;
+  lastReport.costBefore =
+      windowHits == 0 ? 0.0 : double(windowPositions) / windowHits;
+  lastReport.costAfter = nodes.sortByHits(settings.decayShift);
+  lastReport.drifted = drifted;
+  reorganizationCount++;
+  if (autoRelayoutPromotions > 0) {
+    relayoutUntimed();
   }
 
-  return false;
+  windowLookups = 0;
+  windowHits = 0;
+  windowPositions = 0;
 } // end MTFList.cpp
\ No newline at end of file
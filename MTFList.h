@@ -8,6 +8,9 @@
  * "move-to-front" strategy. Specifically, Nodes with the sought integer values
  * are moved to the front of the initialized MTFList which can introduce
  * efficiency with iterative searching through normally distributed values.
+ * Alternatively, an MTFList can count hits without moving Nodes and reorder
+ * itself by frequency every so many lookups. Either way, it can copy its Nodes
+ * into list order now and then, so that walks from the front stay sequential.
  *
  * Joshua Scheck
  * 2020-10-18
@@ -17,12 +20,45 @@
 #pragma once
 #include "LinkedList.h"
 
+/**
+ * Settings of the frequency reorganization mode of an MTFList
+ */
+struct FrequencyReorganization {
+  /** Lookups between reorganizations; 0 selects plain move-to-front */
+  int interval = 0;
+  /** Every hit count is divided by 2^decayShift after a reorganization */
+  unsigned decayShift = 1;
+  /** A reorganization happens early once the average position of hits since
+   * the last one exceeds, by this factor, the costBefore measured over the
+   * interval before it; 0 disables */
+  double driftRatio = 0.0;
+};
+
+/**
+ * What an MTFList measured around one reorganization
+ */
+struct ReorganizationReport {
+  /** Lookups since the previous reorganization */
+  long long lookups = 0;
+  /** Average one-based position of the hits since the previous
+   * reorganization, as measured */
+  double costBefore = 0.0;
+  /** Average position of a hit in the new order, weighted by the hit
+   * counts of every Node before they decay, the counts the order was
+   * sorted by */
+  double costAfter = 0.0;
+  /** True if the reorganization was triggered early by drift */
+  bool drifted = false;
+};
+
 /**
  * Represents a move-to-front singly Linked List that stores integer values as
  * Nodes and is the subclass of LinkedList
  */
 class MTFList : public LinkedList {
 public:
+  using LinkedList::LinkedList;
+
   /**
    * Overrides LinkedList::contains(int anEntry) method. Similarly determines if
    * the specified integer value is held by a Node in this MTFList, but then
@@ -32,9 +68,9 @@ public:
    * for in this MTFList
    *
    * @pre              MTFList must be initialized, which will also initialize
-   *                   accessed class members head and traverseCount
+   *                   its Nodes and instrumentation
    *
-   * @post             class member traverseCount is incremented by 1 with each
+   * @post             the traversal count is incremented by 1 with each
    * Node traversed in the search for the first occurance of the specified
    * integer value (even if not found). If the value is found in a Node, that
    * Node is then moved up to the front of this MTFList. No traversals will
@@ -44,4 +80,91 @@ public:
    *                   at least one Node in this MTFList, false otherwise
    */
   bool contains(int anEntry) override;
+
+  /**
+   * Overrides LinkedList::containsBatch method. Resolves every value in a
+   * single pass over the Nodes, then leaves this MTFList in exactly the order
+   * that calling contains for each value in turn would have produced: the
+   * found Nodes are at the front, the most recently sought first.
+   *
+   * @param   keys  the sought integer values, in the order they are sought
+   * @param   n     number of sought values
+   * @param   out   set so that out[i] is true if keys[i] is contained in this
+   *                MTFList, false otherwise
+   *
+   * @pre             keys and out must each reference n elements
+   *
+   * @post            the traversal count is incremented by 1 with each Node
+   * visited by the single pass
+   *
+   * @return          true if the values were looked up, false if memory for
+   *                  the lookup could not be allocated (no Node moves then)
+   */
+  bool containsBatch(const int *keys, std::size_t n, bool *out) override;
+
+  /**
+   * Selects between plain move-to-front and the frequency reorganization
+   * mode, in which contains counts the hits of every Node without moving it
+   * and the whole MTFList is stably sorted by decayed hit count every
+   * interval lookups, or earlier once the measured cost drifts
+   *
+   * @param   settings  the interval, decay and drift ratio; an interval of 0
+   *                    selects plain move-to-front
+   *
+   * @post    the lookups counted towards the next reorganization restart at 0
+   */
+  void setReorganization(const FrequencyReorganization &settings);
+
+  /**
+   * Retrieves what was measured around the latest reorganization
+   *
+   * @return  the report, all 0 before the first reorganization
+   */
+  const ReorganizationReport &getLastReorganization() const;
+
+  /**
+   * Retrieves the number of reorganizations since the mode was selected
+   *
+   * @return  the number of reorganizations
+   */
+  int getReorganizationCount() const;
+
+  /**
+   * Makes this MTFList lay its Nodes out again in their current order, as
+   * LinkedList::relayout() does but without timing lookups inside contains,
+   * after every so many Nodes moved by contains. In the frequency
+   * reorganization mode, every reorganization is followed by a relayout
+   * instead.
+   *
+   * @param   promotions  Nodes moved to the front between relayouts; 0
+   *                      disables automatic relayouts
+   *
+   * @post    the promotions counted towards the next relayout restart at 0
+   */
+  void setAutoRelayout(long long promotions);
+
+private:
+  /**
+   * Sorts this MTFList by hit count and records the report
+   *
+   * @param   drifted  true if triggered early by drift
+   */
+  void reorganize(bool drifted);
+
+  /** Settings of the frequency reorganization mode */
+  FrequencyReorganization settings;
+  /** What was measured around the latest reorganization */
+  ReorganizationReport lastReport;
+  /** Number of reorganizations since the mode was selected */
+  int reorganizationCount = 0;
+  /** Lookups since the latest reorganization */
+  long long windowLookups = 0;
+  /** Number of hits since the latest reorganization */
+  long long windowHits = 0;
+  /** Sum of the one-based positions of those hits */
+  long long windowPositions = 0;
+  /** Nodes moved between automatic relayouts; 0 if disabled */
+  long long autoRelayoutPromotions = 0;
+  /** Nodes moved since the latest automatic relayout */
+  long long promotionsSinceRelayout = 0;
 }; // end MTFList.h
\ No newline at end of file
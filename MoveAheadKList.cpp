@@ -0,0 +1,61 @@
+/**
+ * MoveAheadKList.cpp
+ *
+ * Implementations for the "move-ahead-k" linked list variant, MoveAheadKList,
+ * which is a subclass of LinkedList. MoveAheadKList overrides the
+ * LinkedList:contains(int anEntry) method so that a Node with the sought
+ * integer value moves ahead by a fixed number of positions, or by a fraction of
+ * its distance from the front, instead of all the way to the front.
+ *
+ * Joshua Scheck
+ * 2020-10-18
+ */
+
+#include "MoveAheadKList.h"
+
+/**
+ * Constructor for this MoveAheadKList class. Initializes an empty
+ * MoveAheadKList promoting found Nodes as described by the policy.
+ *
+ * @param   promotion   MoveAheadK::byPositions(k) or
+ *                      MoveAheadK::byFraction(part)
+ * @param   allocation  where the Nodes of this MoveAheadKList come from
+ */
+MoveAheadKList::MoveAheadKList(const MoveAheadK &promotion,
+                               NodeAllocation allocation)
+    : LinkedList(allocation), promotion(promotion) {}
+
+/**
+ * Overrides LinkedList::contains(int anEntry) method. Similarly determines if
+ * the specified integer value is held by a Node in this MoveAheadKList, but
+ * then moves the found Node ahead as configured
+ *
+ * @param   anEntry  the sought integer value held by a Node to be searched for
+ *                   in this MoveAheadKList
+ *
+ * @post             the traversal count is incremented by 1 with each Node
+ * traversed in the search for the first occurance of the specified integer
+ * value (even if not found). If the value is found, its Node moves ahead by k
+ * positions, or by the configured fraction of its distance from the front (at
+ * least one position), stopping at the front.
+ *
+ * @return           true if the specified integer value is contained in at
+ *                   least one Node in this MoveAheadKList, false otherwise
+ */
+bool MoveAheadKList::contains(int anEntry) {
+  return nodes.contains(anEntry, promotion);
+}
+
+/**
+ * Overrides LinkedList::containsBatch method. Since every search changes the
+ * order that the next search sees, the values are sought one at a time.
+ *
+ * @param   keys  the sought integer values, in the order they are sought
+ * @param   n     number of sought values
+ * @param   out   set so that out[i] is the result of contains(keys[i])
+ *
+ * @return  always true
+ */
+bool MoveAheadKList::containsBatch(const int *keys, std::size_t n, bool *out) {
+  return containsEach(keys, n, out);
+} // end MoveAheadKList.cpp
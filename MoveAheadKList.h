@@ -0,0 +1,68 @@
+/**
+ * MoveAheadKList.h
+ *
+ * Declarations for the "move-ahead-k" linked list variant, MoveAheadKList,
+ * which is a subclass of LinkedList. MoveAheadKList overrides the
+ * LinkedList:contains(int anEntry) method so that a Node with the sought
+ * integer value moves ahead by a fixed number of positions, or by a fraction of
+ * its distance from the front, instead of all the way to the front.
+ *
+ * Joshua Scheck
+ * 2020-10-18
+ */
+
+#pragma once
+#include "LinkedList.h"
+
+/**
+ * Represents a move-ahead-k singly Linked List that stores integer values as
+ * Nodes and is the subclass of LinkedList
+ */
+class MoveAheadKList : public LinkedList {
+public:
+  /**
+   * Constructor for this MoveAheadKList class. Initializes an empty
+   * MoveAheadKList promoting found Nodes as described by the policy.
+   *
+   * @param   promotion   MoveAheadK::byPositions(k) or
+   *                      MoveAheadK::byFraction(part)
+   * @param   allocation  where the Nodes of this MoveAheadKList come from
+   */
+  explicit MoveAheadKList(const MoveAheadK &promotion,
+                          NodeAllocation allocation = NodeAllocation::Heap);
+
+  /**
+   * Overrides LinkedList::contains(int anEntry) method. Similarly determines if
+   * the specified integer value is held by a Node in this MoveAheadKList, but
+   * then moves the found Node ahead as configured
+   *
+   * @param   anEntry  the sought integer value held by a Node to be searched
+   *                   for in this MoveAheadKList
+   *
+   * @post             the traversal count is incremented by 1 with each Node
+   * traversed in the search for the first occurance of the specified integer
+   * value (even if not found). If the value is found, its Node moves ahead by
+   * k positions, or by the configured fraction of its distance from the front
+   * (at least one position), stopping at the front.
+   *
+   * @return           true if the specified integer value is contained in
+   *                   at least one Node in this MoveAheadKList, false otherwise
+   */
+  bool contains(int anEntry) override;
+
+  /**
+   * Overrides LinkedList::containsBatch method. Since every search changes the
+   * order that the next search sees, the values are sought one at a time.
+   *
+   * @param   keys  the sought integer values, in the order they are sought
+   * @param   n     number of sought values
+   * @param   out   set so that out[i] is the result of contains(keys[i])
+   *
+   * @return  always true
+   */
+  bool containsBatch(const int *keys, std::size_t n, bool *out) override;
+
+private:
+  /** How far a found Node moves ahead. */
+  MoveAheadK promotion;
+}; // end MoveAheadKList.h
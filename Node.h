@@ -0,0 +1,69 @@
+/**
+ * Node.h
+ *
+ * Declaration of the ListNode struct template shared by SelfOrganizingList,
+ * the lists wrapping it and the NodePool that can supply their storage. Node is
+ * the integer instantiation used by LinkedList and its subclasses. Nodes of
+ * keys too wide to compare in one instruction also keep a fingerprint of
+ * their value.
+ *
+ * Joshua Scheck
+ * 2020-10-18
+ */
+
+#pragma once
+#include <cstdint>
+#include <type_traits>
+
+/**
+ * Whether a key is compared in full at every hop of a search. Keys that are
+ * trivially copyable and no wider than a machine word compare in one
+ * instruction, so their nodes store no fingerprint and stay as small as
+ * possible; any other key, such as a string or a composite identifier, is
+ * compared only when a 32-bit fingerprint of its hash matches.
+ *
+ * @tparam  Key  type of the value held by a node
+ */
+template <typename Key>
+constexpr bool isInlineKey = std::is_trivially_copyable<Key>::value &&
+                             sizeof(Key) <= sizeof(std::uint64_t);
+
+/**
+ * This struct represents a single node that composes a list ADT
+ *
+ * @tparam  Key            type of the value held by the node
+ * @tparam  Fingerprinted  whether the node keeps a fingerprint of its value,
+ *                         false for keys that are compared inline
+ */
+template <typename Key, bool Fingerprinted = !isInlineKey<Key>>
+struct ListNode {
+  /** Value held by this Node */
+  Key item;
+  /** Number of times a search found this Node, kept by promotion policies
+   * that order the list by frequency. Occupies padding for integer keys. */
+  unsigned hits;
+  /** Reference to the address of the next Node in this list, otherwise
+   * nullptr */
+  ListNode *next;
+};
+
+/**
+ * A node whose value is compared only when the fingerprints match. The link
+ * and the fingerprint come first, so a search that passes a node by reads
+ * neither the value nor any memory the value owns.
+ */
+template <typename Key> struct ListNode<Key, true> {
+  /** Reference to the address of the next Node in this list, otherwise
+   * nullptr */
+  ListNode *next;
+  /** 32 bits of the mixed hash of item */
+  std::uint32_t fingerprint;
+  /** Number of times a search found this Node, kept by promotion policies
+   * that order the list by frequency */
+  unsigned hits;
+  /** Value held by this Node */
+  Key item;
+};
+
+/** Node holding an integer value, as stored by LinkedList */
+typedef ListNode<int> Node;
@@ -0,0 +1,286 @@
+/**
+ * NodePool.h
+ *
+ * Declaration and implementation of the NodePool class template, a slab
+ * allocator that hands out nodes carved from large contiguous blocks of
+ * memory. Released nodes are kept on an internal free list for reuse, and all
+ * slabs can be returned to the freestore at once instead of deallocating nodes
+ * one at a time.
+ *
+ * Joshua Scheck
+ * 2020-10-18
+ */
+
+#pragma once
+#include <new>
+
+/**
+ * Selects where a list obtains the memory for its nodes
+ */
+enum class NodeAllocation {
+  /** Every node is individually allocated and freed on the freestore */
+  Heap,
+  /** Nodes are carved out of large per-list slabs owned by a NodePool */
+  Pooled
+};
+
+/**
+ * Represents a pool of nodes owned by a single list. Memory is requested from
+ * the freestore one slab at a time, where each slab holds many nodes laid out
+ * next to each other.
+ *
+ * @tparam  NodeType  node struct with a next member pointing to NodeType
+ */
+template <typename NodeType> class NodePool {
+public:
+  /** Number of nodes in a slab when no other size is requested */
+  static const int DEFAULT_SLAB_NODES = 256;
+
+  /**
+   * Constructor for this NodePool class. No memory is allocated until the
+   * first node is requested.
+   *
+   * @param   nodesPerSlab  number of usable nodes held by each slab
+   *
+   * @pre     nodesPerSlab must be greater than 0
+   *
+   * @post    this NodePool owns no slabs and its free list is empty
+   */
+  explicit NodePool(int nodesPerSlab = DEFAULT_SLAB_NODES)
+      : nodesPerSlab(nodesPerSlab), slabCount(0), slabs(nullptr),
+        bumpNext(nullptr), bumpRemaining(0), freeList(nullptr) {}
+
+  /**
+   * Destructor for this NodePool class that frees every slab it owns.
+   *
+   * Calls NodePool::releaseAll() method.
+   *
+   * @post    all nodes handed out by this NodePool are invalid
+   */
+  ~NodePool() { releaseAll(); }
+
+  NodePool(const NodePool &) = delete;
+  NodePool &operator=(const NodePool &) = delete;
+
+  /**
+   * Move constructor for this NodePool class. Takes over every slab of
+   * another NodePool without touching its nodes.
+   *
+   * @param   other  the NodePool whose slabs are taken over
+   *
+   * @post    other owns no slabs; the nodes it handed out now belong to this
+   *          NodePool
+   */
+  NodePool(NodePool &&other) noexcept
+      : nodesPerSlab(other.nodesPerSlab), slabCount(other.slabCount),
+        slabs(other.slabs), bumpNext(other.bumpNext),
+        bumpRemaining(other.bumpRemaining), freeList(other.freeList) {
+    other.forget();
+  }
+
+  /**
+   * Move assignment for this NodePool class. Frees every slab of this
+   * NodePool, then takes over every slab of another NodePool.
+   *
+   * @param   other  the NodePool whose slabs are taken over
+   *
+   * @post    other owns no slabs; the nodes it handed out now belong to this
+   *          NodePool
+   *
+   * @return  this NodePool
+   */
+  NodePool &operator=(NodePool &&other) noexcept {
+    if (this != &other) {
+      releaseAll();
+      nodesPerSlab = other.nodesPerSlab;
+      slabCount = other.slabCount;
+      slabs = other.slabs;
+      bumpNext = other.bumpNext;
+      bumpRemaining = other.bumpRemaining;
+      freeList = other.freeList;
+      other.forget();
+    }
+    return *this;
+  }
+
+  /**
+   * Hands out a node, reusing a released node when one is available and
+   * otherwise carving it from the current slab. A new slab is requested from
+   * the freestore only when the current one is exhausted.
+   *
+   * @pre     NodePool must be initialized
+   *
+   * @post    the returned node is owned by the caller until it is released
+   *
+   * @return  address of the node, or nullptr if a new slab could not be
+   *          allocated
+   */
+  NodeType *allocate() {
+    // recently released nodes are preferred since they are likely still cached
+    if (freeList != nullptr) {
+      NodeType *node = freeList;
+      freeList = freeList->next;
+      return node;
+    }
+
+    if (bumpRemaining == 0) {
+      NodeType *slab = nullptr;
+      try {
+        // one extra node is reserved at the start of the slab to link slabs
+        slab = new NodeType[nodesPerSlab + 1];
+      }
+      // inability to allocate memory will throw a std::bad_alloc error
+      // which will be caught and signals a lack of success
+      catch (std::bad_alloc &exc) {
+        return nullptr;
+      }
+
+      slab->next = slabs;
+      slabs = slab;
+      slabCount++;
+      bumpNext = slab + 1;
+      bumpRemaining = nodesPerSlab;
+    }
+
+    bumpRemaining--;
+    return bumpNext++;
+  }
+
+  /**
+   * Makes sure that the next count calls to NodePool::allocate() carve nodes
+   * from one contiguous slab, allocating a slab of exactly count nodes if the
+   * current slab has fewer left.
+   *
+   * @param   count  number of nodes about to be allocated
+   *
+   * @post    nodes left in the previous slab are no longer handed out, but
+   *          stay owned by this NodePool
+   *
+   * @return  true if the nodes are available, false if the slab could not be
+   *          allocated
+   */
+  bool reserve(int count) {
+    if (bumpRemaining >= count) {
+      return true;
+    }
+
+    NodeType *slab = nullptr;
+    try {
+      slab = new NodeType[count + 1];
+    }
+    // inability to allocate memory will throw a std::bad_alloc error
+    // which will be caught and signals a lack of success
+    catch (std::bad_alloc &exc) {
+      return false;
+    }
+
+    slab->next = slabs;
+    slabs = slab;
+    slabCount++;
+    bumpNext = slab + 1;
+    bumpRemaining = count;
+    return true;
+  }
+
+  /**
+   * Takes over every slab of another NodePool without touching its nodes, so
+   * that the nodes it handed out can be released to this NodePool
+   *
+   * @param   other  the NodePool whose slabs are taken over
+   *
+   * @post    other owns no slabs. Nodes on its free list and never-used nodes
+   *          of its slabs are no longer handed out, but stay owned by this
+   *          NodePool.
+   */
+  void adopt(NodePool &other) {
+    if (this == &other || other.slabs == nullptr) {
+      return;
+    }
+
+    // the slabs of other are linked in after the most recent slab of this
+    // NodePool, which keeps the current slab and free list in use
+    NodeType *oldestSlab = other.slabs;
+    while (oldestSlab->next != nullptr) {
+      oldestSlab = oldestSlab->next;
+    }
+    if (slabs == nullptr) {
+      slabs = other.slabs;
+    } else {
+      oldestSlab->next = slabs->next;
+      slabs->next = other.slabs;
+    }
+    slabCount += other.slabCount;
+    other.forget();
+  }
+
+  /**
+   * Places a node back on the free list of this NodePool so that a later call
+   * to NodePool::allocate() can reuse it.
+   *
+   * @param   node  node previously returned by NodePool::allocate()
+   *
+   * @pre     node must have been handed out by this NodePool and not been
+   *          released since
+   *
+   * @post    node is at the front of the free list
+   */
+  void release(NodeType *node) {
+    node->next = freeList;
+    freeList = node;
+  }
+
+  /**
+   * Returns every slab owned by this NodePool to the freestore at once.
+   *
+   * @post    this NodePool owns no slabs, its free list is empty and every
+   *          node it handed out is invalid
+   */
+  void releaseAll() {
+    while (slabs != nullptr) {
+      NodeType *previousSlab = slabs->next;
+      delete[] slabs;
+      slabs = previousSlab;
+    }
+
+    slabCount = 0;
+    bumpNext = nullptr;
+    bumpRemaining = 0;
+    freeList = nullptr;
+  }
+
+  /**
+   * Retrieves the number of slabs currently owned by this NodePool
+   *
+   * @post    state of this NodePool does not change
+   *
+   * @return  the number of slabs allocated since the last releaseAll()
+   */
+  int getSlabCount() const { return slabCount; }
+
+private:
+  /**
+   * Drops every reference to slabs without freeing them, once another
+   * NodePool has taken them over
+   */
+  void forget() {
+    slabCount = 0;
+    slabs = nullptr;
+    bumpNext = nullptr;
+    bumpRemaining = 0;
+    freeList = nullptr;
+  }
+
+  /** Number of usable nodes held by each slab */
+  int nodesPerSlab;
+  /** Number of slabs currently owned by this NodePool */
+  int slabCount;
+  /** The most recently allocated slab. The first node of every slab is
+   * reserved and its next member links to the previously allocated slab. */
+  NodeType *slabs;
+  /** The next never-used node in the most recent slab */
+  NodeType *bumpNext;
+  /** The number of never-used nodes left in the most recent slab */
+  int bumpRemaining;
+  /** Released nodes waiting to be reused, linked through their next member */
+  NodeType *freeList;
+}; // end NodePool.h
@@ -0,0 +1,166 @@
+/**
+ * PromotionPolicies.h
+ *
+ * Compile-time strategies deciding how SelfOrganizingList reorganizes itself
+ * after a search finds a node. A policy provides a const onHit member that is
+ * handed the list, the two nodes before the found node (nullptr where they do
+ * not exist), the found node itself and its zero-based position. Policies
+ * restructure the list only through its splicing helpers and may carry
+ * runtime settings of their own.
+ *
+ * Joshua Scheck
+ * 2020-10-18
+ */
+
+#pragma once
+
+/**
+ * Leaves the list untouched, as done by a "vanilla" LinkedList
+ */
+struct NoPromotion {
+  template <typename List>
+  void onHit(List &, typename List::NodeType *, typename List::NodeType *,
+             typename List::NodeType *, int) const {}
+};
+
+/**
+ * Moves the found node to the front of the list, as done by MTFList
+ */
+struct MoveToFront {
+  template <typename List>
+  void onHit(List &list, typename List::NodeType *,
+             typename List::NodeType *prevNode,
+             typename List::NodeType *currNode, int) const {
+    // only make structural modifications if the found node is not already
+    // at the front of the list
+    if (prevNode != nullptr) {
+      list.unlinkAfter(prevNode);
+      list.pushFront(currNode);
+    }
+  }
+};
+
+/**
+ * Swaps the found node with the node before it, so a key has to be hit
+ * repeatedly before it reaches the front of the list
+ */
+struct Transpose {
+  template <typename List>
+  void onHit(List &list, typename List::NodeType *prevPrevNode,
+             typename List::NodeType *prevNode,
+             typename List::NodeType *currNode, int) const {
+    if (prevNode != nullptr) {
+      list.unlinkAfter(prevNode);
+      list.insertAfter(prevPrevNode, currNode);
+    }
+  }
+};
+
+/**
+ * Counts the hits of every node without moving it, and adds the one-based
+ * position of the found node to a running sum, so that a list can reorganize
+ * itself by frequency now and then while its searches write no links
+ */
+struct CountHits {
+  /** Receives the one-based position of every found node */
+  long long *positionSum;
+
+  template <typename List>
+  void onHit(List &, typename List::NodeType *, typename List::NodeType *,
+             typename List::NodeType *currNode, int position) const {
+    currNode->hits++;
+    *positionSum += position + 1;
+  }
+};
+
+/**
+ * Counts the hits of every node and keeps the list ordered by decreasing
+ * count. The found node moves ahead of every node with fewer hits, staying
+ * behind nodes with as many hits so that ties keep their order. The list must
+ * already be in that order, so new nodes, which have no hits, belong at the
+ * end (see SelfOrganizingList::addLast).
+ */
+struct FrequencyCount {
+  template <typename List>
+  void onHit(List &list, typename List::NodeType *,
+             typename List::NodeType *prevNode,
+             typename List::NodeType *currNode, int) const {
+    currNode->hits++;
+
+    // the nodes before the found node are walked again to find the first one
+    // with fewer hits; the found node stays put if there is none
+    typename List::NodeType *targetPrev = nullptr;
+    typename List::NodeType *target = list.front();
+    while (target != currNode && target->hits >= currNode->hits) {
+      targetPrev = target;
+      target = target->next;
+    }
+
+    if (target != currNode) {
+      list.unlinkAfter(prevNode);
+      list.insertAfter(targetPrev, currNode);
+    }
+  }
+};
+
+/**
+ * Moves the found node ahead by a fixed number of positions, or by a fraction
+ * of its distance from the front, so that rarely used keys do not jump all the
+ * way to the front on a single hit
+ */
+struct MoveAheadK {
+  /** Number of positions to move ahead when fraction is not used */
+  int positions;
+  /** Fraction of the distance to the front to move ahead, used when greater
+   * than 0 */
+  double fraction;
+
+  /**
+   * Creates a policy moving the found node ahead by a fixed distance
+   *
+   * @param   k  number of positions to move ahead, at least 1
+   *
+   * @return  the policy
+   */
+  static MoveAheadK byPositions(int k) { return MoveAheadK{k, 0.0}; }
+
+  /**
+   * Creates a policy moving the found node ahead by part of its distance from
+   * the front, but always by at least one position
+   *
+   * @param   part  fraction in (0, 1]; 1 behaves like MoveToFront
+   *
+   * @return  the policy
+   */
+  static MoveAheadK byFraction(double part) { return MoveAheadK{1, part}; }
+
+  template <typename List>
+  void onHit(List &list, typename List::NodeType *,
+             typename List::NodeType *prevNode,
+             typename List::NodeType *currNode, int position) const {
+    int distance = positions;
+    if (fraction > 0.0) {
+      distance = int(position * fraction);
+      if (distance < 1) {
+        distance = 1;
+      }
+    }
+
+    int newPosition = position - distance;
+    if (newPosition < 0) {
+      newPosition = 0;
+    }
+    if (newPosition == position) {
+      return;
+    }
+
+    // walk again from the front to the node that will precede the found node
+    typename List::NodeType *targetPrev = nullptr;
+    for (int i = 0; i < newPosition; i++) {
+      targetPrev = targetPrev == nullptr ? list.front() : targetPrev->next;
+    }
+
+    list.unlinkAfter(prevNode);
+    list.insertAfter(targetPrev, currNode);
+  }
+};
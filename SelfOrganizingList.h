@@ -0,0 +1,1107 @@
+/**
+ * SelfOrganizingList.h
+ *
+ * Declaration and implementation of the SelfOrganizingList class template, the
+ * singly linked list at the core of LinkedList, MTFList and their siblings.
+ * The value type, the promotion strategy applied when a search finds a node
+ * and the instrumentation of traversals are all compile-time parameters, so
+ * searches are fully inlined and involve no virtual dispatch. A pointer to the
+ * last node lets whole lists be joined without walking them. An optional
+ * BloomFilter of the values held answers most searches for absent values
+ * without walking the list.
+ *
+ * Joshua Scheck
+ * 2020-10-18
+ */
+
+#pragma once
+#include <algorithm>
+#include <climits>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <iterator>
+#include <memory>
+#include <new>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+#include "BloomFilter.h"
+#include "Node.h"
+#include "NodePool.h"
+#include "PromotionPolicies.h"
+#include "TraverseCounters.h"
+
+/**
+ * Represents a singly linked list of values that may reorganize itself each
+ * time a search finds a value
+ *
+ * @tparam  Key      type of the stored values; must be default constructible,
+ *                   copy assignable, equality comparable and hashable by
+ *                   std::hash
+ * @tparam  Policy   promotion strategy applied by contains, such as
+ *                   NoPromotion or MoveToFront
+ * @tparam  Counter  instrumentation, such as TraverseCounter or
+ *                   NullTraverseCounter; ListCounter follows the
+ *                   NO_LIST_INSTRUMENTATION build flag
+ */
+template <typename Key, typename Policy = NoPromotion,
+          typename Counter = ListCounter>
+class SelfOrganizingList {
+public:
+  /** Type of the nodes composing this SelfOrganizingList */
+  typedef ListNode<Key> NodeType;
+
+  /**
+   * Constructor for this SelfOrganizingList class. Initializes an empty list
+   * whose nodes are obtained using the specified allocation mode.
+   *
+   * @param   allocation  NodeAllocation::Pooled to carve nodes from per-list
+   *                      slabs, NodeAllocation::Heap to allocate each node
+   *                      individually
+   */
+  explicit SelfOrganizingList(
+      NodeAllocation allocation = NodeAllocation::Heap)
+      : currentSize(0), head(nullptr), tail(nullptr), allocation(allocation) {}
+
+  /**
+   * Destructor for this SelfOrganizingList class that frees every node.
+   *
+   * Calls SelfOrganizingList::clear() method.
+   */
+  ~SelfOrganizingList() { clear(); }
+
+  SelfOrganizingList(const SelfOrganizingList &) = delete;
+  SelfOrganizingList &operator=(const SelfOrganizingList &) = delete;
+
+  /**
+   * Move constructor for this SelfOrganizingList class. Takes over the nodes
+   * of another list, and the slabs they live in, in constant time.
+   *
+   * @param   other  the list whose nodes are taken over
+   *
+   * @post    other is empty
+   */
+  SelfOrganizingList(SelfOrganizingList &&other) noexcept
+      : currentSize(other.currentSize), head(other.head), tail(other.tail),
+        allocation(other.allocation), pool(std::move(other.pool)),
+        filter(std::move(other.filter)), counter(other.counter) {
+    other.forget();
+  }
+
+  /**
+   * Move assignment for this SelfOrganizingList class. Frees the nodes of
+   * this list, then takes over the nodes of another list in constant time.
+   *
+   * @param   other  the list whose nodes are taken over
+   *
+   * @post    other is empty
+   *
+   * @return  this list
+   */
+  SelfOrganizingList &operator=(SelfOrganizingList &&other) noexcept {
+    if (this != &other) {
+      clear();
+      currentSize = other.currentSize;
+      head = other.head;
+      tail = other.tail;
+      allocation = other.allocation;
+      pool = std::move(other.pool);
+      filter = std::move(other.filter);
+      counter = other.counter;
+      other.forget();
+    }
+    return *this;
+  }
+
+  /**
+   * Replaces the nodes of this list with nodes holding a range of values, all
+   * carved from one slab allocated at once
+   *
+   * @tparam  ForwardIt  forward iterator over values convertible to Key
+   * @param   first      the value to become the front of this list
+   * @param   last       the end of the range
+   *
+   * @post    if successful, this list holds the values in range order and
+   *          obtains its nodes from its NodePool from now on, whatever its
+   *          allocation mode was. This list is empty if unsuccessful.
+   *
+   * @return  true if the values are held, false if memory could not be
+   *          allocated
+   */
+  template <typename ForwardIt> bool assign(ForwardIt first, ForwardIt last) {
+    return assign(first, last, ZeroHits());
+  }
+
+  /**
+   * Replaces the nodes of this list with nodes holding a range of values and
+   * their hit counts, all carved from one slab allocated at once
+   *
+   * @tparam  ForwardIt  forward iterator over values convertible to Key
+   * @tparam  HitIt      input iterator over values convertible to unsigned
+   * @param   first      the value to become the front of this list
+   * @param   last       the end of the range
+   * @param   hits       the hit count of the node of first, followed by the
+   *                     hit counts of the nodes of the other values
+   *
+   * @post    if successful, this list holds the values in range order with
+   *          their hit counts and obtains its nodes from its NodePool from
+   *          now on, whatever its allocation mode was. This list is empty if
+   *          unsuccessful.
+   *
+   * @return  true if the values are held, false if memory could not be
+   *          allocated
+   */
+  template <typename ForwardIt, typename HitIt>
+  bool assign(ForwardIt first, ForwardIt last, HitIt hits) {
+    clear();
+    std::size_t count = std::size_t(std::distance(first, last));
+    if (count == 0) {
+      return true;
+    }
+
+    if (count > std::size_t(INT_MAX) || !pool.reserve(int(count))) {
+      return false;
+    }
+    allocation = NodeAllocation::Pooled;
+
+    for (; first != last; ++first) {
+      NodeType *node = pool.allocate();
+      setItem(node, *first);
+      node->hits = unsigned(*hits);
+      ++hits;
+      node->next = nullptr;
+      if (tail == nullptr) {
+        head = node;
+      } else {
+        tail->next = node;
+      }
+      tail = node;
+    }
+    currentSize = int(count);
+    rebuildFilter();
+    return true;
+  }
+
+  /**
+   * Moves every node of another list to the end of this list in constant
+   * time, or in time proportional to the number of slabs of a pooled list
+   *
+   * @param   other  the list whose nodes are moved
+   *
+   * @pre     both lists must use the same allocation mode
+   *
+   * @post    if successful, other is empty and its values follow the values
+   *          of this list in their old order. No change in state if
+   *          unsuccessful.
+   *
+   * @return  true if successful, false if other is this list or uses another
+   *          allocation mode
+   */
+  bool append(SelfOrganizingList &other) {
+    if (!canJoin(other)) {
+      return false;
+    }
+
+    if (tail == nullptr) {
+      head = other.head;
+    } else {
+      tail->next = other.head;
+    }
+    tail = other.tail;
+    join(other);
+    return true;
+  }
+
+  /**
+   * Moves every node of another list to the front of this list in constant
+   * time, or in time proportional to the number of slabs of a pooled list
+   *
+   * @param   other  the list whose nodes are moved
+   *
+   * @pre     both lists must use the same allocation mode
+   *
+   * @post    if successful, other is empty and its values precede the values
+   *          of this list in their old order. No change in state if
+   *          unsuccessful.
+   *
+   * @return  true if successful, false if other is this list or uses another
+   *          allocation mode
+   */
+  bool splice(SelfOrganizingList &other) {
+    if (!canJoin(other)) {
+      return false;
+    }
+
+    if (other.head != nullptr) {
+      other.tail->next = head;
+      if (tail == nullptr) {
+        tail = other.tail;
+      }
+      head = other.head;
+    }
+    join(other);
+    return true;
+  }
+
+  /**
+   * Retrieves the current number of nodes in this list
+   *
+   * @return  the number of nodes in this list
+   */
+  int getCurrentSize() const { return currentSize; }
+
+  /**
+   * Determines if the number of nodes in this list is zero
+   *
+   * @return  true if this list has no nodes, false otherwise
+   */
+  bool isEmpty() const { return head == nullptr; }
+
+  /**
+   * Adds a new node with the specified value to the beginning of this list.
+   * Duplicate values are allowed.
+   *
+   * @param   newEntry  value to be added to the beginning of this list
+   *
+   * @post    if successful, the size of this list increases by 1 and the new
+   *          node is the front of this list. No change in state if
+   *          unsuccessful.
+   *
+   * @return  true if a new node is successfully added, false if memory could
+   *          not be allocated
+   */
+  bool add(const Key &newEntry) {
+    NodeType *newNode = allocateNode();
+    if (newNode == nullptr) {
+      return false;
+    }
+
+    std::uint64_t hash = needsHash() ? hashOf(newEntry) : 0;
+    setItem(newNode, newEntry, hash);
+    newNode->hits = 0;
+    newNode->next = head;
+    head = newNode;
+    if (tail == nullptr) {
+      tail = newNode;
+    }
+    currentSize++;
+    if (filter != nullptr) {
+      filter->add(hash);
+      refreshFilter();
+    }
+    return true;
+  }
+
+  /**
+   * Adds a new node with the specified value to the end of this list, where
+   * a list ordered by decreasing hit count keeps its never-found nodes.
+   * Duplicate values are allowed.
+   *
+   * @param   newEntry  value to be added to the end of this list
+   *
+   * @post    if successful, the size of this list increases by 1 and the new
+   *          node is the back of this list. No change in state if
+   *          unsuccessful.
+   *
+   * @return  true if a new node is successfully added, false if memory could
+   *          not be allocated
+   */
+  bool addLast(const Key &newEntry) {
+    NodeType *newNode = allocateNode();
+    if (newNode == nullptr) {
+      return false;
+    }
+
+    std::uint64_t hash = needsHash() ? hashOf(newEntry) : 0;
+    setItem(newNode, newEntry, hash);
+    newNode->hits = 0;
+    newNode->next = nullptr;
+    if (tail == nullptr) {
+      head = newNode;
+    } else {
+      tail->next = newNode;
+    }
+    tail = newNode;
+    currentSize++;
+    if (filter != nullptr) {
+      filter->add(hash);
+      refreshFilter();
+    }
+    return true;
+  }
+
+  /**
+   * Removes the first occurrence of a node holding the specified value
+   *
+   * @param   anEntry  the sought value held by a node to be removed
+   *
+   * @post    if successful, the size of this list decreases by 1 and the node
+   *          is deallocated. No change in state if unsuccessful.
+   *
+   * @return  true if a node is found with the specified value and removed,
+   *          false otherwise
+   */
+  bool remove(const Key &anEntry) {
+    std::uint64_t hash = needsHash() ? hashOf(anEntry) : 0;
+    if (filter != nullptr && !filter->mayContain(hash)) {
+      return false;
+    }
+    std::uint32_t fingerprint = fingerprintOf(hash);
+    NodeType *prevNode = nullptr;
+
+    for (NodeType *currNode = head; currNode != nullptr;
+         prevNode = currNode, currNode = currNode->next) {
+      if (matches(currNode, anEntry, fingerprint)) {
+        if (prevNode == nullptr) {
+          head = currNode->next;
+        } else {
+          prevNode->next = currNode->next;
+        }
+        if (currNode == tail) {
+          tail = prevNode;
+        }
+        releaseNode(currNode);
+        currentSize--;
+        refreshFilter();
+        return true;
+      }
+    }
+
+    return false;
+  }
+
+  /**
+   * Removes all nodes from this list. Heap nodes are deallocated one at a
+   * time, while pooled nodes are returned to the freestore slab by slab.
+   *
+   * @post    this list is empty and its size is 0
+   */
+  void clear() {
+    if (allocation == NodeAllocation::Pooled) {
+      // every node lives in a slab of the pool, so no walk is needed
+      pool.releaseAll();
+    } else {
+      NodeType *currNode = head;
+      while (currNode != nullptr) {
+        // obtains the reference for the next node to avoid dangling pointers
+        NodeType *nextNode = currNode->next;
+        delete currNode;
+        currNode = nextNode;
+      }
+    }
+
+    head = nullptr;
+    tail = nullptr;
+    currentSize = 0;
+    if (filter != nullptr) {
+      filter->clear();
+    }
+  }
+
+  /**
+   * Determines if the specified value is held by a node in this list and
+   * applies the promotion strategy to the node found
+   *
+   * @tparam  P        promotion strategy to apply, Policy unless overridden
+   * @param   anEntry  the sought value
+   *
+   * @post    the counter is told about every node traversed in the search for
+   *          the first occurrence of the value (even if not found). If found,
+   *          a default constructed P has been applied to its node.
+   *
+   * @return  true if the specified value is contained in this list, false
+   *          otherwise
+   */
+  template <typename P = Policy> bool contains(const Key &anEntry) {
+    return contains(anEntry, P());
+  }
+
+  /**
+   * Determines if the specified value is held by a node in this list and
+   * applies the given promotion strategy, which may carry runtime settings,
+   * to the node found
+   *
+   * @param   anEntry    the sought value
+   * @param   promotion  strategy whose onHit member is applied to the node
+   *                     found
+   *
+   * @post    the counter is told about every node traversed in the search for
+   *          the first occurrence of the value (even if not found) and about
+   *          the hit or miss. If found, promotion.onHit has been applied to
+   *          its node, which counts as a promotion if it rewrote any link.
+   *          With a filter, a value the filter rules out is a miss that
+   *          traverses nothing, and a miss it let through is counted as a
+   *          false positive.
+   *
+   * @return  true if the specified value is contained in this list, false
+   *          otherwise
+   */
+  template <typename P> bool contains(const Key &anEntry, const P &promotion) {
+    std::uint64_t hash = needsHash() ? hashOf(anEntry) : 0;
+    if (filter != nullptr && !filter->mayContain(hash)) {
+      counter.filtered(currentSize);
+      return false;
+    }
+    std::uint32_t fingerprint = fingerprintOf(hash);
+
+    NodeType *prevPrevNode = nullptr;
+    NodeType *prevNode = nullptr;
+    int position = 0;
+
+    for (NodeType *currNode = head; currNode != nullptr;
+         prevPrevNode = prevNode, prevNode = currNode,
+                  currNode = currNode->next, position++) {
+      if (matches(currNode, anEntry, fingerprint)) {
+        // every node looked into is recorded at once, so that the loop does
+        // not store to the counter on every iteration
+        counter.traversed(position + 1);
+        counter.hit(position + 1);
+        long long splicesBefore = counter.getSplices();
+        promotion.onHit(*this, prevPrevNode, prevNode, currNode, position);
+        if (counter.getSplices() != splicesBefore) {
+          counter.promoted();
+        }
+        return true;
+      }
+    }
+
+    counter.traversed(position);
+    counter.miss();
+    if (filter != nullptr) {
+      counter.falsePositive();
+    }
+    return false;
+  }
+
+  /**
+   * Sizes a BloomFilter for twice the current number of values and adds
+   * every value to it. From then on, add, remove and clear keep the filter
+   * up to date, rebuilding it once it is fuller than it was sized for or
+   * once removed values make up most of what was added, and contains
+   * answers most searches for absent values without a walk.
+   *
+   * @param   bitsPerKey  bits of filter per value it is sized for
+   *
+   * @post    if successful, any filter enabled before is replaced. No change
+   *          in state if unsuccessful.
+   *
+   * @return  true if successful, false if memory could not be allocated
+   */
+  bool enableFilter(int bitsPerKey = BloomFilter::DEFAULT_BITS_PER_KEY) {
+    std::unique_ptr<BloomFilter> fresh;
+    try {
+      fresh.reset(new BloomFilter(bitsPerKey));
+    }
+    // inability to allocate memory will throw a std::bad_alloc error
+    // which will be caught and signals a lack of success
+    catch (std::bad_alloc &exc) {
+      return false;
+    }
+    if (!fillFilter(*fresh)) {
+      return false;
+    }
+    filter = std::move(fresh);
+    return true;
+  }
+
+  /**
+   * Frees the BloomFilter, so that every search walks the list again
+   */
+  void disableFilter() { filter.reset(); }
+
+  /**
+   * Retrieves the BloomFilter of this list
+   *
+   * @return  the filter, or nullptr if none is enabled
+   */
+  const BloomFilter *getFilter() const { return filter.get(); }
+
+  /**
+   * Answers many membership queries with a single pass over the nodes, leaving
+   * the order of this list untouched. The queried values are hashed, and the
+   * pass stops as soon as every distinct value has been found.
+   *
+   * @param   keys  the sought values
+   * @param   n     number of sought values
+   * @param   out   set so that out[i] tells whether keys[i] is held
+   *
+   * @post    the counter is told about every node visited by the single pass
+   *
+   * @return  true if the queries were answered, false if memory for the
+   *          query index could not be allocated (out is then unchanged)
+   */
+  bool containsBatch(const Key *keys, std::size_t n, bool *out) {
+    return resolveBatch(keys, n, out, false);
+  }
+
+  /**
+   * Answers many membership queries with a single pass over the nodes, then
+   * reorders this list exactly as calling contains<MoveToFront> for each
+   * value in turn would have: the found values end up at the front, the most
+   * recently queried first, followed by the other nodes in their old order.
+   *
+   * @param   keys  the sought values, in the order they would be queried
+   * @param   n     number of sought values
+   * @param   out   set so that out[i] tells whether keys[i] is held
+   *
+   * @post    the counter is told about every node visited by the single pass
+   *
+   * @return  true if the queries were answered, false if memory for the
+   *          query index could not be allocated (out and the list are then
+   *          unchanged)
+   */
+  bool containsBatchMoveToFront(const Key *keys, std::size_t n, bool *out) {
+    return resolveBatch(keys, n, out, true);
+  }
+
+  /**
+   * Reorders the nodes by decreasing hit count in one stable merge sort, so
+   * nodes with as many hits keep their order, then divides every hit count
+   * by 2^decayShift so that old hits weigh less than recent ones
+   *
+   * @param   decayShift  number of bits every hit count is shifted right by
+   *
+   * @post    the counter records one promotion if the order changed
+   *
+   * @return  the average one-based position of a hit in the new order,
+   *          weighted by the hit counts before decay, or 0 if no node has
+   *          been hit
+   */
+  double sortByHits(unsigned decayShift) {
+    bool moved = false;
+    // bottom-up merge sort of runs of width 1, 2, 4, ... needs no memory
+    for (long long width = 1; width < currentSize; width *= 2) {
+      NodeType *rest = head;
+      NodeType *mergedTail = nullptr;
+      head = nullptr;
+      while (rest != nullptr) {
+        NodeType *left = rest;
+        NodeType *right = splitAfter(left, width);
+        rest = splitAfter(right, width);
+        while (left != nullptr || right != nullptr) {
+          // taking from the left on ties keeps the sort stable
+          NodeType *next = nullptr;
+          if (right == nullptr ||
+              (left != nullptr && left->hits >= right->hits)) {
+            next = left;
+            left = left->next;
+          } else {
+            moved = moved || left != nullptr;
+            next = right;
+            right = right->next;
+          }
+          if (mergedTail == nullptr) {
+            head = next;
+          } else {
+            mergedTail->next = next;
+          }
+          mergedTail = next;
+        }
+      }
+      mergedTail->next = nullptr;
+      tail = mergedTail;
+    }
+
+    if (moved) {
+      counter.promoted();
+    }
+
+    long long weighted = 0;
+    long long total = 0;
+    long long position = 1;
+    for (NodeType *currNode = head; currNode != nullptr;
+         currNode = currNode->next, position++) {
+      weighted += position * currNode->hits;
+      total += currNode->hits;
+      currNode->hits = decayShift < 32 ? currNode->hits >> decayShift : 0;
+    }
+    return total == 0 ? 0.0 : double(weighted) / double(total);
+  }
+
+  /**
+   * Copies every node into one newly allocated slab in the current list
+   * order and frees the old nodes, so that a walk from the front reads
+   * memory sequentially instead of in the order the nodes were allocated
+   *
+   * @post    if successful, the values, their order and their hit counts are
+   *          unchanged, every node pointer obtained before is invalid and
+   *          this list obtains its nodes from its NodePool from now on,
+   *          whatever its allocation mode was. No change in state if
+   *          unsuccessful.
+   *
+   * @return  true if successful, false if memory could not be allocated
+   */
+  bool relayout() {
+    if (head == nullptr) {
+      return true;
+    }
+
+    NodePool<NodeType> fresh;
+    if (!fresh.reserve(currentSize)) {
+      return false;
+    }
+
+    // nodes carved from one reserved slab have increasing addresses
+    NodeType *newHead = nullptr;
+    NodeType *newTail = nullptr;
+    for (NodeType *currNode = head; currNode != nullptr;
+         currNode = currNode->next) {
+      NodeType *node = fresh.allocate();
+      copyItem(node, currNode);
+      node->hits = currNode->hits;
+      node->next = nullptr;
+      if (newTail == nullptr) {
+        newHead = node;
+      } else {
+        newTail->next = node;
+      }
+      newTail = node;
+    }
+
+    // the values are unchanged, so the filter survives the clear
+    int size = currentSize;
+    std::unique_ptr<BloomFilter> kept = std::move(filter);
+    clear();
+    filter = std::move(kept);
+    pool = std::move(fresh);
+    allocation = NodeAllocation::Pooled;
+    head = newHead;
+    tail = newTail;
+    currentSize = size;
+    return true;
+  }
+
+  /**
+   * Retrieves the number of nodes traversed since the last reset
+   *
+   * @return  the count kept by the counter, always 0 for NullTraverseCounter
+   */
+  long long getTraverseCount() const { return counter.get(); }
+
+  /**
+   * Retrieves everything recorded by the counter since the last reset
+   *
+   * @return  the statistics, all 0 for NullTraverseCounter
+   */
+  const ListStatistics &getStatistics() const { return counter.statistics(); }
+
+  /**
+   * Resets the count of nodes traversed, and all other statistics, to 0
+   */
+  void resetTraverseCount() { counter.reset(); }
+
+  /**
+   * Retrieves the first node of this list for read-only walks
+   *
+   * @return  the first node, or nullptr if this list is empty
+   */
+  const NodeType *front() const { return head; }
+
+  /**
+   * Splices out the node following the specified node without deallocating
+   * it. Used by promotion policies.
+   *
+   * @param   prevNode  the node before the node to splice out, or nullptr to
+   *                    splice out the first node
+   *
+   * @pre     the node to splice out must exist
+   */
+  void unlinkAfter(NodeType *prevNode) {
+    counter.spliced();
+    NodeType *node = prevNode == nullptr ? head : prevNode->next;
+    if (prevNode == nullptr) {
+      head = node->next;
+    } else {
+      prevNode->next = node->next;
+    }
+    if (node == tail) {
+      tail = prevNode;
+    }
+  }
+
+  /**
+   * Links a node that is not part of any list in as the first node of this
+   * list. Used by promotion policies.
+   *
+   * @param   node  the node to become the front of this list
+   */
+  void pushFront(NodeType *node) {
+    counter.spliced();
+    node->next = head;
+    head = node;
+    if (tail == nullptr) {
+      tail = node;
+    }
+  }
+
+  /**
+   * Links a node that is not part of any list in right after the specified
+   * node. Used by promotion policies.
+   *
+   * @param   prevNode  the node to precede the linked node, or nullptr to
+   *                    link the node in as the front of this list
+   * @param   node      the node to link in
+   */
+  void insertAfter(NodeType *prevNode, NodeType *node) {
+    if (prevNode == nullptr) {
+      pushFront(node);
+    } else {
+      counter.spliced();
+      node->next = prevNode->next;
+      prevNode->next = node;
+      if (prevNode == tail) {
+        tail = node;
+      }
+    }
+  }
+
+  /**
+   * Retrieves the first node of this list for policies that restructure it
+   *
+   * @return  the first node, or nullptr if this list is empty
+   */
+  NodeType *front() { return head; }
+
+private:
+  /** Fewest values a filter is sized for, so that small lists do not
+   * rebuild their filter on nearly every addition */
+  static const int MIN_FILTER_KEYS = 64;
+
+  /** Whether nodes keep a fingerprint of their value */
+  static constexpr bool FINGERPRINTED = !isInlineKey<Key>;
+
+  /** Hit counts of a range assigned without any, all 0 */
+  struct ZeroHits {
+    unsigned operator*() const { return 0; }
+    ZeroHits &operator++() { return *this; }
+  };
+
+  /** What a batch of queries knows about one distinct sought value */
+  struct BatchEntry {
+    /** Position of the last query for the value within the batch */
+    std::size_t lastQuery;
+    /** The first node holding the value, once the pass has reached it */
+    NodeType *node;
+    /** 1-based position of node when the pass reached it */
+    long long position;
+  };
+
+  /**
+   * Answers a batch of membership queries with one pass over the nodes
+   *
+   * @param   keys         the sought values
+   * @param   n            number of sought values
+   * @param   out          set so that out[i] tells whether keys[i] is held
+   * @param   moveToFront  true to reorder as sequential move-to-front
+   *                       queries would
+   *
+   * @return  true if the queries were answered, false if memory could not be
+   *          allocated
+   */
+  bool resolveBatch(const Key *keys, std::size_t n, bool *out,
+                    bool moveToFront) {
+    std::unordered_map<Key, BatchEntry> pending;
+    std::vector<BatchEntry *> found;
+    try {
+      pending.reserve(n);
+      for (std::size_t i = 0; i < n; i++) {
+        BatchEntry &entry = pending[keys[i]];
+        entry.lastQuery = i;
+        entry.node = nullptr;
+      }
+      found.reserve(pending.size());
+    }
+    // inability to allocate memory will throw a std::bad_alloc error
+    // which will be caught and signals a lack of success
+    catch (std::bad_alloc &exc) {
+      return false;
+    }
+
+    NodeType *prevNode = nullptr;
+    NodeType *currNode = head;
+    long long position = 0;
+    while (currNode != nullptr && found.size() < pending.size()) {
+      position++;
+      NodeType *nextNode = currNode->next;
+
+      auto match = pending.find(currNode->item);
+      if (match != pending.end() && match->second.node == nullptr) {
+        // only the first occurrence of a value answers its queries
+        match->second.node = currNode;
+        match->second.position = position;
+        found.push_back(&match->second);
+        if (moveToFront) {
+          // the node is linked back in at the front once the pass is done
+          unlinkAfter(prevNode);
+          currNode = nextNode;
+          continue;
+        }
+      }
+
+      prevNode = currNode;
+      currNode = nextNode;
+    }
+
+    counter.traversed(position);
+    for (std::size_t i = 0; i < n; i++) {
+      const BatchEntry &entry = pending.find(keys[i])->second;
+      out[i] = entry.node != nullptr;
+      if (out[i]) {
+        counter.hit(entry.position);
+      } else {
+        counter.miss();
+      }
+    }
+
+    if (moveToFront) {
+      // the value queried last must end up at the very front
+      std::sort(found.begin(), found.end(),
+                [](const BatchEntry *a, const BatchEntry *b) {
+                  return a->lastQuery < b->lastQuery;
+                });
+      for (BatchEntry *entry : found) {
+        pushFront(entry->node);
+      }
+    }
+
+    return true;
+  }
+
+  /**
+   * Determines whether the nodes of another list can be moved into this list
+   *
+   * @param   other  the list whose nodes would be moved
+   *
+   * @return  true if other is another list with the same allocation mode
+   */
+  bool canJoin(const SelfOrganizingList &other) const {
+    return this != &other && allocation == other.allocation;
+  }
+
+  /**
+   * Completes moving the nodes of another list, once they are linked into
+   * this list, by taking over their slabs and emptying the other list
+   *
+   * @param   other  the list whose nodes were linked in
+   */
+  void join(SelfOrganizingList &other) {
+    currentSize += other.currentSize;
+    if (allocation == NodeAllocation::Pooled) {
+      pool.adopt(other.pool);
+    }
+    other.forget();
+    if (other.filter != nullptr) {
+      other.filter->clear();
+    }
+    rebuildFilter();
+  }
+
+  /**
+   * Cuts a chain of nodes after its first count nodes
+   *
+   * @param   first  the first node of the chain, or nullptr
+   * @param   count  number of nodes to keep in the chain
+   *
+   * @return  the first node after the cut, or nullptr if the chain has no
+   *          more than count nodes
+   */
+  static NodeType *splitAfter(NodeType *first, long long count) {
+    for (long long i = 1; first != nullptr && i < count; i++) {
+      first = first->next;
+    }
+    if (first == nullptr) {
+      return nullptr;
+    }
+    NodeType *rest = first->next;
+    first->next = nullptr;
+    return rest;
+  }
+
+  /**
+   * Drops every reference to nodes without freeing them, once another list
+   * has taken them over
+   */
+  void forget() {
+    currentSize = 0;
+    head = nullptr;
+    tail = nullptr;
+  }
+
+  /**
+   * Hashes a value for the BloomFilter
+   *
+   * @param   anEntry  the value
+   *
+   * @return  the mixed hash
+   */
+  static std::uint64_t hashOf(const Key &anEntry) {
+    return BloomFilter::mix(std::uint64_t(std::hash<Key>()(anEntry)));
+  }
+
+  /**
+   * Determines whether a search or change must hash its value, for the
+   * fingerprints or for the filter
+   */
+  bool needsHash() const { return FINGERPRINTED || filter != nullptr; }
+
+  /**
+   * Folds a mixed hash into the fingerprint kept by a node. Both halves are
+   * folded in, since the filter picks its bits from each of them.
+   */
+  static std::uint32_t fingerprintOf(std::uint64_t hash) {
+    return std::uint32_t(hash ^ (hash >> 32));
+  }
+
+  /**
+   * Determines whether a node holds a value, comparing the values only when
+   * the fingerprints match
+   *
+   * @param   node         the node
+   * @param   anEntry      the sought value
+   * @param   fingerprint  fingerprint of anEntry, ignored for inline keys
+   */
+  static bool matches(const NodeType *node, const Key &anEntry,
+                      std::uint32_t fingerprint) {
+    if constexpr (FINGERPRINTED) {
+      return node->fingerprint == fingerprint && node->item == anEntry;
+    } else {
+      return node->item == anEntry;
+    }
+  }
+
+  /**
+   * Stores a value, and its fingerprint unless it is an inline key, in a node
+   *
+   * @param   node     the node
+   * @param   value    the value
+   * @param   hash     hashOf(value), if already known to the caller
+   */
+  static void setItem(NodeType *node, const Key &value, std::uint64_t hash) {
+    node->item = value;
+    if constexpr (FINGERPRINTED) {
+      node->fingerprint = fingerprintOf(hash);
+    }
+  }
+
+  /**
+   * Stores a value, hashing it for its fingerprint unless it is an inline
+   * key, in a node
+   */
+  static void setItem(NodeType *node, const Key &value) {
+    setItem(node, value, FINGERPRINTED ? hashOf(value) : 0);
+  }
+
+  /**
+   * Copies the value and fingerprint of one node into another
+   */
+  static void copyItem(NodeType *node, const NodeType *source) {
+    node->item = source->item;
+    if constexpr (FINGERPRINTED) {
+      node->fingerprint = source->fingerprint;
+    }
+  }
+
+  /**
+   * Sizes a filter for twice the current number of values and adds every
+   * value to it
+   *
+   * @param   target  the filter to fill
+   *
+   * @return  true if successful, false if memory could not be allocated
+   *          (target is then unchanged)
+   */
+  bool fillFilter(BloomFilter &target) const {
+    long long keys = std::max(2LL * currentSize, (long long)MIN_FILTER_KEYS);
+    if (!target.reset(keys)) {
+      return false;
+    }
+    for (const NodeType *currNode = head; currNode != nullptr;
+         currNode = currNode->next) {
+      target.add(hashOf(currNode->item));
+    }
+    return true;
+  }
+
+  /**
+   * Rebuilds the filter once it is fuller than it was sized for, or once
+   * removed values make up most of what was added to it. Between rebuilds
+   * every value held is in the filter, so a failed rebuild only leaves it
+   * less selective.
+   */
+  void refreshFilter() {
+    if (filter == nullptr) {
+      return;
+    }
+    long long insertions = filter->getInsertions();
+    long long removed = insertions - currentSize;
+    if (insertions > filter->getCapacity() ||
+        removed > currentSize / 2 + MIN_FILTER_KEYS) {
+      fillFilter(*filter);
+    }
+  }
+
+  /**
+   * Rebuilds the filter after values arrived without being added to it. The
+   * filter is freed if it can not be rebuilt, since it would rule out values
+   * that are held.
+   */
+  void rebuildFilter() {
+    if (filter != nullptr && !fillFilter(*filter)) {
+      filter.reset();
+    }
+  }
+
+  /**
+   * Obtains memory for a new node according to the allocation mode
+   *
+   * @return  address of the node, or nullptr if memory could not be
+   *          allocated
+   */
+  NodeType *allocateNode() {
+    if (allocation == NodeAllocation::Pooled) {
+      return pool.allocate();
+    }
+
+    try {
+      return new NodeType;
+    }
+    // inability to allocate memory will throw a std::bad_alloc error
+    // which will be caught and signals a lack of success
+    catch (std::bad_alloc &exc) {
+      return nullptr;
+    }
+  }
+
+  /**
+   * Gives back the memory of a node that is no longer part of this list.
+   * Pooled nodes are kept on the free list of the NodePool for reuse.
+   *
+   * @param   node  node previously obtained from allocateNode()
+   */
+  void releaseNode(NodeType *node) {
+    if (allocation == NodeAllocation::Pooled) {
+      pool.release(node);
+    } else {
+      delete node;
+    }
+  }
+
+  /** The current number of nodes in this list. */
+  int currentSize;
+  /** Reference to the address of the first node in this list, otherwise
+   * nullptr. */
+  NodeType *head;
+  /** Reference to the address of the last node in this list, otherwise
+   * nullptr. */
+  NodeType *tail;
+  /** Where the nodes of this list are allocated from. */
+  NodeAllocation allocation;
+  /** Slabs supplying nodes when allocation is NodeAllocation::Pooled. */
+  NodePool<NodeType> pool;
+  /** Values held, for searches of absent values; nullptr if disabled. */
+  std::unique_ptr<BloomFilter> filter;
+  /** Instrumentation told about every node traversed by contains. */
+  Counter counter;
+}; // end SelfOrganizingList.h
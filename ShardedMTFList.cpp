@@ -0,0 +1,361 @@
+/**
+ * ShardedMTFList.cpp
+ *
+ * Implementations for the ShardedMTFList class, a set of independent
+ * "move-to-front" sublists, or shards, each holding the values whose hash
+ * picks it. Every operation holds the layout lock shared and the lock of its
+ * shard; a resize holds the layout lock exclusively and rebuilds every shard
+ * in one bulk assignment.
+ *
+ * Joshua Scheck
+ * 2020-10-18
+ */
+
+#include "ShardedMTFList.h"
+#include "BloomFilter.h"
+#include <algorithm>
+#include <cstdint>
+#include <new>
+
+/**
+ * Constructor for this ShardedMTFList class. Initializes an empty
+ * ShardedMTFList that does not grow its number of shards by itself.
+ *
+ * @param   shardCount  number of shards, clamped to 1..MAX_SHARDS
+ */
+ShardedMTFList::ShardedMTFList(int shardCount)
+    : currentSize(0), growthThreshold(0) {
+  // a list without shards could hold nothing, so failing to create the
+  // requested number falls back on a single shard
+  if (!createShards(std::max(1, std::min(shardCount, MAX_SHARDS)), shards)) {
+    createShards(1, shards);
+  }
+}
+
+/**
+ * Destructor for this ShardedMTFList class that frees every shard.
+ *
+ * @pre     no other thread is using this ShardedMTFList
+ */
+ShardedMTFList::~ShardedMTFList() {}
+
+/**
+ * Retrieves the current number of Nodes in every shard
+ *
+ * @return  the number of Nodes, which may change as soon as it is returned
+ */
+int ShardedMTFList::getCurrentSize() const {
+  return currentSize.load(std::memory_order_relaxed);
+}
+
+/**
+ * Determines if no shard holds a Node
+ *
+ * @return  true if the list was empty when checked, false otherwise
+ */
+bool ShardedMTFList::isEmpty() const { return getCurrentSize() == 0; }
+
+/**
+ * Adds a new Node with the specified value to the front of its shard.
+ * Duplicate integer values are allowed. With growth enabled, the values are
+ * then spread over twice as many shards once the shards hold more than their
+ * share on average.
+ *
+ * @param   newEntry integer value to be added
+ *
+ * @post             if successful, the size of this ShardedMTFList increases
+ * by 1 and the new Node is the front of its shard.
+ *
+ * @return           true if a new Node is successfully added, false if memory
+ *                   could not be allocated
+ */
+bool ShardedMTFList::add(int newEntry) {
+  std::size_t shardCount;
+  int size;
+  {
+    std::shared_lock<std::shared_mutex> layout(layoutLock);
+    shardCount = shards.size();
+    Shard &shard = *shards[shardOf(newEntry, shardCount)];
+    std::lock_guard<std::mutex> guard(shard.lock);
+    if (!shard.nodes.add(newEntry)) {
+      return false;
+    }
+    // counted under the locks, so a clear() cannot slip in between the add
+    // and the count
+    size = currentSize.fetch_add(1, std::memory_order_relaxed) + 1;
+  }
+
+  // the shards are grown once no lock is held, since growing needs the
+  // layout lock exclusively
+  int threshold = growthThreshold.load(std::memory_order_relaxed);
+  if (threshold > 0 && shardCount < std::size_t(MAX_SHARDS) &&
+      (long long)size > (long long)threshold * (long long)shardCount) {
+    grow();
+  }
+  return true;
+}
+
+/**
+ * Removes the first occurrence of a Node containing the specified integer
+ * from its shard
+ *
+ * @param   anEntry  the sought integer value to be removed
+ *
+ * @return           true if a Node is found and removed, false otherwise
+ */
+bool ShardedMTFList::remove(int anEntry) {
+  std::shared_lock<std::shared_mutex> layout(layoutLock);
+  Shard &shard = *shards[shardOf(anEntry, shards.size())];
+  std::lock_guard<std::mutex> guard(shard.lock);
+  if (!shard.nodes.remove(anEntry)) {
+    return false;
+  }
+  currentSize.fetch_sub(1, std::memory_order_relaxed);
+  return true;
+}
+
+/**
+ * Removes all entries from every shard, keeping the number of shards
+ *
+ * @post    the list is empty and its size is 0
+ */
+void ShardedMTFList::clear() {
+  std::unique_lock<std::shared_mutex> layout(layoutLock);
+  for (std::unique_ptr<Shard> &shard : shards) {
+    shard->nodes.clear();
+  }
+  currentSize.store(0, std::memory_order_relaxed);
+}
+
+/**
+ * Determines if the specified integer value is held by a Node of its shard,
+ * then moves the found Node to the front of that shard
+ *
+ * @param   anEntry  the sought integer value
+ *
+ * @post             the traversal count of the shard is incremented by 1 with
+ * each Node of the shard traversed in the search for the first occurrence of
+ * the value (even if not found).
+ *
+ * @return           true if the specified integer value is contained in this
+ *                   ShardedMTFList, false otherwise
+ */
+bool ShardedMTFList::contains(int anEntry) {
+  std::shared_lock<std::shared_mutex> layout(layoutLock);
+  Shard &shard = *shards[shardOf(anEntry, shards.size())];
+  std::lock_guard<std::mutex> guard(shard.lock);
+  return shard.nodes.contains(anEntry);
+}
+
+/**
+ * Retrieves the number of Nodes traversed in every shard since the last
+ * reset, including shards replaced by a resize
+ *
+ * @return  the summed traversal counts
+ */
+long long ShardedMTFList::getTraverseCount() const {
+  return getStatistics().traversals;
+}
+
+/**
+ * Retrieves the statistics of every shard since the last reset, including
+ * shards replaced by a resize
+ *
+ * @return  the summed statistics
+ */
+ListStatistics ShardedMTFList::getStatistics() const {
+  std::shared_lock<std::shared_mutex> layout(layoutLock);
+  ListStatistics stats = retired;
+  for (const std::unique_ptr<Shard> &shard : shards) {
+    std::lock_guard<std::mutex> guard(shard->lock);
+    stats += shard->nodes.getStatistics();
+  }
+  return stats;
+}
+
+/**
+ * Resets the statistics of every shard to 0
+ */
+void ShardedMTFList::resetTraverseCount() {
+  std::unique_lock<std::shared_mutex> layout(layoutLock);
+  retired = ListStatistics();
+  for (std::unique_ptr<Shard> &shard : shards) {
+    shard->nodes.resetTraverseCount();
+  }
+}
+
+/**
+ * Retrieves the number of shards the values are spread over
+ *
+ * @return  the number of shards
+ */
+int ShardedMTFList::getShardCount() const {
+  std::shared_lock<std::shared_mutex> layout(layoutLock);
+  return int(shards.size());
+}
+
+/**
+ * Retrieves the number of Nodes held by one shard
+ *
+ * @param   shard  index of the shard, 0 up to getShardCount()
+ *
+ * @return  the number of Nodes, 0 for an index out of range
+ */
+int ShardedMTFList::getShardSize(int shard) const {
+  std::shared_lock<std::shared_mutex> layout(layoutLock);
+  if (shard < 0 || std::size_t(shard) >= shards.size()) {
+    return 0;
+  }
+  std::lock_guard<std::mutex> guard(shards[shard]->lock);
+  return shards[shard]->nodes.getCurrentSize();
+}
+
+/**
+ * Retrieves the statistics of one shard since the last reset or the resize
+ * that created it
+ *
+ * @param   shard  index of the shard, 0 up to getShardCount()
+ *
+ * @return  the statistics, all 0 for an index out of range
+ */
+ListStatistics ShardedMTFList::getShardStatistics(int shard) const {
+  std::shared_lock<std::shared_mutex> layout(layoutLock);
+  if (shard < 0 || std::size_t(shard) >= shards.size()) {
+    return ListStatistics();
+  }
+  std::lock_guard<std::mutex> guard(shards[shard]->lock);
+  return shards[shard]->nodes.getStatistics();
+}
+
+/**
+ * Spreads the values over a new number of shards. Within each new shard,
+ * values keep the order they had in their old shard, so learned locality is
+ * carried over.
+ *
+ * @param   shardCount  the new number of shards, clamped to 1..MAX_SHARDS
+ *
+ * @post    if successful, every value is in the shard its hash picks among
+ *          the new shards. No change in state if unsuccessful.
+ *
+ * @return  true if successful, false if memory could not be allocated
+ */
+bool ShardedMTFList::resize(int shardCount) {
+  std::unique_lock<std::shared_mutex> layout(layoutLock);
+  return reshard(std::max(1, std::min(shardCount, MAX_SHARDS)));
+}
+
+/**
+ * Spreads the values over a new number of shards. The caller holds the layout
+ * lock exclusively.
+ *
+ * @param   shardCount  the new number of shards, 1..MAX_SHARDS
+ *
+ * @return  true if successful, false if memory could not be allocated
+ */
+bool ShardedMTFList::reshard(int shardCount) {
+  if (std::size_t(shardCount) == shards.size()) {
+    return true;
+  }
+
+  std::vector<std::unique_ptr<Shard>> resized;
+  if (!createShards(shardCount, resized)) {
+    return false;
+  }
+  try {
+    // the values of every new shard are gathered in order first, so each
+    // shard is then built in one slab by a single assignment
+    std::vector<std::vector<int>> values(resized.size());
+    for (const std::unique_ptr<Shard> &shard : shards) {
+      for (const Node *currNode = shard->nodes.front(); currNode != nullptr;
+           currNode = currNode->next) {
+        values[shardOf(currNode->item, values.size())].push_back(
+            currNode->item);
+      }
+    }
+    for (int i = 0; i < shardCount; i++) {
+      if (!resized[i]->nodes.assign(values[i].begin(), values[i].end())) {
+        return false;
+      }
+    }
+  }
+  // inability to allocate memory will throw a std::bad_alloc error
+  // which will be caught and signals a lack of success
+  catch (std::bad_alloc &exc) {
+    return false;
+  }
+
+  for (const std::unique_ptr<Shard> &shard : shards) {
+    retired += shard->nodes.getStatistics();
+  }
+  shards.swap(resized);
+  return true;
+}
+
+/**
+ * Enables or disables growth: once the shards hold more than the given number
+ * of values on average, add spreads the values over twice as many shards, up
+ * to MAX_SHARDS
+ *
+ * @param   valuesPerShard  average number of values per shard that triggers
+ *                          growth; 0 disables growth
+ */
+void ShardedMTFList::setGrowth(int valuesPerShard) {
+  growthThreshold.store(std::max(0, valuesPerShard),
+                        std::memory_order_relaxed);
+}
+
+/**
+ * Picks the shard of a value
+ *
+ * @param   anEntry     the value
+ * @param   shardCount  number of shards to pick from
+ *
+ * @return  index of the shard
+ */
+int ShardedMTFList::shardOf(int anEntry, std::size_t shardCount) {
+  // neighbouring values land in unrelated shards, and the upper bits of the
+  // hash map onto the shards without a division
+  std::uint64_t hash = BloomFilter::mix(std::uint64_t(std::uint32_t(anEntry)));
+  return int(((hash >> 32) * shardCount) >> 32);
+}
+
+/**
+ * Creates shards
+ *
+ * @param   shardCount  number of shards
+ * @param   created     receives the shards
+ *
+ * @return  true if successful, false if memory could not be allocated
+ */
+bool ShardedMTFList::createShards(
+    int shardCount, std::vector<std::unique_ptr<Shard>> &created) {
+  try {
+    std::vector<std::unique_ptr<Shard>> fresh;
+    fresh.reserve(std::size_t(shardCount));
+    for (int i = 0; i < shardCount; i++) {
+      fresh.emplace_back(new Shard);
+    }
+    created.swap(fresh);
+  }
+  // inability to allocate memory will throw a std::bad_alloc error
+  // which will be caught and signals a lack of success
+  catch (std::bad_alloc &exc) {
+    return false;
+  }
+  return true;
+}
+
+/**
+ * Doubles the number of shards if the shards still hold more than their share
+ * after another thread may have grown them already
+ */
+void ShardedMTFList::grow() {
+  std::unique_lock<std::shared_mutex> layout(layoutLock);
+  long long shardCount = (long long)shards.size();
+  long long threshold = growthThreshold.load(std::memory_order_relaxed);
+  if (threshold > 0 && shardCount < MAX_SHARDS &&
+      getCurrentSize() > threshold * shardCount) {
+    // a failed reshard keeps the current shards, which still hold every value
+    reshard(int(shardCount * 2));
+  }
+} // end ShardedMTFList.cpp
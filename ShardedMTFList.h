@@ -0,0 +1,246 @@
+/**
+ * ShardedMTFList.h
+ *
+ * Declarations for the ShardedMTFList class, a set of independent
+ * "move-to-front" sublists, or shards, each holding the values whose hash
+ * picks it. A search walks only the shard of its value, so with K shards the
+ * expected walk is about K times shorter, while each shard still moves the
+ * values it finds to its own front. Every shard has its own lock and its own
+ * counters, so threads seeking values of different shards do not contend;
+ * a reader-writer lock over the set of shards is only held exclusively while
+ * the values are spread over a new number of shards, which can happen
+ * automatically as the list grows.
+ *
+ * Joshua Scheck
+ * 2020-10-18
+ */
+
+#pragma once
+#include "IList.h"
+#include "SelfOrganizingList.h"
+#include <atomic>
+#include <memory>
+#include <mutex>
+#include <shared_mutex>
+#include <vector>
+
+/**
+ * Represents a hash-sharded move-to-front list that is the subclass of IList
+ */
+class ShardedMTFList : public IList {
+public:
+  /** Number of shards when no other count is requested */
+  static constexpr int DEFAULT_SHARDS = 16;
+  /** Most shards a list is spread over */
+  static constexpr int MAX_SHARDS = 1 << 16;
+
+  /**
+   * Constructor for this ShardedMTFList class. Initializes an empty
+   * ShardedMTFList that does not grow its number of shards by itself.
+   *
+   * @param   shardCount  number of shards, clamped to 1..MAX_SHARDS
+   */
+  explicit ShardedMTFList(int shardCount = DEFAULT_SHARDS);
+
+  /**
+   * Destructor for this ShardedMTFList class that frees every shard.
+   *
+   * @pre     no other thread is using this ShardedMTFList
+   */
+  ~ShardedMTFList() override;
+
+  ShardedMTFList(const ShardedMTFList &) = delete;
+  ShardedMTFList &operator=(const ShardedMTFList &) = delete;
+
+  /**
+   * Retrieves the current number of Nodes in every shard
+   *
+   * @return  the number of Nodes, which may change as soon as it is returned
+   */
+  int getCurrentSize() const override;
+
+  /**
+   * Determines if no shard holds a Node
+   *
+   * @return  true if the list was empty when checked, false otherwise
+   */
+  bool isEmpty() const override;
+
+  /**
+   * Adds a new Node with the specified value to the front of its shard.
+   * Duplicate integer values are allowed. With growth enabled, the values are
+   * then spread over twice as many shards once the shards hold more than
+   * their share on average.
+   *
+   * @param   newEntry integer value to be added
+   *
+   * @post             if successful, the size of this ShardedMTFList
+   * increases by 1 and the new Node is the front of its shard.
+   *
+   * @return           true if a new Node is successfully added, false if
+   *                   memory could not be allocated
+   */
+  bool add(int newEntry) override;
+
+  /**
+   * Removes the first occurrence of a Node containing the specified integer
+   * from its shard
+   *
+   * @param   anEntry  the sought integer value to be removed
+   *
+   * @return           true if a Node is found and removed, false otherwise
+   */
+  bool remove(int anEntry) override;
+
+  /**
+   * Removes all entries from every shard, keeping the number of shards
+   *
+   * @post    the list is empty and its size is 0
+   */
+  void clear() override;
+
+  /**
+   * Determines if the specified integer value is held by a Node of its shard,
+   * then moves the found Node to the front of that shard
+   *
+   * @param   anEntry  the sought integer value
+   *
+   * @post             the traversal count of the shard is incremented by 1
+   * with each Node of the shard traversed in the search for the first
+   * occurrence of the value (even if not found).
+   *
+   * @return           true if the specified integer value is contained in
+   *                   this ShardedMTFList, false otherwise
+   */
+  bool contains(int anEntry) override;
+
+  /**
+   * Retrieves the number of Nodes traversed in every shard since the last
+   * reset, including shards replaced by a resize
+   *
+   * @return  the summed traversal counts
+   */
+  long long getTraverseCount() const override;
+
+  /**
+   * Retrieves the statistics of every shard since the last reset, including
+   * shards replaced by a resize
+   *
+   * @return  the summed statistics
+   */
+  ListStatistics getStatistics() const override;
+
+  /**
+   * Resets the statistics of every shard to 0
+   */
+  void resetTraverseCount() override;
+
+  /**
+   * Retrieves the number of shards the values are spread over
+   *
+   * @return  the number of shards
+   */
+  int getShardCount() const;
+
+  /**
+   * Retrieves the number of Nodes held by one shard
+   *
+   * @param   shard  index of the shard, 0 up to getShardCount()
+   *
+   * @return  the number of Nodes, 0 for an index out of range
+   */
+  int getShardSize(int shard) const;
+
+  /**
+   * Retrieves the statistics of one shard since the last reset or the resize
+   * that created it
+   *
+   * @param   shard  index of the shard, 0 up to getShardCount()
+   *
+   * @return  the statistics, all 0 for an index out of range
+   */
+  ListStatistics getShardStatistics(int shard) const;
+
+  /**
+   * Spreads the values over a new number of shards. Within each new shard,
+   * values keep the order they had in their old shard, so learned locality
+   * is carried over.
+   *
+   * @param   shardCount  the new number of shards, clamped to 1..MAX_SHARDS
+   *
+   * @post    if successful, every value is in the shard its hash picks among
+   *          the new shards. No change in state if unsuccessful.
+   *
+   * @return  true if successful, false if memory could not be allocated
+   */
+  bool resize(int shardCount);
+
+  /**
+   * Enables or disables growth: once the shards hold more than the given
+   * number of values on average, add spreads the values over twice as many
+   * shards, up to MAX_SHARDS
+   *
+   * @param   valuesPerShard  average number of values per shard that
+   *                          triggers growth; 0 disables growth
+   */
+  void setGrowth(int valuesPerShard);
+
+private:
+  /** A sublist with its own lock, alone on its cache lines so that threads
+   * using different shards do not share them */
+  struct alignas(64) Shard {
+    /** Serializes every use of nodes. */
+    mutable std::mutex lock;
+    /** The values of this shard in move-to-front order. */
+    SelfOrganizingList<int, MoveToFront, ListCounter> nodes;
+  };
+
+  /**
+   * Picks the shard of a value
+   *
+   * @param   anEntry     the value
+   * @param   shardCount  number of shards to pick from
+   *
+   * @return  index of the shard
+   */
+  static int shardOf(int anEntry, std::size_t shardCount);
+
+  /**
+   * Creates shards
+   *
+   * @param   shardCount  number of shards
+   * @param   created     receives the shards
+   *
+   * @return  true if successful, false if memory could not be allocated
+   */
+  static bool createShards(int shardCount,
+                           std::vector<std::unique_ptr<Shard>> &created);
+
+  /**
+   * Spreads the values over a new number of shards. The caller holds the
+   * layout lock exclusively.
+   *
+   * @param   shardCount  the new number of shards, 1..MAX_SHARDS
+   *
+   * @return  true if successful, false if memory could not be allocated
+   */
+  bool reshard(int shardCount);
+
+  /**
+   * Doubles the number of shards if the shards still hold more than their
+   * share after another thread may have grown them already
+   */
+  void grow();
+
+  /** Held shared by every operation on a shard and exclusively while the
+   * shards are replaced. */
+  mutable std::shared_mutex layoutLock;
+  /** The shards. */
+  std::vector<std::unique_ptr<Shard>> shards;
+  /** Statistics of shards replaced by a resize since the last reset. */
+  ListStatistics retired;
+  /** The current number of Nodes in every shard. */
+  std::atomic<int> currentSize;
+  /** Average values per shard that triggers growth, 0 if disabled. */
+  std::atomic<int> growthThreshold;
+}; // end ShardedMTFList.h
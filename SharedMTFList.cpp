@@ -0,0 +1,566 @@
+/**
+ * SharedMTFList.cpp
+ *
+ * Implementations for the SharedMTFList class, a "move-to-front" list whose
+ * nodes live in a shared memory segment, so that several processes search and
+ * reorder one copy of the values. The segment starts with a header holding the
+ * links of the list and a robust process-shared mutex, followed by an array of
+ * CompactNodes linked by index. Nodes are handed out from the end of the used
+ * part of the array, or from a chain of removed Nodes, so memory is only
+ * committed as the list grows.
+ *
+ * Joshua Scheck
+ * 2020-10-18
+ */
+
+#include "SharedMTFList.h"
+#include <atomic>
+#include <cerrno>
+#include <chrono>
+#include <fcntl.h>
+#include <new>
+#include <pthread.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <thread>
+#include <unistd.h>
+#include <vector>
+
+namespace {
+
+/** Stored in a header once it is set up; a segment with any other value is
+ * not a SharedMTFList, or is still being created */
+const std::uint32_t SEGMENT_MAGIC = 0x4c4d4853;
+/** Layout version of a segment, raised whenever the header changes */
+const std::uint32_t SEGMENT_VERSION = 1;
+/** Number of times a process opening a named segment checks whether its
+ * creator has finished setting it up, 1 ms apart */
+const int ATTACH_ATTEMPTS = 1000;
+
+/**
+ * Rounds the size of the header up to a whole cache line, so that the nodes
+ * start on one
+ */
+constexpr std::size_t nodesOffset(std::size_t headerBytes) {
+  return (headerBytes + 63) / 64 * 64;
+}
+
+} // namespace
+
+/**
+ * The start of a segment, followed by the nodes. Everything but the counts
+ * read without the mutex is changed only while holding it.
+ */
+struct SharedMTFList::Header {
+  /** SEGMENT_MAGIC once the creator has set up the segment. */
+  std::atomic<std::uint32_t> ready;
+  /** Layout version, SEGMENT_VERSION. */
+  std::uint32_t version;
+  /** Number of nodes the segment holds. */
+  std::uint32_t capacity;
+  /** Number of nodes ever handed out; nodes past it are untouched. */
+  std::uint32_t used;
+  /** Index of the first Node, otherwise CompactNode::NONE. */
+  std::uint32_t head;
+  /** Index of the first removed Node, otherwise CompactNode::NONE. */
+  std::uint32_t freeHead;
+  /** The current number of Nodes. */
+  std::atomic<int> currentSize;
+  /** Times the links were repaired after a process died holding the mutex. */
+  std::atomic<int> repairs;
+  /** Serializes every operation of every process. */
+  pthread_mutex_t lock;
+};
+
+/**
+ * Holds the mutex of a segment for one scope, repairing the list first if the
+ * previous holder died
+ */
+class SharedMTFList::Guard {
+public:
+  /**
+   * Locks the mutex of a list's segment
+   *
+   * @param   owner  the list
+   *
+   * @post    isLocked() is true if the list is attached and its mutex could
+   *          be locked
+   */
+  explicit Guard(SharedMTFList &owner) : owner(owner), locked(false) {
+    if (owner.header == nullptr) {
+      return;
+    }
+    int status = pthread_mutex_lock(&owner.header->lock);
+    if (status == EOWNERDEAD) {
+      // the previous holder may have been part way through a change
+      owner.repair();
+      pthread_mutex_consistent(&owner.header->lock);
+      status = 0;
+    }
+    locked = status == 0;
+  }
+
+  /**
+   * Unlocks the mutex if it was locked
+   */
+  ~Guard() {
+    if (locked) {
+      pthread_mutex_unlock(&owner.header->lock);
+    }
+  }
+
+  Guard(const Guard &) = delete;
+  Guard &operator=(const Guard &) = delete;
+
+  /**
+   * Determines if the mutex is held
+   *
+   * @return  true if the list may be read and changed, false otherwise
+   */
+  bool isLocked() const { return locked; }
+
+private:
+  /** The list whose mutex is held. */
+  SharedMTFList &owner;
+  /** Whether the mutex is held. */
+  bool locked;
+};
+
+/**
+ * Constructor for this SharedMTFList class. Creates an empty list in an
+ * anonymous segment, shared with every process forked from this one
+ * afterwards. Memory is only committed as nodes are used.
+ *
+ * @param   capacity  number of nodes the segment holds
+ *
+ * @post    the list is attached if the segment could be created, otherwise it
+ *          is empty and every add fails
+ */
+SharedMTFList::SharedMTFList(int capacity)
+    : header(nullptr), mappedBytes(0) {
+  create(-1, capacity);
+}
+
+/**
+ * Constructor for this SharedMTFList class. Opens the named POSIX segment,
+ * creating it with an empty list if it does not exist yet.
+ *
+ * @param   name      name of the segment, a slash followed by up to 254
+ *                    characters other than slashes
+ * @param   capacity  number of nodes the segment holds if it is created; an
+ *                    existing segment keeps the capacity it was created with
+ *
+ * @post    the list is attached if the segment could be opened or created,
+ *          otherwise it is empty and every add fails
+ */
+SharedMTFList::SharedMTFList(const std::string &name, int capacity)
+    : header(nullptr), mappedBytes(0) {
+  // exactly one process wins the exclusive creation and sets the segment up;
+  // the others wait for it to finish
+  int fd = shm_open(name.c_str(), O_RDWR | O_CREAT | O_EXCL, 0600);
+  if (fd >= 0) {
+    if (!create(fd, capacity)) {
+      shm_unlink(name.c_str());
+    }
+  } else if (errno == EEXIST) {
+    fd = shm_open(name.c_str(), O_RDWR, 0);
+    if (fd >= 0) {
+      attach(fd);
+    }
+  }
+
+  // the mapping stays valid once the descriptor is closed
+  if (fd >= 0) {
+    close(fd);
+  }
+}
+
+/**
+ * Destructor for this SharedMTFList class that unmaps the segment. The nodes
+ * stay in the segment for the other processes using it; a named segment stays
+ * until it is unlinked.
+ */
+SharedMTFList::~SharedMTFList() {
+  if (header != nullptr) {
+    munmap(header, mappedBytes);
+  }
+}
+
+/**
+ * Removes a named segment, which is freed once every process has unmapped it.
+ * Processes that open the name afterwards get a new, empty list.
+ *
+ * @param   name  name of the segment
+ *
+ * @return  true if the segment was removed, false if there was none
+ */
+bool SharedMTFList::unlink(const std::string &name) {
+  return shm_unlink(name.c_str()) == 0;
+}
+
+/**
+ * Determines if this SharedMTFList has a segment to keep its nodes in
+ *
+ * @return  true if the segment was created or opened, false otherwise
+ */
+bool SharedMTFList::isAttached() const { return header != nullptr; }
+
+/**
+ * Retrieves the number of nodes the segment holds
+ *
+ * @return  the capacity, 0 if not attached
+ */
+int SharedMTFList::getCapacity() const {
+  return header == nullptr ? 0 : int(header->capacity);
+}
+
+/**
+ * Retrieves the current number of Nodes in this SharedMTFList
+ *
+ * @return  the number of Nodes, which another process may change as soon as it
+ *          is returned
+ */
+int SharedMTFList::getCurrentSize() const {
+  return header == nullptr
+             ? 0
+             : header->currentSize.load(std::memory_order_relaxed);
+}
+
+/**
+ * Determines if this SharedMTFList has no Nodes
+ *
+ * @return  true if the list was empty when checked, false otherwise
+ */
+bool SharedMTFList::isEmpty() const { return getCurrentSize() == 0; }
+
+/**
+ * Adds a new Node with the specified value to the beginning of this
+ * SharedMTFList. Duplicate integer values are allowed.
+ *
+ * @param   newEntry integer value to be added
+ *
+ * @post             if successful, the size of this SharedMTFList increases by
+ * 1 and the new Node is its front. No change in state if unsuccessful.
+ *
+ * @return           true if a new Node is successfully added, false if the
+ *                   segment is full or not attached
+ */
+bool SharedMTFList::add(int newEntry) {
+  Guard guard(*this);
+  if (!guard.isLocked()) {
+    return false;
+  }
+
+  std::uint32_t index = header->freeHead;
+  if (index != CompactNode::NONE) {
+    header->freeHead = nodeAt(index)->next;
+  } else if (header->used < header->capacity) {
+    index = header->used++;
+  } else {
+    return false;
+  }
+
+  CompactNode *newNode = nodeAt(index);
+  newNode->item = newEntry;
+  newNode->next = header->head;
+  header->head = index;
+  header->currentSize.fetch_add(1, std::memory_order_relaxed);
+  return true;
+}
+
+/**
+ * Removes the first occurrence of a Node containing the specified integer. The
+ * Node is kept in the segment for reuse.
+ *
+ * @param   anEntry  the sought integer value to be removed
+ *
+ * @return           true if a Node is found and removed, false otherwise
+ */
+bool SharedMTFList::remove(int anEntry) {
+  Guard guard(*this);
+  if (!guard.isLocked()) {
+    return false;
+  }
+
+  CompactNode *prevNode = nullptr;
+  for (std::uint32_t currIndex = header->head; currIndex != CompactNode::NONE;
+       currIndex = nodeAt(currIndex)->next) {
+    CompactNode *currNode = nodeAt(currIndex);
+    if (currNode->item == anEntry) {
+      if (prevNode == nullptr) {
+        header->head = currNode->next;
+      } else {
+        prevNode->next = currNode->next;
+      }
+      currNode->next = header->freeHead;
+      header->freeHead = currIndex;
+      header->currentSize.fetch_sub(1, std::memory_order_relaxed);
+      return true;
+    }
+    prevNode = currNode;
+  }
+
+  return false;
+}
+
+/**
+ * Removes all entries from this SharedMTFList, for every process using it
+ *
+ * @post    the list is empty and its size is 0
+ */
+void SharedMTFList::clear() {
+  Guard guard(*this);
+  if (!guard.isLocked()) {
+    return;
+  }
+
+  // every node is handed out anew, so the chain of removed Nodes is dropped
+  header->head = CompactNode::NONE;
+  header->freeHead = CompactNode::NONE;
+  header->used = 0;
+  header->currentSize.store(0, std::memory_order_relaxed);
+}
+
+/**
+ * Determines if the specified integer value is held by a Node in this
+ * SharedMTFList, then moves the found Node to the front
+ *
+ * @param   anEntry  the sought integer value
+ *
+ * @post             the traversal count of this process is incremented by 1
+ * with each Node traversed in the search for the first occurrence of the
+ * specified value (even if not found). If found, its Node is the front of the
+ * list for every process.
+ *
+ * @return           true if the specified integer value is contained in this
+ *                   SharedMTFList, false otherwise
+ */
+bool SharedMTFList::contains(int anEntry) {
+  Guard guard(*this);
+  if (!guard.isLocked()) {
+    return false;
+  }
+
+  CompactNode *prevNode = nullptr;
+  int position = 0;
+  for (std::uint32_t currIndex = header->head; currIndex != CompactNode::NONE;
+       currIndex = nodeAt(currIndex)->next) {
+    CompactNode *currNode = nodeAt(currIndex);
+    position++;
+    if (currNode->item == anEntry) {
+      counter.traversed(position);
+      counter.hit(position);
+      if (prevNode != nullptr) {
+        // the found Node is spliced out and becomes the new front
+        prevNode->next = currNode->next;
+        currNode->next = header->head;
+        header->head = currIndex;
+        counter.spliced();
+        counter.spliced();
+        counter.promoted();
+      }
+      return true;
+    }
+    prevNode = currNode;
+  }
+
+  counter.traversed(position);
+  counter.miss();
+  return false;
+}
+
+/**
+ * Retrieves the number of nodes traversed since the last time the count was
+ * reset in this SharedMTFList.
+ *
+ * @post    state of this SharedMTFList does not change
+ *
+ * @return  the number of Nodes traversed
+ */
+long long SharedMTFList::getTraverseCount() const { return counter.get(); }
+
+/**
+ * Retrieves everything recorded about this SharedMTFList since the last reset
+ *
+ * @post    state of this SharedMTFList does not change
+ *
+ * @return  traversals, hits, misses, the histogram of hit positions,
+ *          promotions and splices, all 0 if instrumentation is compiled out
+ */
+ListStatistics SharedMTFList::getStatistics() const {
+  return counter.statistics();
+}
+
+/**
+ * Resets the count of Nodes traversed in this SharedMTFList
+ *
+ * @post sets the traversal count and all other statistics to 0
+ */
+void SharedMTFList::resetTraverseCount() { counter.reset(); }
+
+/**
+ * Retrieves the number of times a process died while changing the list and the
+ * links were repaired, since the segment was created
+ *
+ * @return  the number of repairs
+ */
+int SharedMTFList::getRepairCount() const {
+  return header == nullptr ? 0
+                           : header->repairs.load(std::memory_order_relaxed);
+}
+
+/**
+ * Creates a new anonymous or named segment
+ *
+ * @param   fd        descriptor of a named segment, or -1 for an anonymous
+ *                    segment
+ * @param   capacity  number of nodes the segment holds
+ *
+ * @return  true if successful, false otherwise
+ */
+bool SharedMTFList::create(int fd, int capacity) {
+  if (capacity < 1 || std::uint32_t(capacity) >= CompactNode::NONE) {
+    return false;
+  }
+  std::size_t bytes = nodesOffset(sizeof(Header)) +
+                      std::size_t(capacity) * sizeof(CompactNode);
+  if (fd >= 0 && ftruncate(fd, off_t(bytes)) != 0) {
+    return false;
+  }
+
+  int flags = fd >= 0 ? MAP_SHARED : MAP_SHARED | MAP_ANONYMOUS;
+  void *memory = mmap(nullptr, bytes, PROT_READ | PROT_WRITE, flags, fd, 0);
+  if (memory == MAP_FAILED) {
+    return false;
+  }
+
+  Header *newHeader = new (memory) Header;
+  newHeader->version = SEGMENT_VERSION;
+  newHeader->capacity = std::uint32_t(capacity);
+  newHeader->used = 0;
+  newHeader->head = CompactNode::NONE;
+  newHeader->freeHead = CompactNode::NONE;
+  newHeader->currentSize.store(0, std::memory_order_relaxed);
+  newHeader->repairs.store(0, std::memory_order_relaxed);
+
+  pthread_mutexattr_t attributes;
+  pthread_mutexattr_init(&attributes);
+  pthread_mutexattr_setpshared(&attributes, PTHREAD_PROCESS_SHARED);
+  pthread_mutexattr_setrobust(&attributes, PTHREAD_MUTEX_ROBUST);
+  int status = pthread_mutex_init(&newHeader->lock, &attributes);
+  pthread_mutexattr_destroy(&attributes);
+  if (status != 0) {
+    munmap(memory, bytes);
+    return false;
+  }
+
+  // processes opening the segment by name see every field above once they
+  // see the magic number
+  newHeader->ready.store(SEGMENT_MAGIC, std::memory_order_release);
+  header = newHeader;
+  mappedBytes = bytes;
+  return true;
+}
+
+/**
+ * Maps an existing named segment once its creator has finished setting it up
+ *
+ * @param   fd  descriptor of the segment
+ *
+ * @return  true if successful, false otherwise
+ */
+bool SharedMTFList::attach(int fd) {
+  // the creator sizes the segment before setting it up, so a segment still
+  // of size 0 has just been created
+  struct stat status;
+  int attempt = 0;
+  for (;; attempt++) {
+    if (fstat(fd, &status) != 0) {
+      return false;
+    }
+    if (std::size_t(status.st_size) >= nodesOffset(sizeof(Header))) {
+      break;
+    }
+    if (attempt == ATTACH_ATTEMPTS) {
+      return false;
+    }
+    std::this_thread::sleep_for(std::chrono::milliseconds(1));
+  }
+
+  std::size_t bytes = std::size_t(status.st_size);
+  void *memory =
+      mmap(nullptr, bytes, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+  if (memory == MAP_FAILED) {
+    return false;
+  }
+
+  Header *theHeader = static_cast<Header *>(memory);
+  while (theHeader->ready.load(std::memory_order_acquire) != SEGMENT_MAGIC &&
+         attempt++ < ATTACH_ATTEMPTS) {
+    std::this_thread::sleep_for(std::chrono::milliseconds(1));
+  }
+  if (theHeader->ready.load(std::memory_order_acquire) != SEGMENT_MAGIC ||
+      theHeader->version != SEGMENT_VERSION ||
+      nodesOffset(sizeof(Header)) +
+              std::size_t(theHeader->capacity) * sizeof(CompactNode) >
+          bytes) {
+    munmap(memory, bytes);
+    return false;
+  }
+
+  header = theHeader;
+  mappedBytes = bytes;
+  return true;
+}
+
+/**
+ * Rebuilds the size and free nodes from the Nodes reachable from the front,
+ * after a process died holding the mutex. The caller holds the mutex.
+ */
+void SharedMTFList::repair() {
+  // a change cut short leaves every link pointing at a handed out node, but
+  // may leave a Node out of the list or a removed Node out of the free chain;
+  // the list is kept as far as it is reachable and the rest is freed
+  std::vector<bool> reached(header->used, false);
+  int size = 0;
+  CompactNode *prevNode = nullptr;
+  std::uint32_t currIndex = header->head;
+  while (currIndex != CompactNode::NONE) {
+    if (currIndex >= header->used || reached[currIndex]) {
+      // a link out of range or back into the list ends it there
+      if (prevNode == nullptr) {
+        header->head = CompactNode::NONE;
+      } else {
+        prevNode->next = CompactNode::NONE;
+      }
+      break;
+    }
+    reached[currIndex] = true;
+    size++;
+    prevNode = nodeAt(currIndex);
+    currIndex = prevNode->next;
+  }
+
+  header->freeHead = CompactNode::NONE;
+  for (std::uint32_t index = header->used; index-- > 0;) {
+    if (!reached[index]) {
+      nodeAt(index)->next = header->freeHead;
+      header->freeHead = index;
+    }
+  }
+  header->currentSize.store(size, std::memory_order_relaxed);
+  header->repairs.fetch_add(1, std::memory_order_relaxed);
+}
+
+/**
+ * Converts an index into the address of its Node in this process
+ *
+ * @param   index  index of a Node
+ *
+ * @return  the Node
+ */
+CompactNode *SharedMTFList::nodeAt(std::uint32_t index) const {
+  return reinterpret_cast<CompactNode *>(reinterpret_cast<char *>(header) +
+                                         nodesOffset(sizeof(Header))) +
+         index;
+} // end SharedMTFList.cpp
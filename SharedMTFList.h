@@ -0,0 +1,244 @@
+/**
+ * SharedMTFList.h
+ *
+ * Declarations for the SharedMTFList class, a "move-to-front" list whose nodes
+ * live in a shared memory segment, so that several processes, such as the
+ * workers forked by one server, search and reorder one copy of the values. A
+ * segment is either anonymous, shared with every process forked after it was
+ * created, or a named POSIX segment that unrelated processes open by name.
+ * Nodes are CompactNodes linked by index into the segment rather than by
+ * address, since each process may map the segment at a different address.
+ * Every operation holds a process-shared mutex: a search that finds a value
+ * moves it to the front, so nearly every search writes and gains little from
+ * walking without the lock. The mutex is robust; if a process dies holding
+ * it, the next process to lock it repairs the links before going on.
+ *
+ * Joshua Scheck
+ * 2020-10-18
+ */
+
+#pragma once
+#include "CompactSelfOrganizingList.h"
+#include "IList.h"
+#include <cstddef>
+#include <cstdint>
+#include <string>
+
+/**
+ * Represents a move-to-front singly Linked List held in shared memory that is
+ * the subclass of IList
+ */
+class SharedMTFList : public IList {
+public:
+  /** Number of nodes a segment holds when no other capacity is requested */
+  static const int DEFAULT_CAPACITY = 1 << 22;
+
+  /**
+   * Constructor for this SharedMTFList class. Creates an empty list in an
+   * anonymous segment, shared with every process forked from this one
+   * afterwards. Memory is only committed as nodes are used.
+   *
+   * @param   capacity  number of nodes the segment holds
+   *
+   * @post    the list is attached if the segment could be created, otherwise
+   *          it is empty and every add fails
+   */
+  explicit SharedMTFList(int capacity = DEFAULT_CAPACITY);
+
+  /**
+   * Constructor for this SharedMTFList class. Opens the named POSIX segment,
+   * creating it with an empty list if it does not exist yet.
+   *
+   * @param   name      name of the segment, a slash followed by up to 254
+   *                    characters other than slashes
+   * @param   capacity  number of nodes the segment holds if it is created;
+   *                    an existing segment keeps the capacity it was created
+   *                    with
+   *
+   * @post    the list is attached if the segment could be opened or created,
+   *          otherwise it is empty and every add fails
+   */
+  SharedMTFList(const std::string &name, int capacity = DEFAULT_CAPACITY);
+
+  /**
+   * Destructor for this SharedMTFList class that unmaps the segment. The
+   * nodes stay in the segment for the other processes using it; a named
+   * segment stays until it is unlinked.
+   */
+  ~SharedMTFList() override;
+
+  SharedMTFList(const SharedMTFList &) = delete;
+  SharedMTFList &operator=(const SharedMTFList &) = delete;
+
+  /**
+   * Removes a named segment, which is freed once every process has unmapped
+   * it. Processes that open the name afterwards get a new, empty list.
+   *
+   * @param   name  name of the segment
+   *
+   * @return  true if the segment was removed, false if there was none
+   */
+  static bool unlink(const std::string &name);
+
+  /**
+   * Determines if this SharedMTFList has a segment to keep its nodes in
+   *
+   * @return  true if the segment was created or opened, false otherwise
+   */
+  bool isAttached() const;
+
+  /**
+   * Retrieves the number of nodes the segment holds
+   *
+   * @return  the capacity, 0 if not attached
+   */
+  int getCapacity() const;
+
+  /**
+   * Retrieves the current number of Nodes in this SharedMTFList
+   *
+   * @return  the number of Nodes, which another process may change as soon as
+   *          it is returned
+   */
+  int getCurrentSize() const override;
+
+  /**
+   * Determines if this SharedMTFList has no Nodes
+   *
+   * @return  true if the list was empty when checked, false otherwise
+   */
+  bool isEmpty() const override;
+
+  /**
+   * Adds a new Node with the specified value to the beginning of this
+   * SharedMTFList. Duplicate integer values are allowed.
+   *
+   * @param   newEntry integer value to be added
+   *
+   * @post             if successful, the size of this SharedMTFList increases
+   * by 1 and the new Node is its front. No change in state if unsuccessful.
+   *
+   * @return           true if a new Node is successfully added, false if the
+   *                   segment is full or not attached
+   */
+  bool add(int newEntry) override;
+
+  /**
+   * Removes the first occurrence of a Node containing the specified integer.
+   * The Node is kept in the segment for reuse.
+   *
+   * @param   anEntry  the sought integer value to be removed
+   *
+   * @return           true if a Node is found and removed, false otherwise
+   */
+  bool remove(int anEntry) override;
+
+  /**
+   * Removes all entries from this SharedMTFList, for every process using it
+   *
+   * @post    the list is empty and its size is 0
+   */
+  void clear() override;
+
+  /**
+   * Determines if the specified integer value is held by a Node in this
+   * SharedMTFList, then moves the found Node to the front
+   *
+   * @param   anEntry  the sought integer value
+   *
+   * @post             the traversal count of this process is incremented by 1
+   * with each Node traversed in the search for the first occurrence of the
+   * specified value (even if not found). If found, its Node is the front of
+   * the list for every process.
+   *
+   * @return           true if the specified integer value is contained in
+   *                   this SharedMTFList, false otherwise
+   */
+  bool contains(int anEntry) override;
+
+  /**
+   * Retrieves the number of nodes traversed since the last time the count was
+   * reset in this SharedMTFList.
+   *
+   * @post    state of this SharedMTFList does not change
+   *
+   * @return  the number of Nodes traversed
+   */
+  long long getTraverseCount() const override;
+
+  /**
+   * Retrieves everything recorded about this SharedMTFList since the last reset
+   *
+   * @post    state of this SharedMTFList does not change
+   *
+   * @return  traversals, hits, misses, the histogram of hit positions,
+   *          promotions and splices, all 0 if instrumentation is compiled out
+   */
+  ListStatistics getStatistics() const override;
+
+  /**
+   * Resets the count of Nodes traversed in this SharedMTFList
+   *
+   * @post sets the traversal count and all other statistics to 0
+   */
+  void resetTraverseCount() override;
+
+  /**
+   * Retrieves the number of times a process died while changing the list and
+   * the links were repaired, since the segment was created
+   *
+   * @return  the number of repairs
+   */
+  int getRepairCount() const;
+
+private:
+  /** The start of a segment, followed by the nodes */
+  struct Header;
+
+  /** Holds the mutex of a segment for one scope */
+  class Guard;
+
+  /**
+   * Creates a new anonymous or named segment
+   *
+   * @param   fd        descriptor of a named segment, or -1 for an anonymous
+   *                    segment
+   * @param   capacity  number of nodes the segment holds
+   *
+   * @return  true if successful, false otherwise
+   */
+  bool create(int fd, int capacity);
+
+  /**
+   * Maps an existing named segment once its creator has finished setting it
+   * up
+   *
+   * @param   fd  descriptor of the segment
+   *
+   * @return  true if successful, false otherwise
+   */
+  bool attach(int fd);
+
+  /**
+   * Rebuilds the size and free nodes from the Nodes reachable from the front,
+   * after a process died holding the mutex. The caller holds the mutex.
+   */
+  void repair();
+
+  /**
+   * Converts an index into the address of its Node in this process
+   *
+   * @param   index  index of a Node
+   *
+   * @return  the Node
+   */
+  CompactNode *nodeAt(std::uint32_t index) const;
+
+  /** Start of the mapping, otherwise nullptr. */
+  Header *header;
+  /** Size of the mapping in bytes. */
+  std::size_t mappedBytes;
+  /** Instrumentation of this SharedMTFList; a no-op when built with
+   * NO_LIST_INSTRUMENTATION. */
+  ListCounter counter;
+}; // end SharedMTFList.h
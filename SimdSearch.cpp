@@ -0,0 +1,160 @@
+/**
+ * SimdSearch.cpp
+ *
+ * Implementations for vectorized linear search over contiguous integer
+ * buffers. The widest instruction set supported by the running processor
+ * (AVX2, then SSE2) is selected once at runtime, with a portable scalar loop as
+ * fallback.
+ *
+ * Joshua Scheck
+ * 2020-10-18
+ */
+
+#include "SimdSearch.h"
+
+#if (defined(__x86_64__) || defined(__i386__)) &&                             \
+    (defined(__GNUC__) || defined(__clang__))
+#define SIMD_SEARCH_X86 1
+#include <immintrin.h>
+#endif
+
+namespace {
+
+/** Signature shared by every implementation of findFirstInt() */
+typedef int (*FindFirstFn)(const int *, int, int);
+
+/**
+ * Portable implementation comparing one integer at a time
+ */
+int findFirstScalar(const int *items, int count, int value) {
+  for (int i = 0; i < count; i++) {
+    if (items[i] == value) {
+      return i;
+    }
+  }
+  return -1;
+}
+
+#ifdef SIMD_SEARCH_X86
+/**
+ * Compares four integers per instruction using SSE2
+ */
+__attribute__((target("sse2"))) int findFirstSse2(const int *items, int count,
+                                                  int value) {
+  const __m128i needle = _mm_set1_epi32(value);
+  int i = 0;
+
+  for (; i + 4 <= count; i += 4) {
+    __m128i block =
+        _mm_loadu_si128(reinterpret_cast<const __m128i *>(items + i));
+    int mask =
+        _mm_movemask_ps(_mm_castsi128_ps(_mm_cmpeq_epi32(block, needle)));
+    if (mask != 0) {
+      return i + __builtin_ctz(mask);
+    }
+  }
+
+  int tail = findFirstScalar(items + i, count - i, value);
+  return tail < 0 ? -1 : i + tail;
+}
+
+/**
+ * Compares eight integers per instruction using AVX2
+ */
+__attribute__((target("avx2"))) int findFirstAvx2(const int *items, int count,
+                                                  int value) {
+  const __m256i needle = _mm256_set1_epi32(value);
+  int i = 0;
+
+  for (; i + 8 <= count; i += 8) {
+    __m256i block =
+        _mm256_loadu_si256(reinterpret_cast<const __m256i *>(items + i));
+    int mask = _mm256_movemask_ps(
+        _mm256_castsi256_ps(_mm256_cmpeq_epi32(block, needle)));
+    if (mask != 0) {
+      return i + __builtin_ctz(mask);
+    }
+  }
+
+  // the tail stays in AVX-encoded code; calling the SSE2 implementation here
+  // would pay an AVX to SSE transition penalty on every call
+  if (i + 4 <= count) {
+    __m128i block =
+        _mm_loadu_si128(reinterpret_cast<const __m128i *>(items + i));
+    __m128i narrowNeedle = _mm256_castsi256_si128(needle);
+    int mask = _mm_movemask_ps(
+        _mm_castsi128_ps(_mm_cmpeq_epi32(block, narrowNeedle)));
+    if (mask != 0) {
+      return i + __builtin_ctz(mask);
+    }
+    i += 4;
+  }
+
+  for (; i < count; i++) {
+    if (items[i] == value) {
+      return i;
+    }
+  }
+  return -1;
+}
+#endif
+
+/**
+ * Chooses the widest implementation supported by the running processor
+ */
+FindFirstFn detectFindFirst(const char **name) {
+#ifdef SIMD_SEARCH_X86
+  __builtin_cpu_init();
+  if (__builtin_cpu_supports("avx2")) {
+    *name = "avx2";
+    return findFirstAvx2;
+  }
+  if (__builtin_cpu_supports("sse2")) {
+    *name = "sse2";
+    return findFirstSse2;
+  }
+#endif
+  *name = "scalar";
+  return findFirstScalar;
+}
+
+/** Name of the instruction set chosen by detectFindFirst() */
+const char *selectedName = "scalar";
+
+/**
+ * Retrieves the implementation detected on first use, which keeps the search
+ * valid even when called during static initialization of another file
+ */
+FindFirstFn selectedFindFirst() {
+  static const FindFirstFn selected = detectFindFirst(&selectedName);
+  return selected;
+}
+
+} // namespace
+
+/**
+ * Finds the first position of a value in a contiguous buffer of integers
+ *
+ * @param   items  address of the first integer to search
+ * @param   count  number of integers to search, starting at items
+ * @param   value  the sought integer value
+ *
+ * @pre     items must reference at least count readable integers
+ *
+ * @post    the buffer is not modified
+ *
+ * @return  index of the first occurrence of value, or -1 if it is absent
+ */
+int findFirstInt(const int *items, int count, int value) {
+  return selectedFindFirst()(items, count, value);
+}
+
+/**
+ * Retrieves the name of the instruction set used by findFirstInt()
+ *
+ * @return  "avx2", "sse2" or "scalar"
+ */
+const char *simdSearchInstructionSet() {
+  selectedFindFirst();
+  return selectedName;
+} // end SimdSearch.cpp
@@ -0,0 +1,34 @@
+/**
+ * SimdSearch.h
+ *
+ * Declarations for vectorized linear search over contiguous integer buffers.
+ * The widest instruction set supported by the running processor (AVX2, then
+ * SSE2) is selected once at runtime, with a portable scalar loop as fallback.
+ *
+ * Joshua Scheck
+ * 2020-10-18
+ */
+
+#pragma once
+
+/**
+ * Finds the first position of a value in a contiguous buffer of integers
+ *
+ * @param   items  address of the first integer to search
+ * @param   count  number of integers to search, starting at items
+ * @param   value  the sought integer value
+ *
+ * @pre     items must reference at least count readable integers
+ *
+ * @post    the buffer is not modified
+ *
+ * @return  index of the first occurrence of value, or -1 if it is absent
+ */
+int findFirstInt(const int *items, int count, int value);
+
+/**
+ * Retrieves the name of the instruction set used by findFirstInt()
+ *
+ * @return  "avx2", "sse2" or "scalar"
+ */
+const char *simdSearchInstructionSet();
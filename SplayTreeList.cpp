@@ -0,0 +1,315 @@
+/**
+ * SplayTreeList.cpp
+ *
+ * Implementations for the SplayTreeList class, a self-adjusting binary search
+ * tree of integer values. Every search splays the value it looked for to the
+ * root, which gives amortized O(log n) access while keeping recently and
+ * frequently sought values near the root, the tree analogue of move-to-front.
+ * The traverse count reports the tree nodes compared during each search.
+ *
+ * Joshua Scheck
+ * 2020-10-18
+ */
+
+#include "SplayTreeList.h"
+#include <algorithm>
+#include <new>
+#include <utility>
+#include <vector>
+
+/**
+ * Constructor for this SplayTreeList class. Initializes an empty
+ * SplayTreeList.
+ */
+SplayTreeList::SplayTreeList() : root(nullptr), currentSize(0) {}
+
+/**
+ * Destructor for this SplayTreeList class that frees the nodes allocated by
+ * the object.
+ */
+SplayTreeList::~SplayTreeList() { clear(); }
+
+/**
+ * Retrieves the current number of values in this SplayTreeList, counting every
+ * copy of a duplicate value
+ *
+ * @post    state of this SplayTreeList does not change
+ *
+ * @return  the number of values in this SplayTreeList
+ */
+int SplayTreeList::getCurrentSize() const { return currentSize; }
+
+/**
+ * Determines if the number of values in this SplayTreeList is zero
+ *
+ * @post    state of this SplayTreeList does not change
+ *
+ * @return  true if this SplayTreeList holds no values, false otherwise
+ */
+bool SplayTreeList::isEmpty() const { return currentSize == 0; }
+
+/**
+ * Adds the specified value to this SplayTreeList. Duplicate integer values are
+ * allowed; they share one node that counts its copies.
+ *
+ * @param   newEntry integer value to be added to this SplayTreeList
+ *
+ * @post             if successful, the size of this SplayTreeList increases by
+ * 1 and newEntry is at the root. No values change if unsuccessful.
+ *
+ * @return           true if the value is successfully added, false if memory
+ *                   could not be allocated
+ */
+bool SplayTreeList::add(int newEntry) {
+  splay(newEntry);
+  if (root != nullptr && root->item == newEntry) {
+    root->copies++;
+    currentSize++;
+    return true;
+  }
+
+  SplayNode *newNode = nullptr;
+  try {
+    newNode = new SplayNode{newEntry, 1, nullptr, nullptr};
+  }
+  // inability to allocate memory will throw a std::bad_alloc error
+  // which will be caught and signals a lack of success
+  catch (std::bad_alloc &exc) {
+    return false;
+  }
+
+  // the root is the neighbour of newEntry, so the tree splits under it
+  if (root != nullptr) {
+    if (newEntry < root->item) {
+      newNode->left = root->left;
+      newNode->right = root;
+      root->left = nullptr;
+    } else {
+      newNode->right = root->right;
+      newNode->left = root;
+      root->right = nullptr;
+    }
+  }
+  root = newNode;
+  currentSize++;
+  return true;
+}
+
+/**
+ * Removes one copy of the specified integer from this SplayTreeList
+ *
+ * @param   anEntry  the sought integer value to be removed
+ *
+ * @post             if successful, the size of this SplayTreeList decreases by
+ * 1. No values change if unsuccessful.
+ *
+ * @return           true if the value is found and removed, false otherwise
+ */
+bool SplayTreeList::remove(int anEntry) {
+  splay(anEntry);
+  if (root == nullptr || root->item != anEntry) {
+    return false;
+  }
+
+  currentSize--;
+  if (--root->copies > 0) {
+    return true;
+  }
+
+  SplayNode *deadNode = root;
+  if (root->left == nullptr) {
+    root = root->right;
+  } else {
+    // splaying the left subtree for a larger value brings its largest value
+    // to the root, leaving no right subtree to make room for the other side
+    root = deadNode->left;
+    splay(anEntry);
+    root->right = deadNode->right;
+  }
+  delete deadNode;
+  return true;
+}
+
+/**
+ * Removes all entries from this SplayTreeList
+ *
+ * @post    this SplayTreeList is empty and its size is 0
+ */
+void SplayTreeList::clear() {
+  // rotating left children up flattens the tree while it is freed, so no
+  // stack is needed however deep the tree is
+  while (root != nullptr) {
+    if (root->left != nullptr) {
+      SplayNode *leftNode = root->left;
+      root->left = leftNode->right;
+      leftNode->right = root;
+      root = leftNode;
+    } else {
+      SplayNode *deadNode = root;
+      root = root->right;
+      delete deadNode;
+    }
+  }
+  currentSize = 0;
+}
+
+/**
+ * Determines if the specified integer value is held in this SplayTreeList,
+ * then splays the last node compared to the root
+ *
+ * @param   anEntry  the sought integer value
+ *
+ * @post             the traversal count is incremented by the number of nodes
+ * compared, which is the depth of the value plus one if found. The value, or
+ * the closest value to it if not found, is at the root.
+ *
+ * @return           true if the specified integer value is contained in this
+ *                   SplayTreeList, false otherwise
+ */
+bool SplayTreeList::contains(int anEntry) {
+  long long position = splay(anEntry);
+  counter.traversed(position);
+
+  if (root == nullptr || root->item != anEntry) {
+    counter.miss();
+    return false;
+  }
+
+  counter.hit(position);
+  if (position > 1) {
+    counter.promoted();
+  }
+  return true;
+}
+
+/**
+ * Retrieves the number of nodes traversed since the last time the count was
+ * reset in this SplayTreeList.
+ *
+ * @post    state of this SplayTreeList does not change
+ *
+ * @return  the number of tree nodes traversed
+ */
+long long SplayTreeList::getTraverseCount() const { return counter.get(); }
+
+/**
+ * Retrieves everything recorded about this SplayTreeList since the last reset
+ *
+ * @post    state of this SplayTreeList does not change
+ *
+ * @return  traversals, hits, misses, the histogram of hit positions,
+ *          promotions and splices, all 0 if instrumentation is compiled out
+ */
+ListStatistics SplayTreeList::getStatistics() const {
+  return counter.statistics();
+}
+
+/**
+ * Resets the count of tree nodes traversed in this SplayTreeList
+ *
+ * @post sets the traversal count and all other statistics to 0
+ */
+void SplayTreeList::resetTraverseCount() { counter.reset(); }
+
+/**
+ * Retrieves the number of nodes on the longest path from the root
+ *
+ * @post    state of this SplayTreeList does not change
+ *
+ * @return  the height of the tree, 0 if it is empty
+ */
+int SplayTreeList::getHeight() const {
+  int height = 0;
+  std::vector<std::pair<const SplayNode *, int>> pending;
+  if (root != nullptr) {
+    pending.emplace_back(root, 1);
+  }
+  while (!pending.empty()) {
+    const SplayNode *currNode = pending.back().first;
+    int depth = pending.back().second;
+    pending.pop_back();
+    height = std::max(height, depth);
+    if (currNode->left != nullptr) {
+      pending.emplace_back(currNode->left, depth + 1);
+    }
+    if (currNode->right != nullptr) {
+      pending.emplace_back(currNode->right, depth + 1);
+    }
+  }
+  return height;
+}
+
+/**
+ * Top-down splay: moves the node holding a value, or the last node compared if
+ * there is none, to the root. Iterative, so degenerate trees of any depth are
+ * safe.
+ *
+ * @param   anEntry  the sought integer value
+ *
+ * @return  the number of nodes compared, 0 if the tree is empty
+ */
+long long SplayTreeList::splay(int anEntry) {
+  if (root == nullptr) {
+    return 0;
+  }
+
+  // header.right collects the values known to be smaller than anEntry and
+  // header.left those known to be larger; leftMax and rightMin are the nodes
+  // where the next ones are attached
+  SplayNode header{0, 0, nullptr, nullptr};
+  SplayNode *leftMax = &header;
+  SplayNode *rightMin = &header;
+  SplayNode *currNode = root;
+  long long compared = 0;
+
+  for (;;) {
+    compared++;
+    if (anEntry < currNode->item) {
+      if (currNode->left == nullptr) {
+        break;
+      }
+      if (anEntry < currNode->left->item) {
+        // zig-zig: rotate right before linking
+        compared++;
+        SplayNode *leftNode = currNode->left;
+        currNode->left = leftNode->right;
+        leftNode->right = currNode;
+        currNode = leftNode;
+        if (currNode->left == nullptr) {
+          break;
+        }
+      }
+      rightMin->left = currNode;
+      rightMin = currNode;
+      currNode = currNode->left;
+    } else if (anEntry > currNode->item) {
+      if (currNode->right == nullptr) {
+        break;
+      }
+      if (anEntry > currNode->right->item) {
+        // zag-zag: rotate left before linking
+        compared++;
+        SplayNode *rightNode = currNode->right;
+        currNode->right = rightNode->left;
+        rightNode->left = currNode;
+        currNode = rightNode;
+        if (currNode->right == nullptr) {
+          break;
+        }
+      }
+      leftMax->right = currNode;
+      leftMax = currNode;
+      currNode = currNode->right;
+    } else {
+      break;
+    }
+  }
+
+  // reassemble: the collected trees become the subtrees of the new root
+  leftMax->right = currNode->left;
+  rightMin->left = currNode->right;
+  currNode->left = header.right;
+  currNode->right = header.left;
+  root = currNode;
+  return compared;
+} // end SplayTreeList.cpp
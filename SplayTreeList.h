@@ -0,0 +1,171 @@
+/**
+ * SplayTreeList.h
+ *
+ * Declarations for the SplayTreeList class, a self-adjusting binary search
+ * tree of integer values. Every search splays the value it looked for to the
+ * root, which gives amortized O(log n) access while keeping recently and
+ * frequently sought values near the root, the tree analogue of move-to-front.
+ * The traverse count reports the tree nodes compared during each search.
+ *
+ * Joshua Scheck
+ * 2020-10-18
+ */
+
+#pragma once
+#include "IList.h"
+
+/**
+ * Represents a splay tree of integer values that is the subclass of IList
+ */
+class SplayTreeList : public IList {
+public:
+  /**
+   * Constructor for this SplayTreeList class. Initializes an empty
+   * SplayTreeList.
+   */
+  SplayTreeList();
+
+  /**
+   * Destructor for this SplayTreeList class that frees the nodes allocated by
+   * the object.
+   */
+  ~SplayTreeList() override;
+
+  SplayTreeList(const SplayTreeList &) = delete;
+  SplayTreeList &operator=(const SplayTreeList &) = delete;
+
+  /**
+   * Retrieves the current number of values in this SplayTreeList, counting
+   * every copy of a duplicate value
+   *
+   * @post    state of this SplayTreeList does not change
+   *
+   * @return  the number of values in this SplayTreeList
+   */
+  int getCurrentSize() const override;
+
+  /**
+   * Determines if the number of values in this SplayTreeList is zero
+   *
+   * @post    state of this SplayTreeList does not change
+   *
+   * @return  true if this SplayTreeList holds no values, false otherwise
+   */
+  bool isEmpty() const override;
+
+  /**
+   * Adds the specified value to this SplayTreeList. Duplicate integer values
+   * are allowed; they share one node that counts its copies.
+   *
+   * @param   newEntry integer value to be added to this SplayTreeList
+   *
+   * @post             if successful, the size of this SplayTreeList increases
+   * by 1 and newEntry is at the root. No values change if unsuccessful.
+   *
+   * @return           true if the value is successfully added, false if
+   *                   memory could not be allocated
+   */
+  bool add(int newEntry) override;
+
+  /**
+   * Removes one copy of the specified integer from this SplayTreeList
+   *
+   * @param   anEntry  the sought integer value to be removed
+   *
+   * @post             if successful, the size of this SplayTreeList decreases
+   * by 1. No values change if unsuccessful.
+   *
+   * @return           true if the value is found and removed, false otherwise
+   */
+  bool remove(int anEntry) override;
+
+  /**
+   * Removes all entries from this SplayTreeList
+   *
+   * @post    this SplayTreeList is empty and its size is 0
+   */
+  void clear() override;
+
+  /**
+   * Determines if the specified integer value is held in this SplayTreeList,
+   * then splays the last node compared to the root
+   *
+   * @param   anEntry  the sought integer value
+   *
+   * @post             the traversal count is incremented by the number of
+   * nodes compared, which is the depth of the value plus one if found. The
+   * value, or the closest value to it if not found, is at the root.
+   *
+   * @return           true if the specified integer value is contained in
+   *                   this SplayTreeList, false otherwise
+   */
+  bool contains(int anEntry) override;
+
+  /**
+   * Retrieves the number of nodes traversed since the last time the count was
+   * reset in this SplayTreeList.
+   *
+   * @post    state of this SplayTreeList does not change
+   *
+   * @return  the number of tree nodes traversed
+   */
+  long long getTraverseCount() const override;
+
+  /**
+   * Retrieves everything recorded about this SplayTreeList since the last reset
+   *
+   * @post    state of this SplayTreeList does not change
+   *
+   * @return  traversals, hits, misses, the histogram of hit positions,
+   *          promotions and splices, all 0 if instrumentation is compiled out
+   */
+  ListStatistics getStatistics() const override;
+
+  /**
+   * Resets the count of tree nodes traversed in this SplayTreeList
+   *
+   * @post sets the traversal count and all other statistics to 0
+   */
+  void resetTraverseCount() override;
+
+  /**
+   * Retrieves the number of nodes on the longest path from the root
+   *
+   * @post    state of this SplayTreeList does not change
+   *
+   * @return  the height of the tree, 0 if it is empty
+   */
+  int getHeight() const;
+
+private:
+  /** A distinct value of the tree */
+  struct SplayNode {
+    /** The value held */
+    int item;
+    /** The number of copies of the value held */
+    int copies;
+    /** Reference to the subtree of smaller values, otherwise nullptr */
+    SplayNode *left;
+    /** Reference to the subtree of larger values, otherwise nullptr */
+    SplayNode *right;
+  };
+
+  /**
+   * Top-down splay: moves the node holding a value, or the last node
+   * compared if there is none, to the root. Iterative, so degenerate trees
+   * of any depth are safe.
+   *
+   * @param   anEntry  the sought integer value
+   *
+   * @return  the number of nodes compared, 0 if the tree is empty
+   */
+  long long splay(int anEntry);
+
+  /** Reference to the root node, otherwise nullptr. */
+  SplayNode *root;
+  /** The current number of values in this SplayTreeList. */
+  int currentSize;
+  /** Instrumentation of this SplayTreeList; a no-op when built with
+   * NO_LIST_INSTRUMENTATION. */
+  ListCounter counter;
+}; // end SplayTreeList.h
@@ -0,0 +1,263 @@
+/**
+ * Sweep.cpp
+ *
+ * Implementations for running a parameter sweep of benchmarks, every
+ * combination of list implementation, list size, access distribution and seed,
+ * spread over a pool of worker threads, and for summarizing the runs of every
+ * combination over its seeds as a mean with a 95% confidence interval, with the
+ * latency percentiles of timed runs taken over the merged latencies of every
+ * seed. Every run generates its own accesses from a random stream derived from
+ * its size, distribution and seed, so results do not depend on the number of
+ * threads or the order the runs are picked up in.
+ *
+ * Joshua Scheck
+ * 2020-10-18
+ */
+
+#include "Sweep.h"
+#include <atomic>
+#include <cmath>
+#include <exception>
+#include <map>
+#include <mutex>
+#include <thread>
+#include <tuple>
+
+namespace {
+
+/** Two-sided 97.5% quantiles of Student's t distribution for 1..30 degrees
+ * of freedom */
+const double T_QUANTILES[30] = {
+    12.706, 4.303, 3.182, 2.776, 2.571, 2.447, 2.365, 2.306, 2.262, 2.228,
+    2.201,  2.179, 2.160, 2.145, 2.131, 2.120, 2.110, 2.101, 2.093, 2.086,
+    2.080,  2.074, 2.069, 2.064, 2.060, 2.056, 2.052, 2.048, 2.045, 2.042};
+
+/**
+ * Hashes a name with 64-bit FNV-1a, which unlike std::hash gives the same
+ * value on every platform
+ */
+std::uint64_t hashName(const std::string &name) {
+  std::uint64_t hash = 14695981039346656037ULL;
+  for (unsigned char c : name) {
+    hash = (hash ^ c) * 1099511628211ULL;
+  }
+  return hash;
+}
+
+/**
+ * Computes the mean of some values and the half-width of its 95% confidence
+ * interval
+ *
+ * @param   values  the values, at least one
+ * @param   margin  set to the half-width, or -1 for a single value
+ *
+ * @return  the mean
+ */
+double meanWithMargin(const std::vector<double> &values, double &margin) {
+  double sum = 0.0;
+  for (double value : values) {
+    sum += value;
+  }
+  double mean = sum / double(values.size());
+
+  std::size_t degrees = values.size() - 1;
+  if (degrees == 0) {
+    margin = -1.0;
+    return mean;
+  }
+  double squares = 0.0;
+  for (double value : values) {
+    squares += (value - mean) * (value - mean);
+  }
+  double deviation = std::sqrt(squares / double(degrees));
+  double quantile = degrees <= 30 ? T_QUANTILES[degrees - 1] : 1.960;
+  margin = quantile * deviation / std::sqrt(double(values.size()));
+  return mean;
+}
+
+/**
+ * Writes the CSV fields of a mean and of the bounds of its confidence
+ * interval
+ */
+void writeInterval(std::ostream &out, double mean, double margin) {
+  out << "," << mean << ",";
+  if (margin >= 0.0) {
+    out << mean - margin << "," << mean + margin;
+  } else {
+    out << ",";
+  }
+}
+
+} // namespace
+
+/**
+ * Creates the random stream of the accesses of a run. Different sizes,
+ * distributions and seeds give statistically independent streams, while the
+ * same three always give the same stream, so every list of a sweep seeks
+ * exactly the same values.
+ *
+ * @param   numValues     number of values added to the list
+ * @param   distribution  name of the access distribution
+ * @param   seed          seed of the run
+ *
+ * @return  the generator
+ */
+std::mt19937_64 sweepGenerator(int numValues, const std::string &distribution,
+                               std::uint64_t seed) {
+  // seed_seq spreads the words over the whole state of the generator, so
+  // neighbouring seeds do not give correlated streams
+  std::uint64_t name = hashName(distribution);
+  std::seed_seq words{std::uint32_t(seed), std::uint32_t(seed >> 32),
+                      std::uint32_t(numValues), std::uint32_t(name),
+                      std::uint32_t(name >> 32)};
+  return std::mt19937_64(words);
+}
+
+/**
+ * Runs every cell of a sweep, each with a fresh list and its own random
+ * stream, on a pool of worker threads
+ *
+ * @param   cells        the runs
+ * @param   numAccesses  number of values sought per run
+ * @param   threads      number of worker threads; 1 runs every cell on the
+ *                       calling thread
+ * @param   timeLatency  true to record the latency of every operation
+ *
+ * @post    rethrows the first exception thrown by a run, once every worker
+ *          has stopped
+ *
+ * @return  the result of every cell, in the order of the cells
+ */
+std::vector<BenchmarkResult> runSweep(const std::vector<SweepCell> &cells,
+                                      long long numAccesses, int threads,
+                                      bool timeLatency) {
+  std::vector<BenchmarkResult> results(cells.size());
+  std::atomic<std::size_t> nextCell(0);
+  std::atomic<bool> stopped(false);
+  std::exception_ptr failure;
+  std::mutex failureLock;
+
+  // workers claim cells one at a time, so long runs (large lists) do not
+  // hold up a share of cells fixed in advance
+  auto work = [&]() {
+    for (std::size_t i = nextCell++; i < cells.size() && !stopped;
+         i = nextCell++) {
+      const SweepCell &cell = cells[i];
+      try {
+        std::string name = cell.distribution->getName();
+        std::mt19937_64 generator =
+            sweepGenerator(cell.numValues, name, cell.seed);
+        std::vector<int> accesses = cell.distribution->generate(
+            cell.numValues, int(numAccesses), generator);
+        results[i] = runBenchmark(*cell.list, cell.numValues, name,
+                                  cell.seed, accesses, timeLatency);
+      } catch (...) {
+        std::lock_guard<std::mutex> guard(failureLock);
+        if (failure == nullptr) {
+          failure = std::current_exception();
+        }
+        stopped = true;
+      }
+    }
+  };
+
+  std::vector<std::thread> workers;
+  for (int t = 1; t < threads && std::size_t(t) < cells.size(); t++) {
+    workers.emplace_back(work);
+  }
+  work();
+  for (std::thread &worker : workers) {
+    worker.join();
+  }
+
+  if (failure != nullptr) {
+    std::rethrow_exception(failure);
+  }
+  return results;
+}
+
+/**
+ * Merges the results of every list, size and distribution over their seeds
+ *
+ * @param   results  results of a sweep
+ *
+ * @return  one summary per list, size and distribution, in the order they
+ *          first appear in results
+ */
+std::vector<SweepSummary>
+summarizeSweep(const std::vector<BenchmarkResult> &results) {
+  typedef std::tuple<std::string, int, std::string> Key;
+  std::map<Key, std::size_t> groupOf;
+  std::vector<std::vector<const BenchmarkResult *>> groups;
+
+  for (const BenchmarkResult &result : results) {
+    Key key(result.list, result.numValues, result.distribution);
+    auto found = groupOf.emplace(key, groups.size());
+    if (found.second) {
+      groups.emplace_back();
+    }
+    groups[found.first->second].push_back(&result);
+  }
+
+  std::vector<SweepSummary> summaries;
+  for (const auto &group : groups) {
+    std::vector<double> traversals;
+    std::vector<double> nsPerOp;
+    SweepSummary summary;
+    summary.timed = false;
+    for (const BenchmarkResult *result : group) {
+      traversals.push_back(result->averageTraversals);
+      nsPerOp.push_back(result->nsPerOp);
+      if (result->timed) {
+        summary.timed = true;
+        summary.lookupLatency.merge(result->lookupLatency);
+      }
+    }
+
+    summary.list = group.front()->list;
+    summary.numValues = group.front()->numValues;
+    summary.distribution = group.front()->distribution;
+    summary.runs = int(group.size());
+    summary.meanTraversals =
+        meanWithMargin(traversals, summary.traversalsMargin);
+    summary.meanNsPerOp = meanWithMargin(nsPerOp, summary.nsPerOpMargin);
+    summaries.push_back(summary);
+  }
+  return summaries;
+}
+
+/**
+ * Writes summaries as CSV with a header row. The lower and upper bounds of a
+ * confidence interval are left empty when there is only one run. The
+ * percentiles of the lookup latencies are added as columns if any summary is
+ * timed.
+ *
+ * @param   out        stream written to
+ * @param   summaries  the summaries
+ */
+void writeSummaryCsv(std::ostream &out,
+                     const std::vector<SweepSummary> &summaries) {
+  bool timed = false;
+  for (const SweepSummary &summary : summaries) {
+    timed = timed || summary.timed;
+  }
+  out << "list,size,distribution,runs,avg_traversals,avg_traversals_ci_low,"
+      << "avg_traversals_ci_high,ns_per_op,ns_per_op_ci_low,ns_per_op_ci_high";
+  if (timed) {
+    out << ",lookup_p50_ns,lookup_p99_ns,lookup_p999_ns,lookup_max_ns";
+  }
+  out << std::endl;
+  for (const SweepSummary &summary : summaries) {
+    out << summary.list << "," << summary.numValues << ","
+        << summary.distribution << "," << summary.runs;
+    writeInterval(out, summary.meanTraversals, summary.traversalsMargin);
+    writeInterval(out, summary.meanNsPerOp, summary.nsPerOpMargin);
+    if (timed) {
+      const LatencyHistogram &latency = summary.lookupLatency;
+      out << "," << latency.percentile(0.50) << ","
+          << latency.percentile(0.99) << "," << latency.percentile(0.999)
+          << "," << latency.getMax();
+    }
+    out << std::endl;
+  }
+} // end Sweep.cpp
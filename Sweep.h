@@ -0,0 +1,124 @@
+/**
+ * Sweep.h
+ *
+ * Declarations for running a parameter sweep of benchmarks, every combination
+ * of list implementation, list size, access distribution and seed, spread over
+ * a pool of worker threads, and for summarizing the runs of every combination
+ * over its seeds as a mean with a 95% confidence interval, with the latency
+ * percentiles of timed runs taken over the merged latencies of every seed.
+ * Every run generates its own accesses from a random stream derived from its
+ * size, distribution and seed, so results do not depend on the number of
+ * threads or the order the runs are picked up in.
+ *
+ * Joshua Scheck
+ * 2020-10-18
+ */
+
+#pragma once
+#include "Benchmark.h"
+#include "ListCatalog.h"
+#include "Workloads.h"
+#include <cstdint>
+#include <ostream>
+#include <random>
+#include <string>
+#include <vector>
+
+/**
+ * One benchmark run of a sweep
+ */
+struct SweepCell {
+  /** The list implementation */
+  const ListEntry *list;
+  /** Number of values added to the list */
+  int numValues;
+  /** Distribution the accesses are drawn from */
+  const AccessDistribution *distribution;
+  /** Seed of the random stream of the accesses */
+  std::uint64_t seed;
+};
+
+/**
+ * The runs of one list, size and distribution over every seed
+ */
+struct SweepSummary {
+  /** Name of the list implementation */
+  std::string list;
+  /** Number of values added to the list */
+  int numValues;
+  /** Name of the access distribution */
+  std::string distribution;
+  /** Number of seeds run */
+  int runs;
+  /** Mean of the average number of nodes traversed per access */
+  double meanTraversals;
+  /** Half-width of the 95% confidence interval of meanTraversals, or a
+   * negative value if there is only one run */
+  double traversalsMargin;
+  /** Mean of the wall-clock time per access in nanoseconds */
+  double meanNsPerOp;
+  /** Half-width of the 95% confidence interval of meanNsPerOp, or a
+   * negative value if there is only one run */
+  double nsPerOpMargin;
+  /** True if the runs were timed */
+  bool timed;
+  /** Latencies of the values sought in every run, empty unless timed */
+  LatencyHistogram lookupLatency;
+};
+
+/**
+ * Creates the random stream of the accesses of a run. Different sizes,
+ * distributions and seeds give statistically independent streams, while the
+ * same three always give the same stream, so every list of a sweep seeks
+ * exactly the same values.
+ *
+ * @param   numValues     number of values added to the list
+ * @param   distribution  name of the access distribution
+ * @param   seed          seed of the run
+ *
+ * @return  the generator
+ */
+std::mt19937_64 sweepGenerator(int numValues, const std::string &distribution,
+                               std::uint64_t seed);
+
+/**
+ * Runs every cell of a sweep, each with a fresh list and its own random
+ * stream, on a pool of worker threads
+ *
+ * @param   cells        the runs
+ * @param   numAccesses  number of values sought per run
+ * @param   threads      number of worker threads; 1 runs every cell on the
+ *                       calling thread
+ * @param   timeLatency  true to record the latency of every operation
+ *
+ * @post    rethrows the first exception thrown by a run, once every worker
+ *          has stopped
+ *
+ * @return  the result of every cell, in the order of the cells
+ */
+std::vector<BenchmarkResult> runSweep(const std::vector<SweepCell> &cells,
+                                      long long numAccesses, int threads,
+                                      bool timeLatency = false);
+
+/**
+ * Merges the results of every list, size and distribution over their seeds
+ *
+ * @param   results  results of a sweep
+ *
+ * @return  one summary per list, size and distribution, in the order they
+ *          first appear in results
+ */
+std::vector<SweepSummary>
+summarizeSweep(const std::vector<BenchmarkResult> &results);
+
+/**
+ * Writes summaries as CSV with a header row. The lower and upper bounds of a
+ * confidence interval are left empty when there is only one run. The
+ * percentiles of the lookup latencies are added as columns if any summary is
+ * timed.
+ *
+ * @param   out        stream written to
+ * @param   summaries  the summaries
+ */
+void writeSummaryCsv(std::ostream &out,
+                     const std::vector<SweepSummary> &summaries);
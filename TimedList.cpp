@@ -0,0 +1,181 @@
+/**
+ * TimedList.cpp
+ *
+ * Implementations for the TimedList class, which forwards every operation to
+ * another IList and records the wall-clock latency of each contains, add and
+ * remove in a LatencyHistogram per operation. Each operation reads the
+ * steady clock twice, which costs some tens of nanoseconds, so latencies
+ * include that overhead.
+ *
+ * Joshua Scheck
+ * 2020-10-18
+ */
+
+#include "TimedList.h"
+#include <chrono>
+
+namespace {
+
+/**
+ * Reads the steady clock in nanoseconds
+ */
+std::uint64_t now() {
+  return std::uint64_t(std::chrono::duration_cast<std::chrono::nanoseconds>(
+                           std::chrono::steady_clock::now().time_since_epoch())
+                           .count());
+}
+
+} // namespace
+
+/**
+ * Creates a list timing the operations made on another list
+ *
+ * @param   target  the list answering every operation
+ *
+ * @pre     target must outlive this TimedList
+ */
+TimedList::TimedList(IList &target) : target(target) {}
+
+/**
+ * Retrieves the current number of values in the wrapped list
+ *
+ * @post    state of this TimedList does not change
+ *
+ * @return  the number of values in the wrapped list
+ */
+int TimedList::getCurrentSize() const { return target.getCurrentSize(); }
+
+/**
+ * Determines if the wrapped list holds no values
+ *
+ * @post    state of this TimedList does not change
+ *
+ * @return  true if the wrapped list is empty, false otherwise
+ */
+bool TimedList::isEmpty() const { return target.isEmpty(); }
+
+/**
+ * Adds the specified value to the wrapped list and records how long it took
+ *
+ * @param   newEntry integer value to be added
+ *
+ * @post             the latency is recorded in the add histogram, whether or
+ * not the value was added
+ *
+ * @return           the result of the wrapped list's add
+ */
+bool TimedList::add(int newEntry) {
+  std::uint64_t start = now();
+  bool added = target.add(newEntry);
+  addLatency.record(now() - start);
+  return added;
+}
+
+/**
+ * Removes the first occurrence of the specified value from the wrapped list
+ * and records how long it took
+ *
+ * @param   anEntry  the sought integer value to be removed
+ *
+ * @post             the latency is recorded in the remove histogram, whether or
+ * not the value was removed
+ *
+ * @return           the result of the wrapped list's remove
+ */
+bool TimedList::remove(int anEntry) {
+  std::uint64_t start = now();
+  bool removed = target.remove(anEntry);
+  removeLatency.record(now() - start);
+  return removed;
+}
+
+/**
+ * Removes all entries from the wrapped list without timing it
+ *
+ * @post    the wrapped list is empty and its size is 0
+ */
+void TimedList::clear() { target.clear(); }
+
+/**
+ * Determines if the specified value is held by the wrapped list and records
+ * how long it took
+ *
+ * @param   anEntry  the sought integer value
+ *
+ * @post             the wrapped list reorganizes itself as its contains does,
+ * and the latency is recorded in the contains histogram
+ *
+ * @return           the result of the wrapped list's contains
+ */
+bool TimedList::contains(int anEntry) {
+  std::uint64_t start = now();
+  bool found = target.contains(anEntry);
+  containsLatency.record(now() - start);
+  return found;
+}
+
+/**
+ * Retrieves the number of nodes traversed by the wrapped list since its last
+ * reset
+ *
+ * @post    state of this TimedList does not change
+ *
+ * @return  the traversal count of the wrapped list
+ */
+long long TimedList::getTraverseCount() const {
+  return target.getTraverseCount();
+}
+
+/**
+ * Retrieves everything the wrapped list recorded since its last reset
+ *
+ * @post    state of this TimedList does not change
+ *
+ * @return  the statistics of the wrapped list
+ */
+ListStatistics TimedList::getStatistics() const {
+  return target.getStatistics();
+}
+
+/**
+ * Resets the statistics of the wrapped list; the latencies are kept, see
+ * resetLatency()
+ *
+ * @post sets the traversal count and all other statistics of the wrapped list
+ *       to 0
+ */
+void TimedList::resetTraverseCount() { target.resetTraverseCount(); }
+
+/**
+ * Retrieves the latencies of every contains since the last reset
+ *
+ * @return  the histogram
+ */
+const LatencyHistogram &TimedList::getContainsLatency() const {
+  return containsLatency;
+}
+
+/**
+ * Retrieves the latencies of every add since the last reset
+ *
+ * @return  the histogram
+ */
+const LatencyHistogram &TimedList::getAddLatency() const { return addLatency; }
+
+/**
+ * Retrieves the latencies of every remove since the last reset
+ *
+ * @return  the histogram
+ */
+const LatencyHistogram &TimedList::getRemoveLatency() const {
+  return removeLatency;
+}
+
+/**
+ * Forgets every latency recorded
+ */
+void TimedList::resetLatency() {
+  containsLatency.reset();
+  addLatency.reset();
+  removeLatency.reset();
+} // end TimedList.cpp
@@ -0,0 +1,160 @@
+/**
+ * TimedList.h
+ *
+ * Declarations for the TimedList class, which forwards every operation to
+ * another IList and records the wall-clock latency of each contains, add and
+ * remove in a LatencyHistogram per operation. Averages hide the tail: a miss
+ * on a long list walks every node while a hit at the front walks one, and
+ * the histograms keep both, so percentiles such as p99 can be reported
+ * alongside the mean.
+ *
+ * Joshua Scheck
+ * 2020-10-18
+ */
+
+#pragma once
+#include "IList.h"
+#include "LatencyHistogram.h"
+
+/**
+ * Forwards every operation to another IList and times it. The wrapped list
+ * still answers, so the timed list can replace it in place.
+ */
+class TimedList : public IList {
+public:
+  /**
+   * Creates a list timing the operations made on another list
+   *
+   * @param   target  the list answering every operation
+   *
+   * @pre     target must outlive this TimedList
+   */
+  explicit TimedList(IList &target);
+
+  /**
+   * Retrieves the current number of values in the wrapped list
+   *
+   * @post    state of this TimedList does not change
+   *
+   * @return  the number of values in the wrapped list
+   */
+  int getCurrentSize() const override;
+
+  /**
+   * Determines if the wrapped list holds no values
+   *
+   * @post    state of this TimedList does not change
+   *
+   * @return  true if the wrapped list is empty, false otherwise
+   */
+  bool isEmpty() const override;
+
+  /**
+   * Adds the specified value to the wrapped list and records how long it took
+   *
+   * @param   newEntry integer value to be added
+   *
+   * @post             the latency is recorded in the add histogram, whether or
+   * not the value was added
+   *
+   * @return           the result of the wrapped list's add
+   */
+  bool add(int newEntry) override;
+
+  /**
+   * Removes the first occurrence of the specified value from the wrapped list
+   * and records how long it took
+   *
+   * @param   anEntry  the sought integer value to be removed
+   *
+   * @post             the latency is recorded in the remove histogram,
+   * whether or not the value was removed
+   *
+   * @return           the result of the wrapped list's remove
+   */
+  bool remove(int anEntry) override;
+
+  /**
+   * Removes all entries from the wrapped list without timing it
+   *
+   * @post    the wrapped list is empty and its size is 0
+   */
+  void clear() override;
+
+  /**
+   * Determines if the specified value is held by the wrapped list and records
+   * how long it took
+   *
+   * @param   anEntry  the sought integer value
+   *
+   * @post             the wrapped list reorganizes itself as its contains does,
+   * and the latency is recorded in the contains histogram
+   *
+   * @return           the result of the wrapped list's contains
+   */
+  bool contains(int anEntry) override;
+
+  /**
+   * Retrieves the number of nodes traversed by the wrapped list since its last
+   * reset
+   *
+   * @post    state of this TimedList does not change
+   *
+   * @return  the traversal count of the wrapped list
+   */
+  long long getTraverseCount() const override;
+
+  /**
+   * Retrieves everything the wrapped list recorded since its last reset
+   *
+   * @post    state of this TimedList does not change
+   *
+   * @return  the statistics of the wrapped list
+   */
+  ListStatistics getStatistics() const override;
+
+  /**
+   * Resets the statistics of the wrapped list; the latencies are kept, see
+   * resetLatency()
+   *
+   * @post sets the traversal count and all other statistics of the wrapped list
+   *       to 0
+   */
+  void resetTraverseCount() override;
+
+  /**
+   * Retrieves the latencies of every contains since the last reset
+   *
+   * @return  the histogram
+   */
+  const LatencyHistogram &getContainsLatency() const;
+
+  /**
+   * Retrieves the latencies of every add since the last reset
+   *
+   * @return  the histogram
+   */
+  const LatencyHistogram &getAddLatency() const;
+
+  /**
+   * Retrieves the latencies of every remove since the last reset
+   *
+   * @return  the histogram
+   */
+  const LatencyHistogram &getRemoveLatency() const;
+
+  /**
+   * Forgets every latency recorded
+   */
+  void resetLatency();
+
+private:
+  /** The list answering every operation */
+  IList &target;
+  /** Latencies of contains */
+  LatencyHistogram containsLatency;
+  /** Latencies of add */
+  LatencyHistogram addLatency;
+  /** Latencies of remove */
+  LatencyHistogram removeLatency;
+}; // end TimedList.h
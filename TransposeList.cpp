@@ -0,0 +1,49 @@
+/**
+ * TransposeList.cpp
+ *
+ * Implementations for the "transpose" linked list variant, TransposeList, which
+ * is a subclass of LinkedList. TransposeList overrides the
+ * LinkedList:contains(int anEntry) method so that a Node with the sought
+ * integer value is swapped with the Node before it. Frequently sought values
+ * drift towards the front while a single search for a rare value barely
+ * disturbs the order.
+ *
+ * Joshua Scheck
+ * 2020-10-18
+ */
+
+#include "TransposeList.h"
+
+/**
+ * Overrides LinkedList::contains(int anEntry) method. Similarly determines if
+ * the specified integer value is held by a Node in this TransposeList, but then
+ * swaps the found Node with the Node before it
+ *
+ * @param   anEntry  the sought integer value held by a Node to be searched for
+ *                   in this TransposeList
+ *
+ * @post             the traversal count is incremented by 1 with each Node
+ * traversed in the search for the first occurance of the specified integer
+ * value (even if not found). If the value is found in a Node that is not the
+ * front of this TransposeList, that Node moves up by one position.
+ *
+ * @return           true if the specified integer value is contained in at
+ *                   least one Node in this TransposeList, false otherwise
+ */
+bool TransposeList::contains(int anEntry) {
+  return nodes.contains<Transpose>(anEntry);
+}
+
+/**
+ * Overrides LinkedList::containsBatch method. Since every search changes the
+ * order that the next search sees, the values are sought one at a time.
+ *
+ * @param   keys  the sought integer values, in the order they are sought
+ * @param   n     number of sought values
+ * @param   out   set so that out[i] is the result of contains(keys[i])
+ *
+ * @return  always true
+ */
+bool TransposeList::containsBatch(const int *keys, std::size_t n, bool *out) {
+  return containsEach(keys, n, out);
+} // end TransposeList.cpp
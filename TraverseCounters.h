@@ -0,0 +1,179 @@
+/**
+ * TraverseCounters.h
+ *
+ * Instrumentation recorded by the lists. A counter is told about every node
+ * visited by a search, every hit (with the position it was found at), every
+ * miss, every structural change and every miss answered by a membership
+ * filter without a search. TraverseCounter records all of it in
+ * 64-bit totals and a histogram of hit positions, while NullTraverseCounter
+ * compiles down to nothing. ListCounter is the counter used by every list; it
+ * is NullTraverseCounter when the program is built with
+ * -DNO_LIST_INSTRUMENTATION.
+ *
+ * Joshua Scheck
+ * 2020-10-18
+ */
+
+#pragma once
+
+/**
+ * Totals recorded by a list since its counts were last reset
+ */
+struct ListStatistics {
+  /** Number of buckets in hitPositions */
+  static const int HISTOGRAM_BUCKETS = 32;
+
+  /** Nodes (or values) examined by searches */
+  long long traversals = 0;
+  /** Searches that found the sought value */
+  long long hits = 0;
+  /** Searches that did not find the sought value */
+  long long misses = 0;
+  /** Hits after which the list reorganized itself */
+  long long promotions = 0;
+  /** Links rewritten to move found nodes, by promotions and batched
+   * lookups; additions and removals are not counted */
+  long long splices = 0;
+  /** hitPositions[b] counts hits at one-based positions in [2^b, 2^(b+1)) */
+  long long hitPositions[HISTOGRAM_BUCKETS] = {};
+  /** Misses answered by a membership filter without a search; also counted
+   * in misses */
+  long long filtered = 0;
+  /** Misses the membership filter let through to a full search */
+  long long filterFalsePositives = 0;
+  /** Nodes the searches answered by the membership filter would have
+   * traversed */
+  long long traversalsSaved = 0;
+
+  /**
+   * Computes the share of absent values the membership filter failed to
+   * rule out
+   *
+   * @return  the false positive rate, or 0 if no absent value was sought
+   *          through a filter
+   */
+  double filterFalsePositiveRate() const {
+    long long absent = filtered + filterFalsePositives;
+    return absent == 0 ? 0.0 : double(filterFalsePositives) / double(absent);
+  }
+
+  /**
+   * Adds the totals of another list, such as one shard of a sharded list
+   *
+   * @param   other  the statistics added
+   *
+   * @return  these statistics
+   */
+  ListStatistics &operator+=(const ListStatistics &other) {
+    traversals += other.traversals;
+    hits += other.hits;
+    misses += other.misses;
+    promotions += other.promotions;
+    splices += other.splices;
+    for (int b = 0; b < HISTOGRAM_BUCKETS; b++) {
+      hitPositions[b] += other.hitPositions[b];
+    }
+    filtered += other.filtered;
+    filterFalsePositives += other.filterFalsePositives;
+    traversalsSaved += other.traversalsSaved;
+    return *this;
+  }
+
+  /**
+   * Finds the histogram bucket of a one-based position
+   *
+   * @param   position  position of a hit, at least 1
+   *
+   * @return  the index of the bucket, floor(log2(position)), with every
+   *          position past the last bucket counted in the last bucket
+   */
+  static int bucketOf(long long position) {
+    int bucket = 63 - __builtin_clzll((unsigned long long)position);
+    return bucket < HISTOGRAM_BUCKETS ? bucket : HISTOGRAM_BUCKETS - 1;
+  }
+};
+
+/**
+ * Records every event reported by a list
+ */
+struct TraverseCounter {
+  /** Everything recorded since the last reset */
+  ListStatistics stats;
+
+  /** Records that more nodes were examined */
+  void traversed(long long nodes = 1) { stats.traversals += nodes; }
+
+  /** Records a hit at a one-based position */
+  void hit(long long position) {
+    stats.hits++;
+    stats.hitPositions[ListStatistics::bucketOf(position)]++;
+  }
+
+  /** Records a search that found nothing */
+  void miss() { stats.misses++; }
+
+  /** Records a hit that reorganized the list */
+  void promoted() { stats.promotions++; }
+
+  /** Records one link rewritten to move a found node */
+  void spliced() { stats.splices++; }
+
+  /** Records a miss answered by a membership filter, which saved a search
+   * of the given number of nodes */
+  void filtered(long long savedNodes) {
+    stats.misses++;
+    stats.filtered++;
+    stats.traversalsSaved += savedNodes;
+  }
+
+  /** Records a miss that a membership filter did not rule out */
+  void falsePositive() { stats.filterFalsePositives++; }
+
+  /** @return  the number of nodes traversed since the last reset */
+  long long get() const { return stats.traversals; }
+
+  /** @return  the number of links rewritten since the last reset */
+  long long getSplices() const { return stats.splices; }
+
+  /** @return  everything recorded since the last reset */
+  const ListStatistics &statistics() const { return stats; }
+
+  /** Sets every total back to 0 */
+  void reset() { stats = ListStatistics(); }
+};
+
+/**
+ * Ignores every event so that lists carry no instrumentation overhead
+ */
+struct NullTraverseCounter {
+  void traversed(long long = 1) {}
+  void hit(long long) {}
+  void miss() {}
+  void promoted() {}
+  void spliced() {}
+  void filtered(long long) {}
+  void falsePositive() {}
+
+  /** @return  always 0, since nothing is recorded */
+  long long get() const { return 0; }
+
+  /** @return  always 0, since nothing is recorded */
+  long long getSplices() const { return 0; }
+
+  /** @return  empty statistics, since nothing is recorded */
+  const ListStatistics &statistics() const {
+    static const ListStatistics empty;
+    return empty;
+  }
+
+  /** Does nothing */
+  void reset() {}
+};
+
+#ifdef NO_LIST_INSTRUMENTATION
+/** Counter used by every list; instrumentation is compiled out */
+typedef NullTraverseCounter ListCounter;
+#else
+/** Counter used by every list */
+typedef TraverseCounter ListCounter;
+#endif
@@ -0,0 +1,368 @@
+/**
+ * UnrolledList.cpp
+ *
+ * Implementations for the UnrolledList class, an unrolled (block) singly
+ * linked list where every Block holds a cache line of integer values instead
+ * of the single value held by a Node. Searching compares a whole Block at once
+ * with vector instructions, so the number of pointers followed during contains
+ * method calls shrinks by the number of values per Block. The move-to-front
+ * variant, UnrolledMTFList, is a subclass of UnrolledList.
+ *
+ * Joshua Scheck
+ * 2020-10-18
+ */
+
+#include "UnrolledList.h"
+#include "SimdSearch.h"
+#include <cstring>
+#include <new>
+
+/**
+ * Constructor for this UnrolledList class. Initializes an empty UnrolledList.
+ */
+UnrolledList::UnrolledList() {
+  currentSize = 0;
+  blockTraverseCount = 0;
+  head = nullptr;
+}
+
+/**
+ * Destructor for this UnrolledList class that destroys this UnrolledList and
+ * frees memory allocated by the object.
+ *
+ * Calls UnrolledList::clear() method.
+ *
+ * @post    this UnrolledList is empty with all prior Blocks being deallocated
+ *          from memory
+ */
+UnrolledList::~UnrolledList() { clear(); }
+
+/**
+ * Retrieves the current number of values in this UnrolledList
+ *
+ * @post    state of this UnrolledList does not change
+ *
+ * @return  the number of values in this UnrolledList
+ */
+int UnrolledList::getCurrentSize() const { return currentSize; }
+
+/**
+ * Determines if the number of values in this UnrolledList is zero
+ *
+ * @post    state of this UnrolledList does not change
+ *
+ * @return  true if this UnrolledList holds no values, false otherwise
+ */
+bool UnrolledList::isEmpty() const { return head == nullptr; }
+
+/**
+ * Adds the specified value to the beginning of this UnrolledList. Duplicate
+ * integer values are allowed. A new Block is allocated only when the first
+ * Block is full.
+ *
+ * @param   newEntry integer value to be added to the beginning of this
+ *                   UnrolledList
+ *
+ * @post             if successful, the size of this UnrolledList increases by
+ * 1 and newEntry is the first value. No change in class state if unsuccessful.
+ *
+ * @return           true if the value is successfully added, false if a Block
+ *                   could not be allocated
+ */
+bool UnrolledList::add(int newEntry) {
+  if (head == nullptr || head->count == Block::CAPACITY) {
+    try {
+      Block *newBlock = new Block;
+      newBlock->count = 0;
+      newBlock->next = head;
+      head = newBlock;
+    }
+    // inability to allocate memory will throw a std::bad_alloc error
+    // which will be caught and signals a lack of success
+    catch (std::bad_alloc &exc) {
+      return false;
+    }
+  }
+
+  // the first Block is guaranteed to have room at this point
+  shiftInAtFront(newEntry);
+  currentSize++;
+  return true;
+}
+
+/**
+ * Removes the first occurrence of the specified integer from this
+ * UnrolledList. A Block left empty is deallocated, and a Block that can be
+ * merged with the Block after it is.
+ *
+ * @param   anEntry  the sought integer value to be removed
+ *
+ * @post             if successful, the size of this UnrolledList decreases by
+ * 1 and the values after the removed one keep their order. No change in class
+ * state if unsuccessful.
+ *
+ * @return           true if the value is found and removed, false otherwise
+ */
+bool UnrolledList::remove(int anEntry) {
+  Block *currBlock = head;
+  Block *prevBlock = nullptr;
+
+  while (currBlock != nullptr) {
+    int index = findFirstInt(currBlock->items, currBlock->count, anEntry);
+    if (index >= 0) {
+      eraseAt(currBlock, prevBlock, index);
+      currentSize--;
+      return true;
+    }
+
+    prevBlock = currBlock;
+    currBlock = currBlock->next;
+  }
+
+  return false;
+}
+
+/**
+ * Removes all entries from this UnrolledList by sequentially deallocating
+ * memory from each Block
+ *
+ * @post    this UnrolledList will have no Blocks (is empty) and class member
+ *          currentSize will be set to 0
+ */
+void UnrolledList::clear() {
+  Block *currBlock = head;
+
+  while (currBlock != nullptr) {
+    // obtains the reference for the next Block to avoid dangling pointers
+    Block *nextBlock = currBlock->next;
+    delete currBlock;
+    currBlock = nextBlock;
+  }
+
+  head = nullptr;
+  currentSize = 0;
+}
+
+/**
+ * Determines if the specified integer value is held in this UnrolledList
+ *
+ * @param   anEntry  the sought integer value
+ *
+ * @post             the traversal count is incremented by the position
+ * of the first occurrence of the value (the number of values a LinkedList would
+ * have traversed, or every value if not found) and class member
+ * blockTraverseCount by the number of Blocks visited.
+ *
+ * @return           true if the specified integer value is contained in this
+ *                   UnrolledList, false otherwise
+ */
+bool UnrolledList::contains(int anEntry) {
+  Block *found = nullptr;
+  Block *prevBlock = nullptr;
+  int index = 0;
+
+  return locate(anEntry, found, prevBlock, index);
+}
+
+/**
+ * Retrieves the number of nodes traversed since the last time the count was
+ * reset in this UnrolledList.
+ *
+ * @post    state of this UnrolledList does not change
+ *
+ * @return  the number of values traversed
+ */
+long long UnrolledList::getTraverseCount() const { return counter.get(); }
+
+/**
+ * Retrieves everything recorded about this UnrolledList since the last reset
+ *
+ * @post    state of this UnrolledList does not change
+ *
+ * @return  traversals, hits, misses, the histogram of hit positions,
+ *          promotions and splices, all 0 if instrumentation is compiled out
+ */
+ListStatistics UnrolledList::getStatistics() const {
+  return counter.statistics();
+}
+
+/**
+ * Retrieves the number of Blocks visited since the last time the count was
+ * reset in this UnrolledList.
+ *
+ * @post    state of this UnrolledList does not change
+ *
+ * @return  the number of Blocks traversed, 0 if instrumentation is compiled
+ *          out
+ */
+long long UnrolledList::getBlockTraverseCount() const {
+  return blockTraverseCount;
+}
+
+/**
+ * Resets the counts of values and Blocks traversed in this UnrolledList
+ *
+ * @post sets the traversal count, all other statistics and class member
+ *       blockTraverseCount to 0
+ */
+void UnrolledList::resetTraverseCount() {
+  counter.reset();
+  blockTraverseCount = 0;
+}
+
+/**
+ * Searches the Blocks of this UnrolledList for the first occurrence of the
+ * specified value, recording the values and Blocks traversed and the hit
+ * or miss
+ *
+ * @param   anEntry    the sought integer value
+ * @param   found      set to the Block holding the value, otherwise nullptr
+ * @param   prevBlock  set to the Block before found, or nullptr if found is the
+ *                     first Block
+ * @param   index      set to the position of the value within found
+ *
+ * @return  true if the value is found, false otherwise
+ */
+bool UnrolledList::locate(int anEntry, Block *&found, Block *&prevBlock,
+                          int &index) {
+  Block *currBlock = head;
+  prevBlock = nullptr;
+  long long position = 0;
+
+  while (currBlock != nullptr) {
+#ifndef NO_LIST_INSTRUMENTATION
+    blockTraverseCount++;
+#endif
+
+    // every value of the Block is compared at once
+    index = findFirstInt(currBlock->items, currBlock->count, anEntry);
+    if (index >= 0) {
+      counter.traversed(index + 1);
+      counter.hit(position + index + 1);
+      found = currBlock;
+      return true;
+    }
+
+    counter.traversed(currBlock->count);
+    position += currBlock->count;
+    prevBlock = currBlock;
+    currBlock = currBlock->next;
+  }
+
+  counter.miss();
+  found = nullptr;
+  return false;
+}
+
+/**
+ * Inserts a value at the beginning of this UnrolledList without allocating,
+ * shifting the last value of every full Block into the front of the Block
+ * after it
+ *
+ * @param   value  the integer value to become the first value
+ *
+ * @pre     some Block of this UnrolledList must have room for one more value
+ */
+void UnrolledList::shiftInAtFront(int value) {
+  int carry = value;
+
+  for (Block *currBlock = head; currBlock != nullptr;
+       currBlock = currBlock->next) {
+    if (currBlock->count < Block::CAPACITY) {
+      std::memmove(currBlock->items + 1, currBlock->items,
+                   currBlock->count * sizeof(int));
+      currBlock->items[0] = carry;
+      currBlock->count++;
+      return;
+    }
+
+    // the last value of a full Block overflows into the next Block
+    int overflow = currBlock->items[Block::CAPACITY - 1];
+    std::memmove(currBlock->items + 1, currBlock->items,
+                 (Block::CAPACITY - 1) * sizeof(int));
+    currBlock->items[0] = carry;
+    carry = overflow;
+  }
+}
+
+/**
+ * Removes the value at a position of a Block, deallocating the Block if it
+ * becomes empty and merging it with the next Block if both fit in one
+ *
+ * @param   block      the Block holding the value
+ * @param   prevBlock  the Block before block, or nullptr if block is first
+ * @param   index      position of the value within block
+ */
+void UnrolledList::eraseAt(Block *block, Block *prevBlock, int index) {
+  std::memmove(block->items + index, block->items + index + 1,
+               (block->count - index - 1) * sizeof(int));
+  block->count--;
+
+  if (block->count == 0) {
+    if (prevBlock == nullptr) {
+      head = block->next;
+    } else {
+      prevBlock->next = block->next;
+    }
+    delete block;
+    return;
+  }
+
+  // keep Blocks dense so that searches stay close to one Block per cache line
+  Block *nextBlock = block->next;
+  if (nextBlock != nullptr &&
+      block->count + nextBlock->count <= Block::CAPACITY) {
+    std::memcpy(block->items + block->count, nextBlock->items,
+                nextBlock->count * sizeof(int));
+    block->count += nextBlock->count;
+    block->next = nextBlock->next;
+    delete nextBlock;
+  }
+}
+
+/**
+ * Overrides UnrolledList::contains(int anEntry) method. Similarly determines if
+ * the specified integer value is held in this UnrolledMTFList, but then moves
+ * the value to the front of the first Block, shifting the values that overflow
+ * each full Block into the next one.
+ *
+ * @param   anEntry  the sought integer value
+ *
+ * @post             traversal counts are updated as for
+ * UnrolledList::contains(int anEntry). If found, the value is the first value
+ * of this UnrolledMTFList and the values that preceded it moved back by one
+ * position.
+ *
+ * @return           true if the specified integer value is contained in this
+ *                   UnrolledMTFList, false otherwise
+ */
+bool UnrolledMTFList::contains(int anEntry) {
+  Block *found = nullptr;
+  Block *prevBlock = nullptr;
+  int index = 0;
+
+  if (!locate(anEntry, found, prevBlock, index)) {
+    return false;
+  }
+
+  // only make structural modifications if the value is not already first
+  if (found == head && index == 0) {
+    return true;
+  }
+
+  // open a slot in the Block holding the value, so the overflow shifted in
+  // from the front stops at this Block at the latest
+  std::memmove(found->items + index, found->items + index + 1,
+               (found->count - index - 1) * sizeof(int));
+  found->count--;
+  shiftInAtFront(anEntry);
+  counter.promoted();
+
+  // a Block that held only the found value may not have been refilled
+  if (found->count == 0) {
+    prevBlock->next = found->next;
+    delete found;
+  }
+
+  return true;
+} // end UnrolledList.cpp
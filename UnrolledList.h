@@ -0,0 +1,247 @@
+/**
+ * UnrolledList.h
+ *
+ * Declarations for the UnrolledList class, an unrolled (block) singly linked
+ * list where every Block holds a cache line of integer values instead of the
+ * single value held by a Node. Searching compares a whole Block at once with
+ * vector instructions, so the number of pointers followed during contains
+ * method calls shrinks by the number of values per Block. The move-to-front
+ * variant, UnrolledMTFList, is a subclass of UnrolledList.
+ *
+ * Joshua Scheck
+ * 2020-10-18
+ */
+
+#pragma once
+#include "IList.h"
+
+/**
+ * This struct represents a single block of values that composes an unrolled
+ * list ADT
+ */
+struct Block {
+  /** Number of integer values that fit in a Block */
+  static const int CAPACITY = 16;
+  /** Integer values held by this Block, front of the list first. Aligned so
+   * that the values occupy exactly one cache line. */
+  alignas(64) int items[CAPACITY];
+  /** Number of values currently held in items */
+  int count;
+  /** Reference to the address of the next Block in this UnrolledList,
+   * otherwise nullptr */
+  Block *next;
+};
+
+/**
+ * Represents an unrolled singly Linked List that stores integer values in
+ * Blocks and is the subclass of IList
+ */
+class UnrolledList : public IList {
+public:
+  /**
+   * Constructor for this UnrolledList class. Initializes an empty
+   * UnrolledList.
+   */
+  UnrolledList();
+
+  /**
+   * Destructor for this UnrolledList class that destroys this UnrolledList
+   * and frees memory allocated by the object.
+   *
+   * Calls UnrolledList::clear() method.
+   *
+   * @post    this UnrolledList is empty with all prior Blocks being
+   *          deallocated from memory
+   */
+  ~UnrolledList() override;
+
+  UnrolledList(const UnrolledList &) = delete;
+  UnrolledList &operator=(const UnrolledList &) = delete;
+
+  /**
+   * Retrieves the current number of values in this UnrolledList
+   *
+   * @post    state of this UnrolledList does not change
+   *
+   * @return  the number of values in this UnrolledList
+   */
+  int getCurrentSize() const override;
+
+  /**
+   * Determines if the number of values in this UnrolledList is zero
+   *
+   * @post    state of this UnrolledList does not change
+   *
+   * @return  true if this UnrolledList holds no values, false otherwise
+   */
+  bool isEmpty() const override;
+
+  /**
+   * Adds the specified value to the beginning of this UnrolledList. Duplicate
+   * integer values are allowed. A new Block is allocated only when the first
+   * Block is full.
+   *
+   * @param   newEntry integer value to be added to the beginning of this
+   *                   UnrolledList
+   *
+   * @post             if successful, the size of this UnrolledList increases
+   * by 1 and newEntry is the first value. No change in class state if
+   * unsuccessful.
+   *
+   * @return           true if the value is successfully added, false if a
+   *                   Block could not be allocated
+   */
+  bool add(int newEntry) override;
+
+  /**
+   * Removes the first occurrence of the specified integer from this
+   * UnrolledList. A Block left empty is deallocated, and a Block that can be
+   * merged with the Block after it is.
+   *
+   * @param   anEntry  the sought integer value to be removed
+   *
+   * @post             if successful, the size of this UnrolledList decreases
+   * by 1 and the values after the removed one keep their order. No change in
+   * class state if unsuccessful.
+   *
+   * @return           true if the value is found and removed, false otherwise
+   */
+  bool remove(int anEntry) override;
+
+  /**
+   * Removes all entries from this UnrolledList by sequentially deallocating
+   * memory from each Block
+   *
+   * @post    this UnrolledList will have no Blocks (is empty) and class member
+   *          currentSize will be set to 0
+   */
+  void clear() override;
+
+  /**
+   * Determines if the specified integer value is held in this UnrolledList
+   *
+   * @param   anEntry  the sought integer value
+   *
+   * @post             the traversal count is incremented by the
+   * position of the first occurrence of the value (the number of values a
+   * LinkedList would have traversed, or every value if not found) and class
+   * member blockTraverseCount by the number of Blocks visited.
+   *
+   * @return           true if the specified integer value is contained in
+   *                   this UnrolledList, false otherwise
+   */
+  bool contains(int anEntry) override;
+
+  /**
+   * Retrieves the number of nodes traversed since the last time the count was
+   * reset in this UnrolledList.
+   *
+   * @post    state of this UnrolledList does not change
+   *
+   * @return  the number of values traversed
+   */
+  long long getTraverseCount() const override;
+
+  /**
+   * Retrieves everything recorded about this UnrolledList since the last reset
+   *
+   * @post    state of this UnrolledList does not change
+   *
+   * @return  traversals, hits, misses, the histogram of hit positions,
+   *          promotions and splices, all 0 if instrumentation is compiled out
+   */
+  ListStatistics getStatistics() const override;
+
+  /**
+   * Retrieves the number of Blocks visited since the last time the count was
+   * reset in this UnrolledList.
+   *
+   * @post    state of this UnrolledList does not change
+   *
+   * @return  the number of Blocks traversed, 0 if instrumentation is
+   *          compiled out
+   */
+  long long getBlockTraverseCount() const;
+
+  /**
+   * Resets the counts of values and Blocks traversed in this UnrolledList
+   *
+   * @post sets the traversal count, all other statistics and class member
+   *       blockTraverseCount to 0
+   */
+  void resetTraverseCount() override;
+
+protected:
+  /**
+   * Searches the Blocks of this UnrolledList for the first occurrence of the
+   * specified value, recording the values and Blocks traversed and the hit
+   * or miss
+   *
+   * @param   anEntry    the sought integer value
+   * @param   found      set to the Block holding the value, otherwise nullptr
+   * @param   prevBlock  set to the Block before found, or nullptr if found is
+   *                     the first Block
+   * @param   index      set to the position of the value within found
+   *
+   * @return  true if the value is found, false otherwise
+   */
+  bool locate(int anEntry, Block *&found, Block *&prevBlock, int &index);
+
+  /**
+   * Inserts a value at the beginning of this UnrolledList without allocating,
+   * shifting the last value of every full Block into the front of the Block
+   * after it
+   *
+   * @param   value  the integer value to become the first value
+   *
+   * @pre     some Block of this UnrolledList must have room for one more value
+   */
+  void shiftInAtFront(int value);
+
+  /**
+   * Removes the value at a position of a Block, deallocating the Block if it
+   * becomes empty and merging it with the next Block if both fit in one
+   *
+   * @param   block      the Block holding the value
+   * @param   prevBlock  the Block before block, or nullptr if block is first
+   * @param   index      position of the value within block
+   */
+  void eraseAt(Block *block, Block *prevBlock, int index);
+
+  /** Instrumentation of this UnrolledList; a no-op when built with
+   * NO_LIST_INSTRUMENTATION. */
+  ListCounter counter;
+  /** The current number of values in this UnrolledList. */
+  int currentSize;
+  /** The number of Blocks visited since the counts were last reset; stays 0
+   * when built with NO_LIST_INSTRUMENTATION. */
+  long long blockTraverseCount;
+  /** Reference to the address of the first Block in this UnrolledList,
+   * otherwise nullptr. */
+  Block *head;
+}; // end UnrolledList
+
+/**
+ * Represents a move-to-front unrolled singly Linked List that is the subclass
+ * of UnrolledList
+ */
+class UnrolledMTFList : public UnrolledList {
+public:
+  /**
+   * Overrides UnrolledList::contains(int anEntry) method. Similarly determines
+   * if the specified integer value is held in this UnrolledMTFList, but then
+   * moves the value to the front of the first Block, shifting the values that
+   * overflow each full Block into the next one.
+   *
+   * @param   anEntry  the sought integer value
+   *
+   * @post             traversal counts are updated as for
+   * UnrolledList::contains(int anEntry). If found, the value is the first
+   * value of this UnrolledMTFList and the values that preceded it moved back
+   * by one position.
+   *
+   * @return           true if the specified integer value is contained in
+   *                   this UnrolledMTFList, false otherwise
+   */
+  bool contains(int anEntry) override;
+}; // end UnrolledList.h
@@ -0,0 +1,287 @@
+/**
+ * Workloads.cpp
+ *
+ * Implementations of the access distributions used to benchmark lists. Every
+ * distribution generates a sequence of values in 0..numValues-1 to be sought,
+ * and is selected by a short textual specification such as "uniform",
+ * "zipf:1.2" or "hotset:0.1:0.9".
+ *
+ * Joshua Scheck
+ * 2020-10-18
+ */
+
+#include "Workloads.h"
+#include <algorithm>
+#include <cmath>
+#include <cstdlib>
+#include <numeric>
+
+namespace {
+
+/**
+ * Every value equally likely
+ */
+class UniformDistribution : public AccessDistribution {
+public:
+  std::string getName() const override { return "uniform"; }
+
+  std::vector<int> generate(int numValues, int numAccesses,
+                            std::mt19937_64 &generator) const override {
+    std::uniform_int_distribution<int> uniform(0, numValues - 1);
+    std::vector<int> accesses(numAccesses);
+    for (int &access : accesses) {
+      access = uniform(generator);
+    }
+    return accesses;
+  }
+};
+
+/**
+ * Normal around the middle value; values outside the legal range are drawn
+ * again since a normal distribution goes to +/- infinity
+ */
+class NormalDistribution : public AccessDistribution {
+public:
+  NormalDistribution(const std::string &name, double sdFraction)
+      : name(name), sdFraction(sdFraction) {}
+
+  std::string getName() const override { return name; }
+
+  std::vector<int> generate(int numValues, int numAccesses,
+                            std::mt19937_64 &generator) const override {
+    std::normal_distribution<double> normal(numValues / 2.0,
+                                            numValues * sdFraction);
+    std::vector<int> accesses(numAccesses);
+    for (int &access : accesses) {
+      double drawn = 0.0;
+      do {
+        drawn = normal(generator);
+      } while (drawn < 0.0 || drawn >= numValues);
+      access = int(drawn);
+    }
+    return accesses;
+  }
+
+private:
+  std::string name;
+  double sdFraction;
+};
+
+/**
+ * Zipf over randomly ranked values
+ */
+class ZipfDistribution : public AccessDistribution {
+public:
+  ZipfDistribution(const std::string &name, double skew)
+      : name(name), skew(skew) {}
+
+  std::string getName() const override { return name; }
+
+  std::vector<int> generate(int numValues, int numAccesses,
+                            std::mt19937_64 &generator) const override {
+    // the cumulative weight of every rank, searched by binary search
+    std::vector<double> cumulative(numValues);
+    double total = 0.0;
+    for (int rank = 0; rank < numValues; rank++) {
+      total += 1.0 / std::pow(rank + 1.0, skew);
+      cumulative[rank] = total;
+    }
+
+    // which value holds which rank is random, so that popularity is not
+    // correlated with the initial position in the list
+    std::vector<int> valueOfRank(numValues);
+    std::iota(valueOfRank.begin(), valueOfRank.end(), 0);
+    std::shuffle(valueOfRank.begin(), valueOfRank.end(), generator);
+
+    std::uniform_real_distribution<double> unit(0.0, total);
+    std::vector<int> accesses(numAccesses);
+    for (int &access : accesses) {
+      auto rank = std::upper_bound(cumulative.begin(), cumulative.end(),
+                                   unit(generator)) -
+                  cumulative.begin();
+      if (rank == numValues) {
+        rank = numValues - 1;
+      }
+      access = valueOfRank[rank];
+    }
+    return accesses;
+  }
+
+private:
+  std::string name;
+  double skew;
+};
+
+/**
+ * A random hot set receiving most of the accesses, optionally replaced by a
+ * new random hot set at regular intervals
+ */
+class HotSetDistribution : public AccessDistribution {
+public:
+  HotSetDistribution(const std::string &name, double fraction, double share,
+                     int phaseLength)
+      : name(name), fraction(fraction), share(share),
+        phaseLength(phaseLength) {}
+
+  std::string getName() const override { return name; }
+
+  std::vector<int> generate(int numValues, int numAccesses,
+                            std::mt19937_64 &generator) const override {
+    int hotCount = std::max(1, int(numValues * fraction));
+    if (hotCount > numValues) {
+      hotCount = numValues;
+    }
+
+    std::vector<int> values(numValues);
+    std::iota(values.begin(), values.end(), 0);
+    std::bernoulli_distribution isHot(share);
+    std::uniform_int_distribution<int> hotPick(0, hotCount - 1);
+    std::uniform_int_distribution<int> coldPick(
+        std::min(hotCount, numValues - 1), numValues - 1);
+
+    std::vector<int> accesses(numAccesses);
+    for (int i = 0; i < numAccesses; i++) {
+      // the first hotCount entries of values are the current hot set
+      if (i % phaseLength == 0) {
+        std::shuffle(values.begin(), values.end(), generator);
+      }
+      if (hotCount == numValues || isHot(generator)) {
+        accesses[i] = values[hotPick(generator)];
+      } else {
+        accesses[i] = values[coldPick(generator)];
+      }
+    }
+    return accesses;
+  }
+
+private:
+  std::string name;
+  double fraction;
+  double share;
+  int phaseLength;
+};
+
+/**
+ * Mostly values that are not held, so that searches run to the end of the
+ * list, mixed with uniform accesses to the values held
+ */
+class MissDistribution : public AccessDistribution {
+public:
+  MissDistribution(const std::string &name, double share)
+      : name(name), share(share) {}
+
+  std::string getName() const override { return name; }
+
+  std::vector<int> generate(int numValues, int numAccesses,
+                            std::mt19937_64 &generator) const override {
+    std::bernoulli_distribution isMiss(share);
+    std::uniform_int_distribution<int> uniform(0, numValues - 1);
+    std::vector<int> accesses(numAccesses);
+    for (int &access : accesses) {
+      // values past numValues - 1 are never added to a list
+      access = isMiss(generator) ? numValues + uniform(generator)
+                                 : uniform(generator);
+    }
+    return accesses;
+  }
+
+private:
+  std::string name;
+  double share;
+};
+
+/**
+ * Splits a specification at its colons
+ */
+std::vector<std::string> splitSpec(const std::string &spec) {
+  std::vector<std::string> parts;
+  std::string::size_type start = 0;
+  while (true) {
+    std::string::size_type colon = spec.find(':', start);
+    parts.push_back(spec.substr(start, colon - start));
+    if (colon == std::string::npos) {
+      return parts;
+    }
+    start = colon + 1;
+  }
+}
+
+/**
+ * Parses an optional numeric parameter of a specification
+ *
+ * @return  false if the parameter is present but not a positive number
+ */
+bool parameter(const std::vector<std::string> &parts, std::size_t index,
+               double &value) {
+  if (index >= parts.size()) {
+    return true;
+  }
+  char *end = nullptr;
+  value = std::strtod(parts[index].c_str(), &end);
+  return end != parts[index].c_str() && *end == '\0' && value > 0.0;
+}
+
+} // namespace
+
+/**
+ * Creates a distribution from its specification
+ *
+ * @param   spec  the specification
+ *
+ * @return  the distribution, or nullptr if spec is not recognized
+ */
+std::unique_ptr<AccessDistribution>
+makeAccessDistribution(const std::string &spec) {
+  std::vector<std::string> parts = splitSpec(spec);
+  const std::string &kind = parts[0];
+  double first = 0.0;
+  double second = 0.0;
+  double third = 0.0;
+
+  if (kind == "uniform" && parts.size() == 1) {
+    return std::unique_ptr<AccessDistribution>(new UniformDistribution());
+  }
+  if (kind == "normal" && parts.size() <= 2) {
+    first = 0.2;
+    if (parameter(parts, 1, first)) {
+      return std::unique_ptr<AccessDistribution>(
+          new NormalDistribution(spec, first));
+    }
+  }
+  if (kind == "zipf" && parts.size() <= 2) {
+    first = 1.0;
+    if (parameter(parts, 1, first)) {
+      return std::unique_ptr<AccessDistribution>(
+          new ZipfDistribution(spec, first));
+    }
+  }
+  if (kind == "hotset" && parts.size() <= 3) {
+    first = 0.1;
+    second = 0.9;
+    if (parameter(parts, 1, first) && parameter(parts, 2, second) &&
+        first <= 1.0 && second <= 1.0) {
+      return std::unique_ptr<AccessDistribution>(
+          new HotSetDistribution(spec, first, second, 0x7fffffff));
+    }
+  }
+  if (kind == "phase" && parts.size() <= 4) {
+    first = 10000;
+    second = 0.1;
+    third = 0.9;
+    if (parameter(parts, 1, first) && parameter(parts, 2, second) &&
+        parameter(parts, 3, third) && second <= 1.0 && third <= 1.0) {
+      return std::unique_ptr<AccessDistribution>(
+          new HotSetDistribution(spec, second, third,
+                                 std::max(1, int(first))));
+    }
+  }
+  if (kind == "misses" && parts.size() <= 2) {
+    first = 0.9;
+    if (parameter(parts, 1, first) && first <= 1.0) {
+      return std::unique_ptr<AccessDistribution>(
+          new MissDistribution(spec, first));
+    }
+  }
+
+  return nullptr;
+} // end Workloads.cpp
@@ -0,0 +1,74 @@
+/**
+ * Workloads.h
+ *
+ * Declarations for the access distributions used to benchmark lists. Every
+ * distribution generates a sequence of values in 0..numValues-1 to be sought,
+ * and is selected by a short textual specification such as "uniform",
+ * "zipf:1.2" or "hotset:0.1:0.9".
+ *
+ * Joshua Scheck
+ * 2020-10-18
+ */
+
+#pragma once
+#include <cstdint>
+#include <memory>
+#include <random>
+#include <string>
+#include <vector>
+
+/**
+ * Represents a distribution of accesses over the values held by a list
+ */
+class AccessDistribution {
+public:
+  /** Destroys the distribution */
+  virtual ~AccessDistribution() {}
+
+  /**
+   * Retrieves the specification this distribution was created from
+   *
+   * @return  the specification, such as "zipf:1.2"
+   */
+  virtual std::string getName() const = 0;
+
+  /**
+   * Generates the values to be sought by one benchmark run
+   *
+   * @param   numValues    number of values held by the list, 0..numValues-1
+   * @param   numAccesses  number of values to generate
+   * @param   generator    source of randomness, seeded by the caller
+   *
+   * @pre     numValues must be greater than 0
+   *
+   * @return  numAccesses values in 0..numValues-1, or for the misses
+   *          distribution in 0..2*numValues-1
+   */
+  virtual std::vector<int> generate(int numValues, int numAccesses,
+                                    std::mt19937_64 &generator) const = 0;
+};
+
+/**
+ * Creates a distribution from its specification. The recognized
+ * specifications are:
+ *   uniform                      every value equally likely
+ *   normal[:sdFraction]          normal around numValues / 2 with standard
+ *                                deviation numValues * sdFraction (0.2)
+ *   zipf[:skew]                  the value of rank r is sought with
+ *                                probability proportional to 1 / r^skew (1.0);
+ *                                ranks are assigned to values at random
+ *   hotset[:fraction[:share]]    a random fraction (0.1) of the values
+ *                                receives share (0.9) of the accesses
+ *   phase[:length[:fraction[:share]]]
+ *                                like hotset, but a new hot set is drawn every
+ *                                length (10000) accesses
+ *   misses[:share]               share (0.9) of the accesses seek values in
+ *                                numValues..2*numValues-1, which no list
+ *                                holds; the others are uniform
+ *
+ * @param   spec  the specification
+ *
+ * @return  the distribution, or nullptr if spec is not recognized
+ */
+std::unique_ptr<AccessDistribution>
+makeAccessDistribution(const std::string &spec);